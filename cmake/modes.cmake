@@ -1,5 +1,14 @@
 add_compile_definitions(PPC_PATH_TO_PROJECT="${CMAKE_CURRENT_SOURCE_DIR}")
 
+find_package(Git QUIET)
+if(GIT_FOUND)
+  execute_process(
+    COMMAND ${GIT_EXECUTABLE} rev-parse --short HEAD
+    WORKING_DIRECTORY ${CMAKE_CURRENT_SOURCE_DIR}
+    OUTPUT_VARIABLE PPC_GIT_REVISION
+    OUTPUT_STRIP_TRAILING_WHITESPACE ERROR_QUIET)
+endif()
+
 macro(SUBDIRLIST result curdir)
   file(
     GLOB children
@@ -25,3 +34,15 @@ if(USE_PERF_TESTS)
   message(STATUS "Enable performance tests")
   add_compile_definitions(USE_PERF_TESTS)
 endif(USE_PERF_TESTS)
+
+option(USE_MPI_PROFILER "Enable PMPI communication profiler in test runners" OFF)
+if(USE_MPI_PROFILER)
+  message(STATUS "Enable MPI profiler")
+  add_compile_definitions(USE_MPI_PROFILER)
+endif(USE_MPI_PROFILER)
+
+option(USE_ALLOC_TRACKER "Enable heap allocation tracking per task stage in performance tests" OFF)
+if(USE_ALLOC_TRACKER)
+  message(STATUS "Enable allocation tracker")
+  add_compile_definitions(USE_ALLOC_TRACKER)
+endif(USE_ALLOC_TRACKER)
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstddef>
+
+namespace ppc::performance {
+
+/// @brief Returns the size of the last level cache in bytes (32 MiB if it cannot be determined).
+std::size_t GetLastLevelCacheSize();
+
+/// @brief Evicts the task's data from the cache hierarchy of the calling core.
+/// @details Streams through a private buffer twice the size of the last level cache, so the next
+///          access to task data misses in every level. The buffer is allocated on the first call.
+void FlushCaches();
+
+}  // namespace ppc::performance
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ppc::performance {
+
+/// @brief Hardware events sampled around timed perf iterations.
+enum class HwCounterType : uint8_t {
+  /// CPU cycles
+  kCycles,
+  /// Retired instructions
+  kInstructions,
+  /// Last level cache misses
+  kLLCMisses,
+  /// Mispredicted branches
+  kBranchMisses,
+  /// Data TLB read misses
+  kDTLBMisses,
+  /// Number of counter types
+  kCount
+};
+
+inline constexpr std::size_t kNumHwCounters = static_cast<std::size_t>(HwCounterType::kCount);
+
+/// @brief Returns a short string name of the hardware counter (e.g., "llc_misses").
+std::string GetHwCounterName(HwCounterType type);
+
+/// @brief Hardware counter values averaged per timed iteration on the calling rank.
+/// @details A negative value means the counter could not be opened on this machine
+///          (unsupported PMU, virtualization or a restrictive perf_event_paranoid setting).
+struct HwCounters {
+  std::array<double, kNumHwCounters> values = {-1.0, -1.0, -1.0, -1.0, -1.0};
+
+  /// @brief Returns the value of the given counter.
+  [[nodiscard]] double Get(HwCounterType type) const {
+    return values[static_cast<std::size_t>(type)];
+  }
+
+  /// @brief Checks whether at least one counter was measured.
+  [[nodiscard]] bool IsAvailable() const {
+    for (double value : values) {
+      if (value >= 0.0) {
+        return true;
+      }
+    }
+    return false;
+  }
+};
+
+/// @brief RAII set of per-process hardware counters based on Linux perf_event_open.
+/// @details One counter per hardware event is opened for every thread alive at construction, and each follows
+///          the threads its thread spawns later. Pool workers started before the measurement and OpenMP/STL
+///          workers created inside it are therefore both included; the values are summed over the threads.
+///          Counting is user-space only. On non-Linux platforms
+///          or when the kernel denies access every counter is reported as unavailable.
+class HwCounterSet {
+ public:
+  HwCounterSet();
+  ~HwCounterSet();
+
+  HwCounterSet(const HwCounterSet &) = delete;
+  HwCounterSet &operator=(const HwCounterSet &) = delete;
+  HwCounterSet(HwCounterSet &&) = delete;
+  HwCounterSet &operator=(HwCounterSet &&) = delete;
+
+  /// @brief Resets all counters to zero.
+  void Reset();
+  /// @brief Starts (or resumes) counting.
+  void Start();
+  /// @brief Pauses counting; values accumulate across Start/Stop pairs.
+  void Stop();
+  /// @brief Reads accumulated values divided by the given number of iterations.
+  /// @param iterations Number of measured iterations (values are not divided when zero).
+  [[nodiscard]] HwCounters Read(uint64_t iterations) const;
+
+ private:
+  /// @brief Open perf_event descriptors of every counter, one per thread alive at construction.
+  std::array<std::vector<int>, kNumHwCounters> fds_;
+};
+
+}  // namespace ppc::performance
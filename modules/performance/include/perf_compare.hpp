@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ppc::performance {
+
+/// @brief Outcome of comparing a measurement with its baseline.
+enum class PerfVerdict : uint8_t {
+  /// No significant change beyond the threshold
+  kUnchanged,
+  /// Significantly slower than the baseline
+  kRegression,
+  /// Significantly faster than the baseline
+  kImprovement
+};
+
+/// @brief Returns a short string name of the verdict (e.g., "regression").
+std::string GetPerfVerdictName(PerfVerdict verdict);
+
+/// @brief Result of a sample-based comparison with a baseline measurement.
+struct PerfComparison {
+  double baseline_median = 0.0;
+  double current_median = 0.0;
+  /// @brief Relative change of the median time: current / baseline - 1 (positive means slower).
+  double change = 0.0;
+  /// @brief Two-sided p-value of the Mann-Whitney U test (1.0 if there are too few samples).
+  double p_value = 1.0;
+  PerfVerdict verdict = PerfVerdict::kUnchanged;
+};
+
+/// @brief Two-sided p-value of the Mann-Whitney U test using the normal approximation with tie correction.
+/// @return 1.0 if either side has fewer than two samples.
+double GetMannWhitneyPValue(const std::vector<double> &lhs, const std::vector<double> &rhs);
+
+/// @brief Compares per-iteration samples with baseline samples.
+/// @details A change is reported only when the median moves by more than @p threshold (relative) and the
+///          sample distributions differ with significance @p alpha, so run-to-run noise is not flagged.
+PerfComparison ComparePerfSamples(const std::vector<double> &baseline, const std::vector<double> &current,
+                                  double threshold, double alpha = 0.05);
+
+}  // namespace ppc::performance
@@ -1,40 +1,171 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <iomanip>
 #include <iostream>
 #include <memory>
+#include <numeric>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
+#include "performance/include/cache_flush.hpp"
+#include "performance/include/hw_counters.hpp"
 #include "task/include/task.hpp"
+#include "util/include/alloc_tracker.hpp"
 #include "util/include/util.hpp"
 
 namespace ppc::performance {
 
+struct PerfResults;
+
 inline double DefaultTimer() {
   return -1.0;
 }
 
+inline void DefaultRankSync() {}
+
+inline void DefaultRankReduce(PerfResults & /*perf_results*/) {}
+
 struct PerfAttr {
   /// @brief Number of times the task is run for performance evaluation.
   uint64_t num_running = 5;
+  /// @brief Number of untimed runs executed before measurement (page faults, lazy init, cold caches).
+  uint64_t num_warmup = 0;
+  /// @brief Capture hardware counters (cycles, instructions, cache/branch/TLB misses) for timed iterations.
+  bool hw_counters = false;
+  /// @brief Evict caches before every iteration to measure cold-start instead of warm-cache behavior.
+  bool flush_cache = false;
+  /// @brief Restore a pristine copy of the input before every iteration; TaskRun additionally repeats
+  ///        Validation() and PreProcessing() (untimed) so Run() never sees data left by a previous Run().
+  bool fresh_input = false;
   /// @brief Timer function returning current time in seconds.
   /// @cond
   std::function<double()> current_timer = DefaultTimer;
   /// @endcond
+  /// @brief Synchronization point invoked right before every timed iteration (e.g., MPI barrier).
+  /// @cond
+  std::function<void()> rank_sync = DefaultRankSync;
+  /// @endcond
+  /// @brief Combines per-rank results into a cross-rank view after measurement (e.g., MPI critical path).
+  /// @cond
+  std::function<void(PerfResults &)> rank_reduce = DefaultRankReduce;
+  /// @endcond
 };
 
 struct PerfResults {
-  /// @brief Measured execution time in seconds.
+  /// @brief Measured execution time in seconds (mean over all timed iterations).
   double time_sec = 0.0;
+  /// @brief Per-iteration execution times in seconds, in the order they were measured.
+  std::vector<double> samples;
+  /// @brief Fastest iteration in seconds.
+  double time_min = 0.0;
+  /// @brief Slowest iteration in seconds.
+  double time_max = 0.0;
+  /// @brief Median iteration time in seconds.
+  double time_median = 0.0;
+  /// @brief 90th percentile of iteration times in seconds.
+  double time_p90 = 0.0;
+  /// @brief 99th percentile of iteration times in seconds.
+  double time_p99 = 0.0;
+  /// @brief Sample standard deviation of iteration times in seconds.
+  double time_stddev = 0.0;
+  /// @brief Half-width of the 95% confidence interval of the mean in seconds.
+  double time_ci95 = 0.0;
+  /// @brief Time of every task stage averaged per timed iteration (max over ranks after an MPI reduction);
+  ///        stages not executed inside the timed loop stay zero. Call counts are totals of the timed loop.
+  ppc::task::StageTimes stage_times;
+  /// @brief Bytes and number of allocations of every task stage averaged per timed iteration, with the
+  ///        largest heap and RSS high-water marks (maximum over ranks after an MPI reduction).
+  ///        Filled only when built with USE_ALLOC_TRACKER.
+  ppc::task::StageAllocations stage_allocations{};
+  /// @brief Hardware counters of the calling rank averaged per timed iteration (see PerfAttr::hw_counters).
+  HwCounters hw_counters;
+  /// @brief Number of ranks the times were reduced over (1 if no cross-rank reduction happened).
+  int num_ranks = 1;
+  /// @brief Mean iteration time of the fastest rank in seconds.
+  double rank_time_min = 0.0;
+  /// @brief Mean iteration time of the slowest rank in seconds.
+  double rank_time_max = 0.0;
+  /// @brief Mean iteration time averaged over all ranks in seconds.
+  double rank_time_mean = 0.0;
+  /// @brief Load imbalance ratio: slowest rank time divided by the average rank time.
+  double load_imbalance = 1.0;
   enum class TypeOfRunning : uint8_t { kPipeline, kTaskRun, kNone };
   TypeOfRunning type_of_running = TypeOfRunning::kNone;
+  /// @brief True if caches were flushed before every iteration (see PerfAttr::flush_cache).
+  bool cold_cache = false;
   constexpr static double kMaxTime = 10.0;
 };
 
+/// @brief Returns the percentile of sorted samples using linear interpolation between closest ranks.
+/// @param sorted_samples Samples sorted in ascending order.
+/// @param percentile Requested percentile in range [0, 100].
+/// @return Interpolated value or 0.0 if there are no samples.
+inline double GetPercentile(const std::vector<double> &sorted_samples, double percentile) {
+  if (sorted_samples.empty()) {
+    return 0.0;
+  }
+  const double rank = std::clamp(percentile, 0.0, 100.0) / 100.0 * static_cast<double>(sorted_samples.size() - 1);
+  const auto lower = static_cast<std::size_t>(std::floor(rank));
+  const auto upper = static_cast<std::size_t>(std::ceil(rank));
+  const double fraction = rank - static_cast<double>(lower);
+  return sorted_samples[lower] + ((sorted_samples[upper] - sorted_samples[lower]) * fraction);
+}
+
+/// @brief Returns the two-sided 95% Student's t critical value for the given degrees of freedom.
+inline double GetStudentT95(std::size_t degrees_of_freedom) {
+  constexpr std::array<double, 30> kTable = {12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+                                             2.201,  2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+                                             2.080,  2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042};
+  if (degrees_of_freedom == 0) {
+    return 0.0;
+  }
+  if (degrees_of_freedom <= kTable.size()) {
+    return kTable[degrees_of_freedom - 1];
+  }
+  return 1.960;
+}
+
+/// @brief Fills the statistical fields of PerfResults from its per-iteration samples.
+/// @param perf_results Results whose samples are already collected.
+inline void CalculateStatistics(PerfResults &perf_results) {
+  const auto &samples = perf_results.samples;
+  if (samples.empty()) {
+    return;
+  }
+  const auto count = static_cast<double>(samples.size());
+  const double mean = std::accumulate(samples.begin(), samples.end(), 0.0) / count;
+
+  std::vector<double> sorted = samples;
+  std::ranges::sort(sorted);
+
+  double variance = 0.0;
+  if (samples.size() > 1) {
+    for (double sample : samples) {
+      variance += (sample - mean) * (sample - mean);
+    }
+    variance /= count - 1.0;
+  }
+
+  perf_results.time_sec = mean;
+  perf_results.time_min = sorted.front();
+  perf_results.time_max = sorted.back();
+  perf_results.time_median = GetPercentile(sorted, 50.0);
+  perf_results.time_p90 = GetPercentile(sorted, 90.0);
+  perf_results.time_p99 = GetPercentile(sorted, 99.0);
+  perf_results.time_stddev = std::sqrt(variance);
+  perf_results.time_ci95 = GetStudentT95(samples.size() - 1) * perf_results.time_stddev / std::sqrt(count);
+}
+
 template <typename InType, typename OutType>
 class Perf {
  public:
@@ -47,21 +178,40 @@ class Perf {
   void PipelineRun(const PerfAttr &perf_attr) {
     perf_results_.type_of_running = PerfResults::TypeOfRunning::kPipeline;
 
+    const auto restore_input = MakeInputRestorer(perf_attr);
     CommonRun(perf_attr, [&] {
       task_->Validation();
       task_->PreProcessing();
       task_->Run();
       task_->PostProcessing();
-    }, perf_results_);
+    }, restore_input);
   }
   // Check performance of task's Run() function
   void TaskRun(const PerfAttr &perf_attr) {
     perf_results_.type_of_running = PerfResults::TypeOfRunning::kTaskRun;
 
-    task_->Validation();
-    task_->PreProcessing();
-    CommonRun(perf_attr, [&] { task_->Run(); }, perf_results_);
-    task_->PostProcessing();
+    const auto restore_input = MakeInputRestorer(perf_attr);
+    if (perf_attr.fresh_input) {
+      bool prepared = false;
+      CommonRun(perf_attr, [&] { task_->Run(); }, [&] {
+        if (prepared) {
+          task_->PostProcessing();
+        }
+        restore_input();
+        task_->Validation();
+        task_->PreProcessing();
+        prepared = true;
+      });
+      if (prepared) {
+        task_->PostProcessing();
+      }
+      restore_input();
+    } else {
+      task_->Validation();
+      task_->PreProcessing();
+      CommonRun(perf_attr, [&] { task_->Run(); }, [] {});
+      task_->PostProcessing();
+    }
 
     task_->Validation();
     task_->PreProcessing();
@@ -80,6 +230,9 @@ class Perf {
       err_msg << '\n' << "The type of performance check for the task was not selected.\n";
       throw std::runtime_error(err_msg.str().c_str());
     }
+    if (perf_results_.cold_cache) {
+      type_test_name += "_cold";
+    }
 
     auto time_secs = perf_results_.time_sec;
     const auto max_time = ppc::util::GetPerfMaxTime();
@@ -87,6 +240,11 @@ class Perf {
     if (time_secs < max_time) {
       perf_res_str << std::fixed << std::setprecision(10) << time_secs;
       std::cout << test_id << ":" << type_test_name << ":" << perf_res_str.str() << '\n';
+      PrintSampleStatistic(test_id, type_test_name);
+      PrintRankStatistic(test_id, type_test_name);
+      PrintHwCounterStatistic(test_id, type_test_name);
+      PrintStageStatistic(test_id, type_test_name);
+      PrintAllocStatistic(test_id, type_test_name);
     } else {
       std::stringstream err_msg;
       err_msg << '\n' << "Task execute time need to be: ";
@@ -106,13 +264,150 @@ class Perf {
  private:
   PerfResults perf_results_;
   std::shared_ptr<ppc::task::Task<InType, OutType>> task_;
-  static void CommonRun(const PerfAttr &perf_attr, const std::function<void()> &pipeline, PerfResults &perf_results) {
-    auto begin = perf_attr.current_timer();
+  // Returns a callable that puts a copy of the current input back into the task (no-op without fresh_input)
+  [[nodiscard]] std::function<void()> MakeInputRestorer(const PerfAttr &perf_attr) const {
+    if (!perf_attr.fresh_input) {
+      return [] {};
+    }
+    if constexpr (std::is_copy_constructible_v<InType> && std::is_copy_assignable_v<InType>) {
+      return [task = task_, input = task_->GetInput()] { task->GetInput() = input; };
+    } else {
+      throw std::runtime_error("PerfAttr::fresh_input requires a copyable input type");
+    }
+  }
+  // Runs the untimed preparation and the optional cache flush in front of every iteration
+  static void PrepareIteration(const PerfAttr &perf_attr, const std::function<void()> &prepare) {
+    prepare();
+    if (perf_attr.flush_cache) {
+      FlushCaches();
+    }
+  }
+  void CommonRun(const PerfAttr &perf_attr, const std::function<void()> &pipeline,
+                 const std::function<void()> &prepare) {
+    perf_results_.cold_cache = perf_attr.flush_cache;
+    for (uint64_t i = 0; i < perf_attr.num_warmup; i++) {
+      PrepareIteration(perf_attr, prepare);
+      pipeline();
+    }
+    task_->ResetStageTimes();
+    std::unique_ptr<HwCounterSet> counters;
+    if (perf_attr.hw_counters) {
+      counters = std::make_unique<HwCounterSet>();
+      counters->Reset();
+    }
+    perf_results_.samples.clear();
+    perf_results_.samples.reserve(perf_attr.num_running);
     for (uint64_t i = 0; i < perf_attr.num_running; i++) {
+      PrepareIteration(perf_attr, prepare);
+      perf_attr.rank_sync();
+      // The counter syscalls stay outside the timed interval, so enabling counters does not change the samples
+      if (counters) {
+        counters->Start();
+      }
+      auto begin = perf_attr.current_timer();
       pipeline();
+      auto end = perf_attr.current_timer();
+      if (counters) {
+        counters->Stop();
+      }
+      perf_results_.samples.push_back(end - begin);
+    }
+    const uint64_t num_timed = std::max<uint64_t>(perf_attr.num_running, 1);
+    perf_results_.stage_times = task_->GetStageTimes();
+    for (double &stage_time : perf_results_.stage_times.seconds) {
+      stage_time /= static_cast<double>(num_timed);
+    }
+    perf_results_.stage_allocations = task_->GetStageAllocations();
+    for (auto &stage_alloc : perf_results_.stage_allocations) {
+      stage_alloc.bytes /= num_timed;
+      stage_alloc.allocations /= num_timed;
+    }
+    perf_results_.hw_counters = counters ? counters->Read(perf_attr.num_running) : HwCounters{};
+    CalculateStatistics(perf_results_);
+    perf_attr.rank_reduce(perf_results_);
+  }
+  // Print distribution of per-iteration times; kept on a separate line so the
+  // "test_id:type:time" record stays backward compatible with log scrapers
+  void PrintSampleStatistic(const std::string &test_id, const std::string &type_test_name) const {
+    if (perf_results_.samples.size() < 2) {
+      return;
+    }
+    std::stringstream stat_str;
+    stat_str << std::fixed << std::setprecision(10);
+    stat_str << "n=" << perf_results_.samples.size() << ",min=" << perf_results_.time_min
+             << ",median=" << perf_results_.time_median << ",p90=" << perf_results_.time_p90
+             << ",p99=" << perf_results_.time_p99 << ",max=" << perf_results_.time_max
+             << ",stddev=" << perf_results_.time_stddev << ",ci95=" << perf_results_.time_ci95;
+    std::cout << test_id << ":" << type_test_name << ":stats:" << stat_str.str() << '\n';
+  }
+  // Print hardware counters of the calling rank; counters the kernel refused to open are skipped
+  void PrintHwCounterStatistic(const std::string &test_id, const std::string &type_test_name) const {
+    const auto &counters = perf_results_.hw_counters;
+    if (!counters.IsAvailable()) {
+      return;
+    }
+    std::stringstream hw_str;
+    hw_str << std::fixed << std::setprecision(2);
+    bool first = true;
+    for (std::size_t i = 0; i < kNumHwCounters; i++) {
+      if (counters.values[i] < 0.0) {
+        continue;
+      }
+      hw_str << (first ? "" : ",") << GetHwCounterName(static_cast<HwCounterType>(i)) << "=" << counters.values[i];
+      first = false;
+    }
+    const double cycles = counters.Get(HwCounterType::kCycles);
+    const double instructions = counters.Get(HwCounterType::kInstructions);
+    if (cycles > 0.0 && instructions >= 0.0) {
+      hw_str << ",ipc=" << std::setprecision(4) << instructions / cycles;
+    }
+    std::cout << test_id << ":" << type_test_name << ":hw:" << hw_str.str() << '\n';
+  }
+  // Print time per task stage so distribution overhead can be told apart from compute
+  void PrintStageStatistic(const std::string &test_id, const std::string &type_test_name) const {
+    const auto &stages = perf_results_.stage_times;
+    std::stringstream stage_str;
+    stage_str << std::fixed << std::setprecision(10);
+    bool first = true;
+    for (std::size_t i = 0; i < ppc::task::kNumTaskStages; i++) {
+      if (stages.calls[i] == 0) {
+        continue;
+      }
+      stage_str << (first ? "" : ",") << ppc::task::GetTaskStageName(static_cast<ppc::task::TaskStage>(i)) << "="
+                << stages.seconds[i];
+      first = false;
+    }
+    if (!first) {
+      std::cout << test_id << ":" << type_test_name << ":stages:" << stage_str.str() << '\n';
+    }
+  }
+  // Print heap usage per task stage; requires the operator new/delete hooks of USE_ALLOC_TRACKER
+  void PrintAllocStatistic(const std::string &test_id, const std::string &type_test_name) const {
+    if (!ppc::util::AllocTracker::IsEnabled()) {
+      return;
+    }
+    for (std::size_t i = 0; i < ppc::task::kNumTaskStages; i++) {
+      if (perf_results_.stage_times.calls[i] == 0) {
+        continue;
+      }
+      const auto &stage_alloc = perf_results_.stage_allocations[i];
+      std::cout << test_id << ":" << type_test_name << ":alloc:"
+                << ppc::task::GetTaskStageName(static_cast<ppc::task::TaskStage>(i)) << ":bytes=" << stage_alloc.bytes
+                << ",allocations=" << stage_alloc.allocations << ",peak_heap_bytes=" << stage_alloc.peak_heap_bytes
+                << ",process_peak_rss_kb=" << stage_alloc.process_peak_rss_kb << '\n';
+    }
+  }
+  // Print cross-rank critical path and load imbalance when times were reduced over several ranks
+  void PrintRankStatistic(const std::string &test_id, const std::string &type_test_name) const {
+    if (perf_results_.num_ranks < 2) {
+      return;
     }
-    auto end = perf_attr.current_timer();
-    perf_results.time_sec = (end - begin) / static_cast<double>(perf_attr.num_running);
+    std::stringstream rank_str;
+    rank_str << std::fixed << std::setprecision(10);
+    rank_str << "n=" << perf_results_.num_ranks << ",critical_path=" << perf_results_.time_sec
+             << ",max=" << perf_results_.rank_time_max << ",min=" << perf_results_.rank_time_min
+             << ",mean=" << perf_results_.rank_time_mean << ",imbalance=" << perf_results_.load_imbalance;
+    std::cout << test_id << ":" << type_test_name << ":ranks:" << rank_str.str() << '\n';
   }
 };
 
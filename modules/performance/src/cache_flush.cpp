@@ -0,0 +1,81 @@
+#include "performance/include/cache_flush.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#  include <unistd.h>
+#endif
+
+namespace ppc::performance {
+
+namespace {
+
+constexpr std::size_t kDefaultCacheSize = std::size_t{32} << 20;
+constexpr std::size_t kCacheLine = 64;
+
+// Parses sysfs sizes such as "32768K" or "8M"
+std::size_t ParseCacheSize(const std::string &text) {
+  std::size_t pos = 0;
+  std::size_t value = 0;
+  try {
+    value = std::stoull(text, &pos);
+  } catch (const std::exception &) {
+    return 0;
+  }
+  if (pos < text.size()) {
+    if (text[pos] == 'K') {
+      value <<= 10;
+    } else if (text[pos] == 'M') {
+      value <<= 20;
+    }
+  }
+  return value;
+}
+
+}  // namespace
+
+std::size_t GetLastLevelCacheSize() {
+  static const std::size_t kCacheSize = [] {
+    std::size_t size = 0;
+#ifdef _SC_LEVEL3_CACHE_SIZE
+    const auto l3 = sysconf(_SC_LEVEL3_CACHE_SIZE);
+    size = l3 > 0 ? static_cast<std::size_t>(l3) : 0;
+#endif
+#ifdef __linux__
+    // Fall back to the highest cache level exported by sysfs
+    for (int index = 4; size == 0 && index >= 0; index--) {
+      std::ifstream file("/sys/devices/system/cpu/cpu0/cache/index" + std::to_string(index) + "/size");
+      std::string text;
+      if (file >> text) {
+        size = ParseCacheSize(text);
+      }
+    }
+#endif
+    return size > 0 ? size : kDefaultCacheSize;
+  }();
+  return kCacheSize;
+}
+
+void FlushCaches() {
+  static std::vector<uint8_t> buffer(2 * GetLastLevelCacheSize());
+  static uint8_t round = 0;
+  round++;
+  // Write every line so modified task data is written back and evicted, then read it back
+  for (std::size_t i = 0; i < buffer.size(); i += kCacheLine) {
+    buffer[i] = round;
+  }
+  volatile uint8_t sink = 0;
+  uint8_t sum = 0;
+  for (std::size_t i = 0; i < buffer.size(); i += kCacheLine) {
+    sum = static_cast<uint8_t>(sum + buffer[i]);
+  }
+  sink = sum;
+  (void)sink;
+}
+
+}  // namespace ppc::performance
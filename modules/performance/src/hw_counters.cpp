@@ -0,0 +1,183 @@
+#include "performance/include/hw_counters.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#ifdef __linux__
+#  include <linux/perf_event.h>
+#  include <sys/ioctl.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+
+#  include <cstring>
+#  include <filesystem>
+#  include <system_error>
+#  include <vector>
+#endif
+
+namespace ppc::performance {
+
+namespace {
+
+#ifdef __linux__
+struct HwEventConfig {
+  uint32_t type;
+  uint64_t config;
+};
+
+HwEventConfig GetEventConfig(HwCounterType type) {
+  switch (type) {
+    case HwCounterType::kCycles:
+      return {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES};
+    case HwCounterType::kInstructions:
+      return {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS};
+    case HwCounterType::kLLCMisses:
+      return {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES};
+    case HwCounterType::kBranchMisses:
+      return {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES};
+    case HwCounterType::kDTLBMisses:
+      return {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8U) |
+                                      (PERF_COUNT_HW_CACHE_RESULT_MISS << 16U)};
+    case HwCounterType::kCount:
+    default:
+      return {PERF_TYPE_MAX, 0};
+  }
+}
+
+int OpenCounter(HwCounterType type, pid_t tid) {
+  const auto event = GetEventConfig(type);
+  if (event.type == PERF_TYPE_MAX) {
+    return -1;
+  }
+  perf_event_attr attr{};
+  std::memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = event.type;
+  attr.config = event.config;
+  attr.disabled = 1;
+  attr.inherit = 1;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+  return static_cast<int>(syscall(SYS_perf_event_open, &attr, tid, -1, -1, 0));
+}
+
+// A counter opened for the process only follows threads created afterwards, so every thread alive now (e.g. the
+// workers of thread pools started earlier) gets a counter of its own
+std::vector<pid_t> ListThreads() {
+  std::vector<pid_t> tids;
+  std::error_code ec;
+  for (const auto &entry : std::filesystem::directory_iterator("/proc/self/task", ec)) {
+    tids.push_back(static_cast<pid_t>(std::stol(entry.path().filename().string())));
+  }
+  if (tids.empty()) {
+    tids.push_back(static_cast<pid_t>(syscall(SYS_gettid)));
+  }
+  return tids;
+}
+
+void ForEachFd(const std::array<std::vector<int>, kNumHwCounters> &fds, uint64_t request) {
+  for (const auto &counter_fds : fds) {
+    for (int fd : counter_fds) {
+      ioctl(fd, request, 0);
+    }
+  }
+}
+#endif
+
+}  // namespace
+
+std::string GetHwCounterName(HwCounterType type) {
+  switch (type) {
+    case HwCounterType::kCycles:
+      return "cycles";
+    case HwCounterType::kInstructions:
+      return "instructions";
+    case HwCounterType::kLLCMisses:
+      return "llc_misses";
+    case HwCounterType::kBranchMisses:
+      return "branch_misses";
+    case HwCounterType::kDTLBMisses:
+      return "dtlb_misses";
+    case HwCounterType::kCount:
+    default:
+      return "unknown";
+  }
+}
+
+HwCounterSet::HwCounterSet() {
+#ifdef __linux__
+  const auto tids = ListThreads();
+  for (std::size_t i = 0; i < kNumHwCounters; i++) {
+    for (const pid_t tid : tids) {
+      const int fd = OpenCounter(static_cast<HwCounterType>(i), tid);
+      if (fd >= 0) {
+        fds_[i].push_back(fd);
+      }
+    }
+  }
+#endif
+}
+
+HwCounterSet::~HwCounterSet() {
+#ifdef __linux__
+  for (const auto &counter_fds : fds_) {
+    for (int fd : counter_fds) {
+      close(fd);
+    }
+  }
+#endif
+}
+
+void HwCounterSet::Reset() {
+#ifdef __linux__
+  ForEachFd(fds_, PERF_EVENT_IOC_RESET);
+#endif
+}
+
+void HwCounterSet::Start() {
+#ifdef __linux__
+  ForEachFd(fds_, PERF_EVENT_IOC_ENABLE);
+#endif
+}
+
+void HwCounterSet::Stop() {
+#ifdef __linux__
+  ForEachFd(fds_, PERF_EVENT_IOC_DISABLE);
+#endif
+}
+
+HwCounters HwCounterSet::Read(uint64_t iterations) const {
+  HwCounters counters;
+#ifdef __linux__
+  const double divider = iterations > 0 ? static_cast<double>(iterations) : 1.0;
+  for (std::size_t i = 0; i < kNumHwCounters; i++) {
+    double total = 0.0;
+    bool measured = false;
+    for (int fd : fds_[i]) {
+      // value, time_enabled, time_running
+      std::array<uint64_t, 3> data{};
+      if (read(fd, data.data(), sizeof(data)) != static_cast<ssize_t>(sizeof(data))) {
+        continue;
+      }
+      auto value = static_cast<double>(data[0]);
+      // Scale up when the kernel multiplexed the counter with other events
+      if (data[2] > 0 && data[2] < data[1]) {
+        value *= static_cast<double>(data[1]) / static_cast<double>(data[2]);
+      }
+      total += value;
+      measured = true;
+    }
+    if (measured) {
+      counters.values[i] = total / divider;
+    }
+  }
+#else
+  (void)iterations;
+#endif
+  return counters;
+}
+
+}  // namespace ppc::performance
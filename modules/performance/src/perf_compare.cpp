@@ -0,0 +1,102 @@
+#include "performance/include/perf_compare.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <numbers>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "performance/include/performance.hpp"
+
+namespace ppc::performance {
+
+std::string GetPerfVerdictName(PerfVerdict verdict) {
+  switch (verdict) {
+    case PerfVerdict::kUnchanged:
+      return "unchanged";
+    case PerfVerdict::kRegression:
+      return "regression";
+    case PerfVerdict::kImprovement:
+      return "improvement";
+    default:
+      return "unknown";
+  }
+}
+
+double GetMannWhitneyPValue(const std::vector<double> &lhs, const std::vector<double> &rhs) {
+  if (lhs.size() < 2 || rhs.size() < 2) {
+    return 1.0;
+  }
+
+  // Pool both samples (value, is_lhs) and assign mid-ranks to ties
+  std::vector<std::pair<double, bool>> pooled;
+  pooled.reserve(lhs.size() + rhs.size());
+  for (double value : lhs) {
+    pooled.emplace_back(value, true);
+  }
+  for (double value : rhs) {
+    pooled.emplace_back(value, false);
+  }
+  std::ranges::sort(pooled, {}, &std::pair<double, bool>::first);
+
+  const auto n = static_cast<double>(pooled.size());
+  double lhs_rank_sum = 0.0;
+  double tie_term = 0.0;
+  for (std::size_t begin = 0; begin < pooled.size();) {
+    std::size_t end = begin;
+    while (end < pooled.size() && pooled[end].first == pooled[begin].first) {
+      end++;
+    }
+    const auto ties = static_cast<double>(end - begin);
+    const double mid_rank = (static_cast<double>(begin + end) + 1.0) / 2.0;
+    for (std::size_t i = begin; i < end; i++) {
+      if (pooled[i].second) {
+        lhs_rank_sum += mid_rank;
+      }
+    }
+    tie_term += (ties * ties * ties) - ties;
+    begin = end;
+  }
+
+  const auto n1 = static_cast<double>(lhs.size());
+  const auto n2 = static_cast<double>(rhs.size());
+  const double u = lhs_rank_sum - (n1 * (n1 + 1.0) / 2.0);
+  const double mean = n1 * n2 / 2.0;
+  const double variance = n1 * n2 / 12.0 * ((n + 1.0) - (tie_term / (n * (n - 1.0))));
+  if (variance <= 0.0) {
+    return 1.0;
+  }
+  // Continuity correction towards the mean
+  const double z = std::max(std::abs(u - mean) - 0.5, 0.0) / std::sqrt(variance);
+  return std::erfc(z / std::numbers::sqrt2);
+}
+
+PerfComparison ComparePerfSamples(const std::vector<double> &baseline, const std::vector<double> &current,
+                                  double threshold, double alpha) {
+  PerfComparison comparison;
+  auto sorted_baseline = baseline;
+  auto sorted_current = current;
+  std::ranges::sort(sorted_baseline);
+  std::ranges::sort(sorted_current);
+  comparison.baseline_median = GetPercentile(sorted_baseline, 50.0);
+  comparison.current_median = GetPercentile(sorted_current, 50.0);
+  if (comparison.baseline_median <= 0.0 || comparison.current_median <= 0.0) {
+    return comparison;
+  }
+
+  comparison.change = (comparison.current_median / comparison.baseline_median) - 1.0;
+  comparison.p_value = GetMannWhitneyPValue(baseline, current);
+  if (comparison.p_value >= alpha) {
+    return comparison;
+  }
+  if (comparison.change > threshold) {
+    comparison.verdict = PerfVerdict::kRegression;
+  } else if (comparison.change < -threshold) {
+    comparison.verdict = PerfVerdict::kImprovement;
+  }
+  return comparison;
+}
+
+}  // namespace ppc::performance
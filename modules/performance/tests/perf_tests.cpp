@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 
 #include <chrono>
+#include <cmath>
 #include <cstdint>
 #include <filesystem>
 #include <fstream>
@@ -12,6 +13,8 @@
 #include <thread>
 #include <vector>
 
+#include "performance/include/cache_flush.hpp"
+#include "performance/include/perf_compare.hpp"
 #include "performance/include/performance.hpp"
 #include "task/include/task.hpp"
 #include "util/include/util.hpp"
@@ -61,6 +64,35 @@ class FakePerfTask : public TestPerfTask<InType, OutType> {
   }
 };
 
+// Consumes its input in Run(), like in-place algorithms do
+class InputConsumingTask : public ppc::task::Task<std::vector<int>, int> {
+ public:
+  explicit InputConsumingTask(const std::vector<int> &in) {
+    this->GetInput() = in;
+  }
+
+  std::vector<int> seen_sizes;
+
+ protected:
+  bool ValidationImpl() override {
+    return true;
+  }
+  bool PreProcessingImpl() override {
+    return true;
+  }
+  bool RunImpl() override {
+    seen_sizes.push_back(static_cast<int>(this->GetInput().size()));
+    if (!this->GetInput().empty()) {
+      this->GetInput().pop_back();
+    }
+    this->GetOutput() = static_cast<int>(this->GetInput().size());
+    return true;
+  }
+  bool PostProcessingImpl() override {
+    return true;
+  }
+};
+
 }  // namespace ppc::test
 
 namespace ppc::performance {
@@ -350,6 +382,198 @@ TEST(PerfTest, PipelineRunAndTaskRun) {
   EXPECT_GT(res_taskrun.time_sec, 0.0);
 }
 
+TEST(PerfTest, CollectsPerIterationSamples) {
+  auto task_ptr = std::make_shared<DummyTask>();
+  Perf<int, int> perf(task_ptr);
+
+  PerfAttr attr;
+  attr.num_running = 5;
+  double time = 0.0;
+  double step = 1.0;
+  attr.current_timer = [&time, &step]() {
+    double t = time;
+    time += step;
+    step += 0.5;
+    return t;
+  };
+
+  perf.PipelineRun(attr);
+  const auto res = perf.GetPerfResults();
+  ASSERT_EQ(res.samples.size(), 5U);
+  EXPECT_DOUBLE_EQ(res.samples[0], 1.0);
+  EXPECT_DOUBLE_EQ(res.samples[4], 5.0);
+  EXPECT_DOUBLE_EQ(res.time_min, 1.0);
+  EXPECT_DOUBLE_EQ(res.time_max, 5.0);
+  EXPECT_DOUBLE_EQ(res.time_median, 3.0);
+  EXPECT_DOUBLE_EQ(res.time_sec, 3.0);
+  EXPECT_DOUBLE_EQ(res.time_p90, 4.6);
+  EXPECT_NEAR(res.time_stddev, 1.5811388, 1e-6);
+  EXPECT_NEAR(res.time_ci95, 2.776 * 1.5811388 / std::sqrt(5.0), 1e-6);
+}
+
+TEST(PerfTest, WarmupIterationsAreNotTimed) {
+  auto task_ptr = std::make_shared<DummyTask>();
+  Perf<int, int> perf(task_ptr);
+
+  PerfAttr attr;
+  attr.num_running = 3;
+  attr.num_warmup = 2;
+  int timer_calls = 0;
+  attr.current_timer = [&timer_calls]() { return static_cast<double>(timer_calls++); };
+
+  perf.TaskRun(attr);
+  EXPECT_EQ(timer_calls, 6);
+  EXPECT_EQ(perf.GetPerfResults().samples.size(), 3U);
+}
+
+TEST(PerfTest, StageTimesCoverTimedIterationsOnly) {
+  auto task_ptr = std::make_shared<DummyTask>();
+  Perf<int, int> perf(task_ptr);
+
+  PerfAttr attr;
+  attr.num_running = 4;
+  attr.num_warmup = 1;
+  perf.TaskRun(attr);
+
+  const auto &stages = perf.GetPerfResults().stage_times;
+  EXPECT_EQ(stages.calls[static_cast<std::size_t>(ppc::task::TaskStage::kRun)], 4U);
+  EXPECT_EQ(stages.calls[static_cast<std::size_t>(ppc::task::TaskStage::kValidation)], 0U);
+
+  perf.PipelineRun(attr);
+  for (uint64_t calls : perf.GetPerfResults().stage_times.calls) {
+    EXPECT_EQ(calls, 4U);
+  }
+}
+
+TEST(PerfTest, FreshInputRestoresInputForEveryTaskRun) {
+  auto task_ptr = std::make_shared<ppc::test::InputConsumingTask>(std::vector<int>(10, 1));
+  Perf<std::vector<int>, int> perf(task_ptr);
+
+  PerfAttr attr;
+  attr.num_running = 3;
+  attr.num_warmup = 1;
+  attr.fresh_input = true;
+  perf.TaskRun(attr);
+
+  EXPECT_EQ(task_ptr->seen_sizes, std::vector<int>(5, 10));
+  EXPECT_EQ(task_ptr->GetOutput(), 9);
+  EXPECT_FALSE(perf.GetPerfResults().cold_cache);
+}
+
+TEST(PerfTest, TaskRunWithoutFreshInputReusesInput) {
+  auto task_ptr = std::make_shared<ppc::test::InputConsumingTask>(std::vector<int>(10, 1));
+  Perf<std::vector<int>, int> perf(task_ptr);
+
+  PerfAttr attr;
+  attr.num_running = 3;
+  perf.TaskRun(attr);
+
+  EXPECT_EQ(task_ptr->seen_sizes, (std::vector<int>{10, 9, 8, 7}));
+}
+
+TEST(PerfTest, FlushCacheMarksResultsCold) {
+  auto task_ptr = std::make_shared<ppc::test::InputConsumingTask>(std::vector<int>(10, 1));
+  Perf<std::vector<int>, int> perf(task_ptr);
+
+  PerfAttr attr;
+  attr.num_running = 2;
+  attr.flush_cache = true;
+  attr.fresh_input = true;
+  perf.PipelineRun(attr);
+
+  EXPECT_TRUE(perf.GetPerfResults().cold_cache);
+  EXPECT_EQ(task_ptr->seen_sizes, std::vector<int>(2, 10));
+  EXPECT_GT(GetLastLevelCacheSize(), 0U);
+}
+
+TEST(PerfTest, RankHooksWrapTimedIterations) {
+  auto task_ptr = std::make_shared<DummyTask>();
+  Perf<int, int> perf(task_ptr);
+
+  PerfAttr attr;
+  attr.num_running = 4;
+  attr.num_warmup = 1;
+  int sync_calls = 0;
+  int reduce_calls = 0;
+  attr.rank_sync = [&sync_calls]() { sync_calls++; };
+  attr.rank_reduce = [&reduce_calls](PerfResults &results) {
+    reduce_calls++;
+    results.num_ranks = 2;
+    results.rank_time_max = 2.0;
+    results.rank_time_mean = 1.0;
+    results.load_imbalance = 2.0;
+  };
+
+  perf.PipelineRun(attr);
+  EXPECT_EQ(sync_calls, 4);
+  EXPECT_EQ(reduce_calls, 1);
+  EXPECT_EQ(perf.GetPerfResults().num_ranks, 2);
+  EXPECT_DOUBLE_EQ(perf.GetPerfResults().load_imbalance, 2.0);
+  EXPECT_NO_THROW(perf.PrintPerfStatistic("rank_hooks_wrap_timed_iterations"));
+}
+
+TEST(PerfTest, HwCountersAreOptIn) {
+  auto task_ptr = std::make_shared<DummyTask>();
+  Perf<int, int> perf(task_ptr);
+
+  PerfAttr attr;
+  perf.PipelineRun(attr);
+  EXPECT_FALSE(perf.GetPerfResults().hw_counters.IsAvailable());
+
+  attr.hw_counters = true;
+  perf.PipelineRun(attr);
+  const auto &counters = perf.GetPerfResults().hw_counters;
+  if (counters.IsAvailable()) {
+    EXPECT_GE(counters.Get(HwCounterType::kInstructions), 0.0);
+  }
+  EXPECT_NO_THROW(perf.PrintPerfStatistic("hw_counters_are_opt_in"));
+}
+
+TEST(PerfTest, GetHwCounterNameReturnsShortNames) {
+  EXPECT_EQ(GetHwCounterName(HwCounterType::kCycles), "cycles");
+  EXPECT_EQ(GetHwCounterName(HwCounterType::kLLCMisses), "llc_misses");
+  EXPECT_EQ(GetHwCounterName(HwCounterType::kDTLBMisses), "dtlb_misses");
+  EXPECT_EQ(GetHwCounterName(HwCounterType::kCount), "unknown");
+}
+
+TEST(PerfTest, GetPercentileInterpolates) {
+  const std::vector<double> sorted = {1.0, 2.0, 3.0, 4.0};
+  EXPECT_DOUBLE_EQ(GetPercentile(sorted, 0.0), 1.0);
+  EXPECT_DOUBLE_EQ(GetPercentile(sorted, 50.0), 2.5);
+  EXPECT_DOUBLE_EQ(GetPercentile(sorted, 100.0), 4.0);
+  EXPECT_DOUBLE_EQ(GetPercentile({}, 50.0), 0.0);
+}
+
+TEST(PerfTest, ComparePerfSamplesFlagsSignificantSlowdown) {
+  const std::vector<double> baseline = {1.00, 1.01, 0.99, 1.02, 0.98, 1.00};
+  const std::vector<double> current = {1.30, 1.31, 1.29, 1.32, 1.28, 1.30};
+  const auto comparison = ComparePerfSamples(baseline, current, 0.1);
+  EXPECT_EQ(comparison.verdict, PerfVerdict::kRegression);
+  EXPECT_NEAR(comparison.change, 0.3, 1e-9);
+  EXPECT_LT(comparison.p_value, 0.05);
+  EXPECT_EQ(ComparePerfSamples(current, baseline, 0.1).verdict, PerfVerdict::kImprovement);
+}
+
+TEST(PerfTest, ComparePerfSamplesIgnoresNoise) {
+  // Medians differ by 20%, but the distributions overlap heavily
+  const std::vector<double> baseline = {1.0, 2.0, 0.5, 1.5, 1.0};
+  const std::vector<double> current = {1.2, 0.6, 2.1, 1.2, 1.4};
+  EXPECT_EQ(ComparePerfSamples(baseline, current, 0.1).verdict, PerfVerdict::kUnchanged);
+}
+
+TEST(PerfTest, ComparePerfSamplesRespectsThreshold) {
+  const std::vector<double> baseline = {1.00, 1.00, 1.00, 1.00, 1.00};
+  const std::vector<double> current = {1.05, 1.05, 1.05, 1.05, 1.05};
+  const auto comparison = ComparePerfSamples(baseline, current, 0.1);
+  EXPECT_LT(comparison.p_value, 0.05);
+  EXPECT_EQ(comparison.verdict, PerfVerdict::kUnchanged);
+}
+
+TEST(PerfTest, GetMannWhitneyPValueNeedsSamples) {
+  EXPECT_DOUBLE_EQ(GetMannWhitneyPValue({1.0}, {2.0, 3.0}), 1.0);
+  EXPECT_DOUBLE_EQ(GetMannWhitneyPValue({1.0, 1.0}, {1.0, 1.0}), 1.0);
+}
+
 TEST(PerfTest, PrintPerfStatisticThrowsOnNone) {
   {
     auto task_ptr = std::make_shared<DummyTask>();
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ppc::runners {
+
+/// @brief CPU binding policy applied to every rank and its worker threads at runner startup.
+enum class BindPolicy : uint8_t {
+  /// Leave placement to the OS and the MPI launcher
+  kNone,
+  /// Fill neighbouring cores (and their SMT siblings) rank by rank
+  kCompact,
+  /// Spread ranks and threads across sockets and physical cores before using SMT siblings
+  kScatter,
+  /// Bind every rank to all CPUs of one NUMA node (round-robin over nodes)
+  kNumaLocal
+};
+
+/// @brief Reads the policy from PPC_BIND ("compact", "scatter", "numa-local", "none"; default "none").
+/// @throws std::runtime_error If the value is not recognized.
+BindPolicy GetBindPolicy();
+std::string GetBindPolicyName(BindPolicy policy);
+
+/// @brief Location of a logical CPU in the node topology.
+struct CpuInfo {
+  int cpu = 0;
+  int package = 0;
+  int core = 0;
+  int numa_node = 0;
+};
+
+/// @brief Returns the CPUs of the node available to the job (Linux sysfs; empty elsewhere).
+std::vector<CpuInfo> GetCpuTopology();
+
+/// @brief Selects the CPUs for one rank.
+/// @param local_rank Rank index among the ranks of the same node.
+/// @param local_size Number of ranks on the node.
+/// @param threads_per_rank Number of worker threads of every rank (PPC_NUM_THREADS).
+/// @return Sorted CPU ids; empty for BindPolicy::kNone or an empty topology.
+std::vector<int> SelectCpus(BindPolicy policy, const std::vector<CpuInfo> &topology, int local_rank, int local_size,
+                            int threads_per_rank);
+
+/// @brief Formats sorted CPU ids as a compact list (e.g., "0-3,8").
+std::string FormatCpuList(const std::vector<int> &cpus);
+
+/// @brief Applies the policy to the calling process; threads started afterwards (OpenMP, TBB, STL) inherit
+///        the CPU set.
+/// @return CPU list of the calling process after binding (e.g., "0-3"), "unknown" if it cannot be queried.
+std::string ApplyBindPolicy(BindPolicy policy, int local_rank, int local_size);
+
+}  // namespace ppc::runners
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace ppc::runners {
+
+/// @brief MPI routines intercepted by the PMPI profiling layer.
+enum class MpiRoutine : uint8_t {
+  kSend,
+  kSsend,
+  kIsend,
+  kRecv,
+  kIrecv,
+  kSendrecv,
+  kWait,
+  kWaitall,
+  kProbe,
+  kBarrier,
+  kBcast,
+  kReduce,
+  kAllreduce,
+  kScan,
+  kScatter,
+  kScatterv,
+  kGather,
+  kGatherv,
+  kAllgather,
+  kAllgatherv,
+  kAlltoall,
+  kAlltoallv,
+  kCount
+};
+
+inline constexpr std::size_t kNumMpiRoutines = static_cast<std::size_t>(MpiRoutine::kCount);
+
+/// @brief Returns the MPI name of the routine (e.g., "MPI_Allreduce").
+std::string GetMpiRoutineName(MpiRoutine routine);
+
+/// @brief Accumulated statistics of a single MPI routine on the calling rank.
+struct MpiRoutineStats {
+  uint64_t calls = 0;
+  /// Payload described by count/datatype arguments on this rank
+  uint64_t bytes = 0;
+  double time_sec = 0.0;
+};
+
+/// @brief Thread-safe accumulators backing MpiRoutineStats.
+struct MpiRoutineCounters {
+  std::atomic<uint64_t> calls{0};
+  std::atomic<uint64_t> bytes{0};
+  std::atomic<uint64_t> time_ns{0};
+};
+
+/// @brief Per-rank registry filled by the PMPI wrappers.
+/// @details Wrappers are compiled only with -D USE_MPI_PROFILER=ON; otherwise the registry stays empty.
+class MpiProfiler {
+ public:
+  /// @brief Checks whether the PMPI wrappers are linked into the binary.
+  static constexpr bool IsEnabled() {
+#ifdef USE_MPI_PROFILER
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  /// @brief Accounts one call of the routine.
+  static void Record(MpiRoutine routine, uint64_t bytes, double time_sec) {
+    auto &entry = entries[static_cast<std::size_t>(routine)];
+    entry.calls.fetch_add(1, std::memory_order_relaxed);
+    entry.bytes.fetch_add(bytes, std::memory_order_relaxed);
+    entry.time_ns.fetch_add(static_cast<uint64_t>(time_sec * 1e9), std::memory_order_relaxed);
+  }
+
+  /// @brief Clears all accumulated statistics.
+  static void Reset() {
+    for (auto &entry : entries) {
+      entry.calls.store(0);
+      entry.bytes.store(0);
+      entry.time_ns.store(0);
+    }
+  }
+
+  /// @brief Returns a snapshot of the statistics of the routine.
+  static MpiRoutineStats Get(MpiRoutine routine) {
+    const auto &entry = entries[static_cast<std::size_t>(routine)];
+    return {.calls = entry.calls.load(),
+            .bytes = entry.bytes.load(),
+            .time_sec = static_cast<double>(entry.time_ns.load()) * 1e-9};
+  }
+
+ private:
+  inline static std::array<MpiRoutineCounters, kNumMpiRoutines> entries{};
+};
+
+/// @brief GTest event listener that reports MPI communication statistics of every test and rank.
+/// @details Counters are reset when a test starts; on test end rank 0 gathers the tables of all ranks
+///          and prints one "<test>:mpi_profile:rank=<r>:<routine>:calls=..,bytes=..,time=.." line per
+///          used routine.
+class MpiProfilerReporter : public ::testing::EmptyTestEventListener {
+ public:
+  void OnTestStart(const ::testing::TestInfo &test_info) override;
+  void OnTestEnd(const ::testing::TestInfo &test_info) override;
+};
+
+}  // namespace ppc::runners
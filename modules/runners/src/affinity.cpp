@@ -0,0 +1,251 @@
+#include "runners/include/affinity.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <exception>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <libenvpp/detail/get.hpp>
+#include <map>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "util/include/util.hpp"
+
+#ifdef __linux__
+#  include <sched.h>
+#endif
+
+namespace ppc::runners {
+
+namespace {
+
+std::string ReadFirstLine(const std::filesystem::path &path) {
+  std::ifstream file(path);
+  std::string line;
+  std::getline(file, line);
+  return line;
+}
+
+int ReadInt(const std::filesystem::path &path, int fallback) {
+  try {
+    return std::stoi(ReadFirstLine(path));
+  } catch (const std::exception &) {
+    return fallback;
+  }
+}
+
+// Parses kernel CPU lists such as "0-3,8,10-11"
+std::vector<int> ParseCpuList(const std::string &text) {
+  std::vector<int> cpus;
+  std::stringstream stream(text);
+  std::string range;
+  while (std::getline(stream, range, ',')) {
+    try {
+      const auto dash = range.find('-');
+      const int first = std::stoi(range.substr(0, dash));
+      const int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+      for (int cpu = first; cpu <= last; cpu++) {
+        cpus.push_back(cpu);
+      }
+    } catch (const std::exception &) {
+      continue;
+    }
+  }
+  return cpus;
+}
+
+// CPU with its SMT sibling index and the index of its physical core inside the package
+struct RankedCpu {
+  CpuInfo info;
+  int smt = 0;
+  int core_rank = 0;
+};
+
+std::vector<RankedCpu> RankCpus(const std::vector<CpuInfo> &topology) {
+  std::vector<RankedCpu> ranked;
+  ranked.reserve(topology.size());
+  for (const auto &info : topology) {
+    ranked.push_back({.info = info});
+  }
+  std::ranges::sort(ranked, {}, [](const RankedCpu &c) { return std::tuple(c.info.package, c.info.core, c.info.cpu); });
+  for (std::size_t i = 1; i < ranked.size(); i++) {
+    const auto &prev = ranked[i - 1];
+    auto &cur = ranked[i];
+    const bool same_package = prev.info.package == cur.info.package;
+    const bool same_core = same_package && prev.info.core == cur.info.core;
+    cur.smt = same_core ? prev.smt + 1 : 0;
+    cur.core_rank = same_core ? prev.core_rank : (same_package ? prev.core_rank + 1 : 0);
+  }
+  return ranked;
+}
+
+}  // namespace
+
+BindPolicy GetBindPolicy() {
+  const auto val = env::get<std::string>("PPC_BIND");
+  if (!val.has_value() || val.value().empty() || val.value() == "none") {
+    return BindPolicy::kNone;
+  }
+  if (val.value() == "compact") {
+    return BindPolicy::kCompact;
+  }
+  if (val.value() == "scatter") {
+    return BindPolicy::kScatter;
+  }
+  if (val.value() == "numa-local") {
+    return BindPolicy::kNumaLocal;
+  }
+  throw std::runtime_error("Unknown PPC_BIND value: " + val.value());
+}
+
+std::string GetBindPolicyName(BindPolicy policy) {
+  switch (policy) {
+    case BindPolicy::kCompact:
+      return "compact";
+    case BindPolicy::kScatter:
+      return "scatter";
+    case BindPolicy::kNumaLocal:
+      return "numa-local";
+    case BindPolicy::kNone:
+    default:
+      return "none";
+  }
+}
+
+std::vector<CpuInfo> GetCpuTopology() {
+  std::vector<CpuInfo> topology;
+#ifdef __linux__
+  const std::filesystem::path cpu_root = "/sys/devices/system/cpu";
+  auto cpus = ParseCpuList(ReadFirstLine(cpu_root / "online"));
+  // Respect the cpuset of the job when running inside a cgroup (v2)
+  const auto cgroup_cpus = ParseCpuList(ReadFirstLine("/sys/fs/cgroup/cpuset.cpus.effective"));
+  if (!cgroup_cpus.empty()) {
+    const std::set<int> allowed(cgroup_cpus.begin(), cgroup_cpus.end());
+    std::erase_if(cpus, [&](int cpu) { return !allowed.contains(cpu); });
+  }
+
+  std::map<int, int> numa_of_cpu;
+  std::error_code ec;
+  for (const auto &entry : std::filesystem::directory_iterator("/sys/devices/system/node", ec)) {
+    const auto name = entry.path().filename().string();
+    if (!name.starts_with("node") || name.size() == 4 || !std::isdigit(static_cast<unsigned char>(name[4]))) {
+      continue;
+    }
+    const int node = std::stoi(name.substr(4));
+    for (int cpu : ParseCpuList(ReadFirstLine(entry.path() / "cpulist"))) {
+      numa_of_cpu[cpu] = node;
+    }
+  }
+
+  for (int cpu : cpus) {
+    const auto topo = cpu_root / ("cpu" + std::to_string(cpu)) / "topology";
+    topology.push_back({.cpu = cpu,
+                        .package = ReadInt(topo / "physical_package_id", 0),
+                        .core = ReadInt(topo / "core_id", cpu),
+                        .numa_node = numa_of_cpu.contains(cpu) ? numa_of_cpu[cpu] : 0});
+  }
+#endif
+  return topology;
+}
+
+std::vector<int> SelectCpus(BindPolicy policy, const std::vector<CpuInfo> &topology, int local_rank, int local_size,
+                            int threads_per_rank) {
+  if (policy == BindPolicy::kNone || topology.empty()) {
+    return {};
+  }
+  const int threads = std::max(threads_per_rank, 1);
+  const int ranks = std::max(local_size, 1);
+  std::vector<int> selected;
+
+  if (policy == BindPolicy::kNumaLocal) {
+    std::set<int> nodes;
+    for (const auto &info : topology) {
+      nodes.insert(info.numa_node);
+    }
+    const int node = *std::next(nodes.begin(), static_cast<std::ptrdiff_t>(local_rank % static_cast<int>(nodes.size())));
+    for (const auto &info : topology) {
+      if (info.numa_node == node) {
+        selected.push_back(info.cpu);
+      }
+    }
+  } else {
+    auto ranked = RankCpus(topology);
+    if (policy == BindPolicy::kScatter) {
+      // One CPU per package in turn, physical cores before SMT siblings
+      std::ranges::sort(ranked, {}, [](const RankedCpu &c) { return std::tuple(c.smt, c.core_rank, c.info.package); });
+    }
+    const auto count = static_cast<int>(ranked.size());
+    for (int k = 0; k < threads; k++) {
+      // Compact takes consecutive CPUs per rank, scatter interleaves ranks
+      const int position = policy == BindPolicy::kCompact ? (local_rank * threads) + k : local_rank + (k * ranks);
+      selected.push_back(ranked[static_cast<std::size_t>(position % count)].info.cpu);
+    }
+  }
+
+  std::ranges::sort(selected);
+  const auto [first, last] = std::ranges::unique(selected);
+  selected.erase(first, last);
+  return selected;
+}
+
+std::string FormatCpuList(const std::vector<int> &cpus) {
+  std::string text;
+  for (std::size_t i = 0; i < cpus.size();) {
+    std::size_t j = i;
+    while (j + 1 < cpus.size() && cpus[j + 1] == cpus[j] + 1) {
+      j++;
+    }
+    text += (text.empty() ? "" : ",") + std::to_string(cpus[i]);
+    if (j > i) {
+      text += "-" + std::to_string(cpus[j]);
+    }
+    i = j + 1;
+  }
+  return text;
+}
+
+std::string ApplyBindPolicy(BindPolicy policy, int local_rank, int local_size) {
+#ifdef __linux__
+  const auto cpus = SelectCpus(policy, GetCpuTopology(), local_rank, local_size, ppc::util::GetNumThreads());
+  if (!cpus.empty()) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : cpus) {
+      CPU_SET(cpu, &set);
+    }
+    if (sched_setaffinity(0, sizeof(set), &set) != 0) {
+      std::cerr << std::format("[  WARNING  ] Failed to bind to CPUs {} ({})", FormatCpuList(cpus),
+                               GetBindPolicyName(policy))
+                << '\n';
+    }
+  }
+
+  cpu_set_t current;
+  CPU_ZERO(&current);
+  if (sched_getaffinity(0, sizeof(current), &current) != 0) {
+    return "unknown";
+  }
+  std::vector<int> bound;
+  for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+    if (CPU_ISSET(cpu, &current)) {
+      bound.push_back(cpu);
+    }
+  }
+  return FormatCpuList(bound);
+#else
+  (void)policy;
+  (void)local_rank;
+  (void)local_size;
+  return "unknown";
+#endif
+}
+
+}  // namespace ppc::runners
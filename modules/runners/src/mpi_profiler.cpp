@@ -0,0 +1,305 @@
+#include "runners/include/mpi_profiler.hpp"
+
+#include <gtest/gtest.h>
+#include <mpi.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace ppc::runners {
+
+std::string GetMpiRoutineName(MpiRoutine routine) {
+  switch (routine) {
+    case MpiRoutine::kSend:
+      return "MPI_Send";
+    case MpiRoutine::kSsend:
+      return "MPI_Ssend";
+    case MpiRoutine::kIsend:
+      return "MPI_Isend";
+    case MpiRoutine::kRecv:
+      return "MPI_Recv";
+    case MpiRoutine::kIrecv:
+      return "MPI_Irecv";
+    case MpiRoutine::kSendrecv:
+      return "MPI_Sendrecv";
+    case MpiRoutine::kWait:
+      return "MPI_Wait";
+    case MpiRoutine::kWaitall:
+      return "MPI_Waitall";
+    case MpiRoutine::kProbe:
+      return "MPI_Probe";
+    case MpiRoutine::kBarrier:
+      return "MPI_Barrier";
+    case MpiRoutine::kBcast:
+      return "MPI_Bcast";
+    case MpiRoutine::kReduce:
+      return "MPI_Reduce";
+    case MpiRoutine::kAllreduce:
+      return "MPI_Allreduce";
+    case MpiRoutine::kScan:
+      return "MPI_Scan";
+    case MpiRoutine::kScatter:
+      return "MPI_Scatter";
+    case MpiRoutine::kScatterv:
+      return "MPI_Scatterv";
+    case MpiRoutine::kGather:
+      return "MPI_Gather";
+    case MpiRoutine::kGatherv:
+      return "MPI_Gatherv";
+    case MpiRoutine::kAllgather:
+      return "MPI_Allgather";
+    case MpiRoutine::kAllgatherv:
+      return "MPI_Allgatherv";
+    case MpiRoutine::kAlltoall:
+      return "MPI_Alltoall";
+    case MpiRoutine::kAlltoallv:
+      return "MPI_Alltoallv";
+    case MpiRoutine::kCount:
+    default:
+      return "unknown";
+  }
+}
+
+void MpiProfilerReporter::OnTestStart(const ::testing::TestInfo & /*test_info*/) {
+  MpiProfiler::Reset();
+}
+
+void MpiProfilerReporter::OnTestEnd(const ::testing::TestInfo &test_info) {
+  // Only PMPI_ entry points are used here so the report does not profile itself
+  int rank = 0;
+  int size = 1;
+  PMPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  PMPI_Comm_size(MPI_COMM_WORLD, &size);
+
+  constexpr std::size_t kFields = 3;
+  std::vector<double> local(kNumMpiRoutines * kFields);
+  for (std::size_t i = 0; i < kNumMpiRoutines; i++) {
+    const auto stats = MpiProfiler::Get(static_cast<MpiRoutine>(i));
+    local[(i * kFields) + 0] = static_cast<double>(stats.calls);
+    local[(i * kFields) + 1] = static_cast<double>(stats.bytes);
+    local[(i * kFields) + 2] = stats.time_sec;
+  }
+
+  std::vector<double> all(rank == 0 ? local.size() * static_cast<std::size_t>(size) : 0);
+  PMPI_Gather(local.data(), static_cast<int>(local.size()), MPI_DOUBLE, all.data(), static_cast<int>(local.size()),
+              MPI_DOUBLE, 0, MPI_COMM_WORLD);
+  if (rank != 0) {
+    return;
+  }
+
+  const std::string test_name = std::string(test_info.test_suite_name()) + "." + test_info.name();
+  for (int proc = 0; proc < size; proc++) {
+    for (std::size_t i = 0; i < kNumMpiRoutines; i++) {
+      const std::size_t offset = (static_cast<std::size_t>(proc) * local.size()) + (i * kFields);
+      const auto calls = static_cast<uint64_t>(all[offset + 0]);
+      if (calls == 0) {
+        continue;
+      }
+      std::cout << std::format("{}:mpi_profile:rank={}:{}:calls={},bytes={},time={:.10f}", test_name, proc,
+                               GetMpiRoutineName(static_cast<MpiRoutine>(i)), calls,
+                               static_cast<uint64_t>(all[offset + 1]), all[offset + 2])
+                << '\n';
+    }
+  }
+}
+
+}  // namespace ppc::runners
+
+#ifdef USE_MPI_PROFILER
+
+namespace {
+
+using ppc::runners::MpiProfiler;
+using ppc::runners::MpiRoutine;
+
+uint64_t PayloadBytes(int count, MPI_Datatype datatype) {
+  if (count <= 0 || datatype == MPI_DATATYPE_NULL) {
+    return 0;
+  }
+  int type_size = 0;
+  PMPI_Type_size(datatype, &type_size);
+  return static_cast<uint64_t>(count) * static_cast<uint64_t>(type_size);
+}
+
+uint64_t PayloadBytes(const int *counts, MPI_Comm comm, MPI_Datatype datatype) {
+  int size = 0;
+  PMPI_Comm_size(comm, &size);
+  uint64_t total = 0;
+  for (int i = 0; i < size; i++) {
+    total += PayloadBytes(counts[i], datatype);
+  }
+  return total;
+}
+
+uint64_t CommSize(MPI_Comm comm) {
+  int size = 0;
+  PMPI_Comm_size(comm, &size);
+  return static_cast<uint64_t>(size);
+}
+
+bool IsRoot(int root, MPI_Comm comm) {
+  int rank = 0;
+  PMPI_Comm_rank(comm, &rank);
+  return rank == root;
+}
+
+class ScopedCall {
+ public:
+  ScopedCall(MpiRoutine routine, uint64_t bytes) : routine_(routine), bytes_(bytes), start_(PMPI_Wtime()) {}
+  ~ScopedCall() {
+    MpiProfiler::Record(routine_, bytes_, PMPI_Wtime() - start_);
+  }
+
+  ScopedCall(const ScopedCall &) = delete;
+  ScopedCall &operator=(const ScopedCall &) = delete;
+  ScopedCall(ScopedCall &&) = delete;
+  ScopedCall &operator=(ScopedCall &&) = delete;
+
+ private:
+  MpiRoutine routine_;
+  uint64_t bytes_;
+  double start_;
+};
+
+}  // namespace
+
+// NOLINTBEGIN(readability-identifier-naming,readability-inconsistent-declaration-parameter-name)
+
+int MPI_Send(const void *buf, int count, MPI_Datatype datatype, int dest, int tag, MPI_Comm comm) {
+  const ScopedCall call(MpiRoutine::kSend, PayloadBytes(count, datatype));
+  return PMPI_Send(buf, count, datatype, dest, tag, comm);
+}
+
+int MPI_Ssend(const void *buf, int count, MPI_Datatype datatype, int dest, int tag, MPI_Comm comm) {
+  const ScopedCall call(MpiRoutine::kSsend, PayloadBytes(count, datatype));
+  return PMPI_Ssend(buf, count, datatype, dest, tag, comm);
+}
+
+int MPI_Isend(const void *buf, int count, MPI_Datatype datatype, int dest, int tag, MPI_Comm comm,
+              MPI_Request *request) {
+  const ScopedCall call(MpiRoutine::kIsend, PayloadBytes(count, datatype));
+  return PMPI_Isend(buf, count, datatype, dest, tag, comm, request);
+}
+
+int MPI_Recv(void *buf, int count, MPI_Datatype datatype, int source, int tag, MPI_Comm comm, MPI_Status *status) {
+  const ScopedCall call(MpiRoutine::kRecv, PayloadBytes(count, datatype));
+  return PMPI_Recv(buf, count, datatype, source, tag, comm, status);
+}
+
+int MPI_Irecv(void *buf, int count, MPI_Datatype datatype, int source, int tag, MPI_Comm comm, MPI_Request *request) {
+  const ScopedCall call(MpiRoutine::kIrecv, PayloadBytes(count, datatype));
+  return PMPI_Irecv(buf, count, datatype, source, tag, comm, request);
+}
+
+int MPI_Sendrecv(const void *sendbuf, int sendcount, MPI_Datatype sendtype, int dest, int sendtag, void *recvbuf,
+                 int recvcount, MPI_Datatype recvtype, int source, int recvtag, MPI_Comm comm, MPI_Status *status) {
+  const ScopedCall call(MpiRoutine::kSendrecv,
+                        PayloadBytes(sendcount, sendtype) + PayloadBytes(recvcount, recvtype));
+  return PMPI_Sendrecv(sendbuf, sendcount, sendtype, dest, sendtag, recvbuf, recvcount, recvtype, source, recvtag,
+                       comm, status);
+}
+
+int MPI_Wait(MPI_Request *request, MPI_Status *status) {
+  const ScopedCall call(MpiRoutine::kWait, 0);
+  return PMPI_Wait(request, status);
+}
+
+int MPI_Waitall(int count, MPI_Request array_of_requests[], MPI_Status array_of_statuses[]) {
+  const ScopedCall call(MpiRoutine::kWaitall, 0);
+  return PMPI_Waitall(count, array_of_requests, array_of_statuses);
+}
+
+int MPI_Probe(int source, int tag, MPI_Comm comm, MPI_Status *status) {
+  const ScopedCall call(MpiRoutine::kProbe, 0);
+  return PMPI_Probe(source, tag, comm, status);
+}
+
+int MPI_Barrier(MPI_Comm comm) {
+  const ScopedCall call(MpiRoutine::kBarrier, 0);
+  return PMPI_Barrier(comm);
+}
+
+int MPI_Bcast(void *buffer, int count, MPI_Datatype datatype, int root, MPI_Comm comm) {
+  const ScopedCall call(MpiRoutine::kBcast, PayloadBytes(count, datatype));
+  return PMPI_Bcast(buffer, count, datatype, root, comm);
+}
+
+int MPI_Reduce(const void *sendbuf, void *recvbuf, int count, MPI_Datatype datatype, MPI_Op op, int root,
+               MPI_Comm comm) {
+  const ScopedCall call(MpiRoutine::kReduce, PayloadBytes(count, datatype));
+  return PMPI_Reduce(sendbuf, recvbuf, count, datatype, op, root, comm);
+}
+
+int MPI_Allreduce(const void *sendbuf, void *recvbuf, int count, MPI_Datatype datatype, MPI_Op op, MPI_Comm comm) {
+  const ScopedCall call(MpiRoutine::kAllreduce, PayloadBytes(count, datatype));
+  return PMPI_Allreduce(sendbuf, recvbuf, count, datatype, op, comm);
+}
+
+int MPI_Scan(const void *sendbuf, void *recvbuf, int count, MPI_Datatype datatype, MPI_Op op, MPI_Comm comm) {
+  const ScopedCall call(MpiRoutine::kScan, PayloadBytes(count, datatype));
+  return PMPI_Scan(sendbuf, recvbuf, count, datatype, op, comm);
+}
+
+int MPI_Scatter(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, int recvcount,
+                MPI_Datatype recvtype, int root, MPI_Comm comm) {
+  const uint64_t bytes = IsRoot(root, comm) ? PayloadBytes(sendcount, sendtype) * CommSize(comm)
+                                            : PayloadBytes(recvcount, recvtype);
+  const ScopedCall call(MpiRoutine::kScatter, bytes);
+  return PMPI_Scatter(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype, root, comm);
+}
+
+int MPI_Scatterv(const void *sendbuf, const int sendcounts[], const int displs[], MPI_Datatype sendtype,
+                 void *recvbuf, int recvcount, MPI_Datatype recvtype, int root, MPI_Comm comm) {
+  const uint64_t bytes =
+      IsRoot(root, comm) ? PayloadBytes(sendcounts, comm, sendtype) : PayloadBytes(recvcount, recvtype);
+  const ScopedCall call(MpiRoutine::kScatterv, bytes);
+  return PMPI_Scatterv(sendbuf, sendcounts, displs, sendtype, recvbuf, recvcount, recvtype, root, comm);
+}
+
+int MPI_Gather(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, int recvcount,
+               MPI_Datatype recvtype, int root, MPI_Comm comm) {
+  const uint64_t bytes = IsRoot(root, comm) ? PayloadBytes(recvcount, recvtype) * CommSize(comm)
+                                            : PayloadBytes(sendcount, sendtype);
+  const ScopedCall call(MpiRoutine::kGather, bytes);
+  return PMPI_Gather(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype, root, comm);
+}
+
+int MPI_Gatherv(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, const int recvcounts[],
+                const int displs[], MPI_Datatype recvtype, int root, MPI_Comm comm) {
+  const uint64_t bytes =
+      IsRoot(root, comm) ? PayloadBytes(recvcounts, comm, recvtype) : PayloadBytes(sendcount, sendtype);
+  const ScopedCall call(MpiRoutine::kGatherv, bytes);
+  return PMPI_Gatherv(sendbuf, sendcount, sendtype, recvbuf, recvcounts, displs, recvtype, root, comm);
+}
+
+int MPI_Allgather(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, int recvcount,
+                  MPI_Datatype recvtype, MPI_Comm comm) {
+  const ScopedCall call(MpiRoutine::kAllgather, PayloadBytes(recvcount, recvtype) * CommSize(comm));
+  return PMPI_Allgather(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype, comm);
+}
+
+int MPI_Allgatherv(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, const int recvcounts[],
+                   const int displs[], MPI_Datatype recvtype, MPI_Comm comm) {
+  const ScopedCall call(MpiRoutine::kAllgatherv, PayloadBytes(recvcounts, comm, recvtype));
+  return PMPI_Allgatherv(sendbuf, sendcount, sendtype, recvbuf, recvcounts, displs, recvtype, comm);
+}
+
+int MPI_Alltoall(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, int recvcount,
+                 MPI_Datatype recvtype, MPI_Comm comm) {
+  const ScopedCall call(MpiRoutine::kAlltoall, PayloadBytes(sendcount, sendtype) * CommSize(comm));
+  return PMPI_Alltoall(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype, comm);
+}
+
+int MPI_Alltoallv(const void *sendbuf, const int sendcounts[], const int sdispls[], MPI_Datatype sendtype,
+                  void *recvbuf, const int recvcounts[], const int rdispls[], MPI_Datatype recvtype, MPI_Comm comm) {
+  const ScopedCall call(MpiRoutine::kAlltoallv, PayloadBytes(sendcounts, comm, sendtype));
+  return PMPI_Alltoallv(sendbuf, sendcounts, sdispls, sendtype, recvbuf, recvcounts, rdispls, recvtype, comm);
+}
+
+// NOLINTEND(readability-identifier-naming,readability-inconsistent-declaration-parameter-name)
+
+#endif  // USE_MPI_PROFILER
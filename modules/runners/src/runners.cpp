@@ -4,6 +4,7 @@
 #include <mpi.h>
 
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <cstdlib>
 #include <exception>
@@ -14,8 +15,15 @@
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <thread>
+#include <vector>
 
 #include "oneapi/tbb/global_control.h"
+#include "runners/include/affinity.hpp"
+#include "runners/include/mpi_profiler.hpp"
+#include "util/include/perf_report.hpp"
+#include "util/include/runtime.hpp"
+#include "util/include/task_groups.hpp"
 #include "util/include/util.hpp"
 
 namespace ppc::runners {
@@ -124,6 +132,110 @@ bool HasFlag(int argc, char **argv, std::string_view flag) {
   return false;
 }
 
+int ToMpiThreadLevel(ppc::util::MpiThreadLevel level) {
+  switch (level) {
+    case ppc::util::MpiThreadLevel::kSingle:
+      return MPI_THREAD_SINGLE;
+    case ppc::util::MpiThreadLevel::kFunneled:
+      return MPI_THREAD_FUNNELED;
+    case ppc::util::MpiThreadLevel::kSerialized:
+      return MPI_THREAD_SERIALIZED;
+    case ppc::util::MpiThreadLevel::kMultiple:
+      return MPI_THREAD_MULTIPLE;
+  }
+  return MPI_THREAD_SINGLE;
+}
+
+ppc::util::MpiThreadLevel FromMpiThreadLevel(int level) {
+  if (level >= MPI_THREAD_MULTIPLE) {
+    return ppc::util::MpiThreadLevel::kMultiple;
+  }
+  if (level >= MPI_THREAD_SERIALIZED) {
+    return ppc::util::MpiThreadLevel::kSerialized;
+  }
+  if (level >= MPI_THREAD_FUNNELED) {
+    return ppc::util::MpiThreadLevel::kFunneled;
+  }
+  return ppc::util::MpiThreadLevel::kSingle;
+}
+
+struct NodeRanks {
+  int local_rank = 0;
+  int local_size = 1;
+};
+
+NodeRanks GetNodeRanks() {
+  int rank = -1;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm node_comm = MPI_COMM_NULL;
+  MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &node_comm);
+  NodeRanks node;
+  MPI_Comm_rank(node_comm, &node.local_rank);
+  MPI_Comm_size(node_comm, &node.local_size);
+  MPI_Comm_free(&node_comm);
+  return node;
+}
+
+int GetNodeCpuCount() {
+  const auto topology = GetCpuTopology();
+  if (!topology.empty()) {
+    return static_cast<int>(topology.size());
+  }
+  return static_cast<int>(std::thread::hardware_concurrency());
+}
+
+// Derives the thread budget of the rank from PPC_NUM_THREADS and the number of ranks sharing the node
+void SetupRankThreading(ppc::util::MpiThreadLevel provided, const NodeRanks &node) {
+  const int num_threads = ppc::util::GetNumThreads();
+  const int node_cpus = GetNodeCpuCount();
+  const int budget = ppc::util::ComputeRankThreadBudget(num_threads, node_cpus, node.local_size);
+  ppc::util::SetRankThreading({.mpi_thread_level = provided, .thread_budget = budget});
+
+  int rank = -1;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  if (rank == 0 && budget < num_threads) {
+    std::cout << std::format("[  THREADS  ] PPC_NUM_THREADS={} capped to {} threads per rank ({} CPUs, {} ranks)",
+                             num_threads, budget, node_cpus, node.local_size)
+              << '\n';
+  }
+}
+
+// Binds the ranks by PPC_BIND and gathers the core map of all ranks on rank 0
+void BindRanks(const NodeRanks &node) {
+  int rank = -1;
+  int world_size = 1;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &world_size);
+  const auto [local_rank, local_size] = node;
+
+  const auto policy = GetBindPolicy();
+  const auto entry = std::format("{}:{}", rank, ApplyBindPolicy(policy, local_rank, local_size));
+
+  int length = static_cast<int>(entry.size());
+  std::vector<int> lengths(static_cast<std::size_t>(world_size));
+  MPI_Gather(&length, 1, MPI_INT, lengths.data(), 1, MPI_INT, 0, MPI_COMM_WORLD);
+  std::vector<int> displs(static_cast<std::size_t>(world_size), 0);
+  for (std::size_t i = 1; i < displs.size(); i++) {
+    displs[i] = displs[i - 1] + lengths[i - 1];
+  }
+  std::string entries(rank == 0 ? static_cast<std::size_t>(displs.back() + lengths.back()) : 0, '\0');
+  MPI_Gatherv(entry.data(), length, MPI_CHAR, entries.data(), lengths.data(), displs.data(), MPI_CHAR, 0,
+              MPI_COMM_WORLD);
+  if (rank != 0) {
+    return;
+  }
+
+  std::string core_map;
+  for (std::size_t i = 0; i < lengths.size(); i++) {
+    core_map += (i == 0 ? "" : ";") + entries.substr(static_cast<std::size_t>(displs[i]),
+                                                     static_cast<std::size_t>(lengths[i]));
+  }
+  if (policy != BindPolicy::kNone) {
+    std::cout << std::format("[  BIND  ] policy={} core_map={}", GetBindPolicyName(policy), core_map) << '\n';
+  }
+  ppc::util::SetProcessBinding({.policy = GetBindPolicyName(policy), .core_map = core_map});
+}
+
 int RunAllTestsSafely() {
   try {
     return RunAllTests();
@@ -140,15 +252,46 @@ int RunAllTestsSafely() {
 }  // namespace
 
 int Init(int argc, char **argv) {
-  const int init_res = MPI_Init(&argc, &argv);
+  auto requested = ppc::util::MpiThreadLevel::kSingle;
+  try {
+    requested = ppc::util::GetMpiThreadLevel();
+  } catch (const std::exception &e) {
+    std::cerr << std::format("[  ERROR  ] {}", e.what()) << '\n';
+    return EXIT_FAILURE;
+  }
+
+  int provided = MPI_THREAD_SINGLE;
+  const int init_res = MPI_Init_thread(&argc, &argv, ToMpiThreadLevel(requested), &provided);
   if (init_res != MPI_SUCCESS) {
-    std::cerr << std::format("[  ERROR  ] MPI_Init failed with code {}", init_res) << '\n';
+    std::cerr << std::format("[  ERROR  ] MPI_Init_thread failed with code {}", init_res) << '\n';
     MPI_Abort(MPI_COMM_WORLD, init_res);
     return init_res;
   }
+  if (provided < ToMpiThreadLevel(requested)) {
+    std::cerr << std::format("[  ERROR  ] MPI provides thread level {}, PPC_MPI_THREAD_LEVEL requires {}",
+                             ppc::util::GetMpiThreadLevelName(FromMpiThreadLevel(provided)),
+                             ppc::util::GetMpiThreadLevelName(requested))
+              << '\n';
+    MPI_Abort(MPI_COMM_WORLD, EXIT_FAILURE);
+    return EXIT_FAILURE;
+  }
+
+  // Bind before any worker thread exists so OpenMP, TBB and STL threads inherit the CPU set
+  try {
+    const auto node = GetNodeRanks();
+    BindRanks(node);
+    SetupRankThreading(FromMpiThreadLevel(provided), node);
+    // Parsed once here, task destructors only read the stored policy
+    ppc::util::Runtime::SetOmpPoolPolicy(ppc::util::GetOmpPoolPolicy());
+    ppc::util::InitTaskGroups();
+  } catch (const std::exception &e) {
+    std::cerr << std::format("[  ERROR  ] {}", e.what()) << '\n';
+    MPI_Abort(MPI_COMM_WORLD, EXIT_FAILURE);
+    return EXIT_FAILURE;
+  }
 
   // Limit the number of threads in TBB
-  tbb::global_control control(tbb::global_control::max_allowed_parallelism, ppc::util::GetNumThreads());
+  tbb::global_control control(tbb::global_control::max_allowed_parallelism, ppc::util::GetRankThreadBudget());
 
   ::testing::InitGoogleTest(&argc, argv);
 
@@ -165,8 +308,13 @@ int Init(int argc, char **argv) {
     listeners.Append(new WorkerTestFailurePrinter(std::shared_ptr<::testing::TestEventListener>(listener)));
   }
   listeners.Append(new UnreadMessagesDetector());
+  if (MpiProfiler::IsEnabled()) {
+    listeners.Append(new MpiProfilerReporter());
+  }
 
   const int status = RunAllTestsSafely();
+  ppc::util::Runtime::Shutdown();
+  ppc::util::FreeTaskGroups();
 
   const int finalize_res = MPI_Finalize();
   if (finalize_res != MPI_SUCCESS) {
@@ -178,11 +326,26 @@ int Init(int argc, char **argv) {
 }
 
 int SimpleInit(int argc, char **argv) {
+  try {
+    // Parsed once here, task destructors only read the stored policy
+    ppc::util::Runtime::SetOmpPoolPolicy(ppc::util::GetOmpPoolPolicy());
+    const auto policy = GetBindPolicy();
+    const auto cpus = ApplyBindPolicy(policy, 0, 1);
+    ppc::util::SetProcessBinding({.policy = GetBindPolicyName(policy), .core_map = "0:" + cpus});
+    ppc::util::SetRankThreading(
+        {.thread_budget = ppc::util::ComputeRankThreadBudget(ppc::util::GetNumThreads(), GetNodeCpuCount(), 1)});
+  } catch (const std::exception &e) {
+    std::cerr << std::format("[  ERROR  ] {}", e.what()) << '\n';
+    return EXIT_FAILURE;
+  }
+
   // Limit the number of threads in TBB
-  tbb::global_control control(tbb::global_control::max_allowed_parallelism, ppc::util::GetNumThreads());
+  tbb::global_control control(tbb::global_control::max_allowed_parallelism, ppc::util::GetRankThreadBudget());
 
   testing::InitGoogleTest(&argc, argv);
-  return RunAllTests();
+  const int status = RunAllTests();
+  ppc::util::Runtime::Shutdown();
+  return status;
 }
 
 }  // namespace ppc::runners
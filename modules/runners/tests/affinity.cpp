@@ -0,0 +1,56 @@
+#include "runners/include/affinity.hpp"
+
+#include <gtest/gtest.h>
+
+#include <libenvpp/detail/environment.hpp>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+// Two sockets with four cores each and two SMT threads per core; siblings are numbered cpu and cpu + 8
+std::vector<ppc::runners::CpuInfo> MakeDualSocketTopology() {
+  std::vector<ppc::runners::CpuInfo> topology;
+  for (int cpu = 0; cpu < 16; cpu++) {
+    const int physical = cpu % 8;
+    topology.push_back({.cpu = cpu, .package = physical / 4, .core = physical % 4, .numa_node = physical / 4});
+  }
+  return topology;
+}
+
+}  // namespace
+
+TEST(Affinity, CompactFillsNeighbouringCores) {
+  const auto topology = MakeDualSocketTopology();
+  using ppc::runners::BindPolicy;
+  EXPECT_EQ(ppc::runners::SelectCpus(BindPolicy::kCompact, topology, 0, 2, 4), (std::vector<int>{0, 1, 8, 9}));
+  EXPECT_EQ(ppc::runners::SelectCpus(BindPolicy::kCompact, topology, 1, 2, 4), (std::vector<int>{2, 3, 10, 11}));
+}
+
+TEST(Affinity, ScatterSpreadsRanksAcrossSockets) {
+  const auto topology = MakeDualSocketTopology();
+  using ppc::runners::BindPolicy;
+  EXPECT_EQ(ppc::runners::SelectCpus(BindPolicy::kScatter, topology, 0, 2, 2), (std::vector<int>{0, 1}));
+  EXPECT_EQ(ppc::runners::SelectCpus(BindPolicy::kScatter, topology, 1, 2, 2), (std::vector<int>{4, 5}));
+  EXPECT_EQ(ppc::runners::SelectCpus(BindPolicy::kScatter, topology, 0, 1, 4), (std::vector<int>{0, 1, 4, 5}));
+}
+
+TEST(Affinity, NumaLocalBindsWholeNode) {
+  const auto topology = MakeDualSocketTopology();
+  const auto cpus = ppc::runners::SelectCpus(ppc::runners::BindPolicy::kNumaLocal, topology, 3, 4, 1);
+  EXPECT_EQ(ppc::runners::FormatCpuList(cpus), "4-7,12-15");
+}
+
+TEST(Affinity, NoneSelectsNothing) {
+  EXPECT_TRUE(ppc::runners::SelectCpus(ppc::runners::BindPolicy::kNone, MakeDualSocketTopology(), 0, 1, 4).empty());
+}
+
+TEST(Affinity, FormatCpuListCompressesRanges) {
+  EXPECT_EQ(ppc::runners::FormatCpuList({0, 1, 2, 3, 8, 10, 11}), "0-3,8,10-11");
+  EXPECT_EQ(ppc::runners::FormatCpuList({}), "");
+}
+
+TEST(Affinity, GetBindPolicyThrowsOnUnknownValue) {
+  env::detail::set_scoped_environment_variable scoped("PPC_BIND", "spread");
+  EXPECT_THROW(ppc::runners::GetBindPolicy(), std::runtime_error);
+}
@@ -0,0 +1,244 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <any>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "task/include/task.hpp"
+#include "util/include/util.hpp"
+
+namespace ppc::task {
+
+/// @brief Timings of one step of a Pipeline, accumulated over all Run() calls of the pipeline.
+struct PipelineStepTimes {
+  /// @brief Task namespace and technology, e.g. "korolev_k_sobel_oprator_mpi".
+  std::string name;
+  /// @brief Stage times of the tasks executed by the step.
+  StageTimes stages;
+  /// @brief Time spent handing the previous output over (adapter call and task construction) in seconds.
+  double handoff_seconds = 0.0;
+  /// @brief Placement of the input the step received in the last run.
+  DataPlacement input_placement = DataPlacement::kRoot;
+};
+
+namespace detail {
+
+template <typename InType, typename OutType>
+std::pair<InType, OutType> TaskIO(const Task<InType, OutType> *);
+
+}  // namespace detail
+
+/// @brief Input type of a task class derived from Task<InType, OutType>.
+template <typename TaskType>
+using TaskInputOf = typename decltype(detail::TaskIO(std::declval<TaskType *>()))::first_type;
+
+/// @brief Output type of a task class derived from Task<InType, OutType>.
+template <typename TaskType>
+using TaskOutputOf = typename decltype(detail::TaskIO(std::declval<TaskType *>()))::second_type;
+
+namespace detail {
+
+class PipelineStepBase {
+ public:
+  PipelineStepBase() = default;
+  virtual ~PipelineStepBase() = default;
+
+  PipelineStepBase(const PipelineStepBase &) = delete;
+  PipelineStepBase &operator=(const PipelineStepBase &) = delete;
+  PipelineStepBase(PipelineStepBase &&) = delete;
+  PipelineStepBase &operator=(PipelineStepBase &&) = delete;
+
+  /// @brief Runs the whole pipeline of the step's task on data and replaces data with the task output.
+  /// @param data Previous output, or a reference_wrapper to the pipeline input for the first step.
+  /// @param placement Placement of data; updated to the placement of the task output.
+  /// @return False if a stage of the task failed.
+  virtual bool Run(std::any &data, MPI_Comm comm, StateOfTesting state, DataPlacement &placement) = 0;
+
+  [[nodiscard]] virtual TypeOfTask GetTypeOfTask() const = 0;
+
+  [[nodiscard]] const PipelineStepTimes &GetTimes() const {
+    return times_;
+  }
+
+ protected:
+  PipelineStepTimes times_;
+};
+
+template <typename TaskType, typename StepIn, typename Adapter>
+class PipelineStep final : public PipelineStepBase {
+ public:
+  explicit PipelineStep(Adapter adapter) : adapter_(std::move(adapter)) {
+    times_.name = ppc::util::GetNamespace<TaskType>() + "_" + TypeOfTaskToString(TaskType::GetStaticTypeOfTask());
+  }
+
+  bool Run(std::any &data, MPI_Comm comm, StateOfTesting state, DataPlacement &placement) override {
+    if (auto *value = std::any_cast<StepIn>(&data)) {
+      return RunTask(std::move(*value), data, comm, state, placement);
+    }
+    const StepIn &input = std::any_cast<std::reference_wrapper<const StepIn>>(data).get();
+    if constexpr (std::is_invocable_v<Adapter &, const StepIn &>) {
+      return RunTask(input, data, comm, state, placement);
+    } else {
+      StepIn copy = input;
+      return RunTask(std::move(copy), data, comm, state, placement);
+    }
+  }
+
+  [[nodiscard]] TypeOfTask GetTypeOfTask() const override {
+    return TaskType::GetStaticTypeOfTask();
+  }
+
+ private:
+  template <typename Value>
+  bool RunTask(Value &&value, std::any &data, MPI_Comm comm, StateOfTesting state, DataPlacement &placement) {
+    const auto begin = std::chrono::high_resolution_clock::now();
+    TaskType task(std::invoke(adapter_, std::forward<Value>(value)));
+    task.SetCommunicator(comm);
+    task.SetInputPlacement(placement);
+    task.GetStateOfTesting() = state;
+    const auto handoff =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - begin);
+    times_.handoff_seconds += static_cast<double>(handoff.count()) * 1e-9;
+    times_.input_placement = placement;
+
+    const bool ok = task.Validation() && task.PreProcessing() && task.Run() && task.PostProcessing();
+    const auto &stage_times = task.GetStageTimes();
+    for (std::size_t i = 0; i < kNumTaskStages; i++) {
+      times_.stages.seconds[i] += stage_times.seconds[i];
+      times_.stages.calls[i] += stage_times.calls[i];
+    }
+    if (!ok) {
+      task.Abandon();
+      return false;
+    }
+    placement = task.GetOutputPlacement();
+    data = std::move(task.GetOutput());
+    return true;
+  }
+
+  Adapter adapter_;
+};
+
+/// @brief Technology of a chain of tasks: SEQ steps take the technology of the others, different parallel
+///        technologies make a hybrid (kALL) chain.
+inline TypeOfTask CombineTypesOfTask(TypeOfTask chain, TypeOfTask step) {
+  if (chain == step || step == TypeOfTask::kSEQ) {
+    return chain;
+  }
+  if (chain == TypeOfTask::kSEQ) {
+    return step;
+  }
+  if (chain == TypeOfTask::kUnknown || step == TypeOfTask::kUnknown) {
+    return TypeOfTask::kUnknown;
+  }
+  return TypeOfTask::kALL;
+}
+
+}  // namespace detail
+
+/// @brief Task composed of a chain of tasks where the output of every step is the input of the next one.
+/// @details Intermediate outputs are moved, never copied, into the next step, and every step runs on the
+///          pipeline's communicator. When a step leaves its output on every rank (DataPlacement::kReplicated),
+///          the next task is told so through SetInputPlacement() and may take its part of the data locally
+///          instead of scattering it from rank 0 again. Build pipelines with PipelineBuilder.
+template <typename InType, typename OutType>
+class Pipeline : public Task<InType, OutType> {
+ public:
+  /// @details The type of the pipeline follows from its steps (see detail::CombineTypesOfTask()), so an MPI step
+  ///          makes the whole pipeline an MPI task, e.g. for the RunAsync() restrictions.
+  Pipeline(InType in, std::vector<std::unique_ptr<detail::PipelineStepBase>> steps) : steps_(std::move(steps)) {
+    TypeOfTask type = TypeOfTask::kSEQ;
+    for (const auto &step : steps_) {
+      type = detail::CombineTypesOfTask(type, step->GetTypeOfTask());
+    }
+    this->SetTypeOfTask(type);
+    this->GetInput() = std::move(in);
+  }
+
+  /// @brief Returns the timings of every step in pipeline order.
+  [[nodiscard]] std::vector<PipelineStepTimes> GetStepTimes() const {
+    std::vector<PipelineStepTimes> times;
+    times.reserve(steps_.size());
+    for (const auto &step : steps_) {
+      times.push_back(step->GetTimes());
+    }
+    return times;
+  }
+
+ protected:
+  bool ValidationImpl() override {
+    return !steps_.empty();
+  }
+
+  bool PreProcessingImpl() override {
+    return true;
+  }
+
+  bool RunImpl() override {
+    // The first step reads the pipeline input by reference, so repeated runs see the same input
+    std::any data = std::cref(this->GetInput());
+    DataPlacement placement = this->GetInputPlacement();
+    for (auto &step : steps_) {
+      if (!step->Run(data, this->GetCommunicator(), this->GetStateOfTesting(), placement)) {
+        return false;
+      }
+    }
+    this->GetOutput() = std::move(std::any_cast<OutType &>(data));
+    this->SetOutputPlacement(placement);
+    return true;
+  }
+
+  bool PostProcessingImpl() override {
+    return true;
+  }
+
+ private:
+  std::vector<std::unique_ptr<detail::PipelineStepBase>> steps_;
+};
+
+/// @brief Assembles a Pipeline step by step with compile-time checked types.
+/// @details Example:
+/// @code
+/// auto pipeline = ppc::task::PipelineBuilder<gauss::InType>()
+///                     .Then<gauss::GaussMPI>()
+///                     .Then<sobel::SobelMPI>(ToSobelImage)
+///                     .Then<contrast::ContrastMPI>()
+///                     .Build(image);
+/// @endcode
+/// @tparam InType Input of the pipeline.
+/// @tparam OutType Output of the last step added so far.
+template <typename InType, typename OutType = InType>
+class PipelineBuilder {
+ public:
+  /// @brief Appends TaskType; adapter converts the current output into the task input (identity by default).
+  template <typename TaskType, typename Adapter = std::identity>
+  PipelineBuilder<InType, TaskOutputOf<TaskType>> Then(Adapter adapter = {}) && {
+    static_assert(std::is_constructible_v<TaskType, std::invoke_result_t<Adapter &, OutType &&>>,
+                  "The task cannot be constructed from the previous output; pass an adapter");
+    PipelineBuilder<InType, TaskOutputOf<TaskType>> next;
+    next.steps_ = std::move(steps_);
+    next.steps_.push_back(std::make_unique<detail::PipelineStep<TaskType, OutType, Adapter>>(std::move(adapter)));
+    return next;
+  }
+
+  /// @brief Creates the pipeline task owning the input.
+  std::shared_ptr<Pipeline<InType, OutType>> Build(InType in) && {
+    return std::make_shared<Pipeline<InType, OutType>>(std::move(in), std::move(steps_));
+  }
+
+ private:
+  template <typename, typename>
+  friend class PipelineBuilder;
+
+  std::vector<std::unique_ptr<detail::PipelineStepBase>> steps_;
+};
+
+}  // namespace ppc::task
@@ -1,20 +1,27 @@
 #pragma once
 
+#include <mpi.h>
 #include <omp.h>
 
+#include <algorithm>
 #include <array>
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <cstdlib>
 #include <fstream>
+#include <future>
 #include <iomanip>
 #include <iostream>
 #include <memory>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <util/include/alloc_tracker.hpp>
+#include <util/include/runtime.hpp>
 #include <util/include/util.hpp>
 #include <utility>
+#include <vector>
 
 namespace ppc::task {
 
@@ -98,64 +105,123 @@ inline std::string GetStringTaskType(TypeOfTask type_of_task, const std::string
 
 enum class StateOfTesting : uint8_t { kFunc, kPerf };
 
+/// @brief Pipeline stages whose execution time is tracked by every task.
+enum class TaskStage : uint8_t {
+  /// Validation()
+  kValidation,
+  /// PreProcessing()
+  kPreProcessing,
+  /// Run()
+  kRun,
+  /// PostProcessing()
+  kPostProcessing,
+  /// Number of stages
+  kCount
+};
+
+inline constexpr std::size_t kNumTaskStages = static_cast<std::size_t>(TaskStage::kCount);
+
+/// @brief Returns a short string name of the stage (e.g., "pre_processing").
+inline std::string GetTaskStageName(TaskStage stage) {
+  constexpr std::array<const char *, kNumTaskStages> kNames = {"validation", "pre_processing", "run",
+                                                               "post_processing"};
+  const auto index = static_cast<std::size_t>(stage);
+  return index < kNumTaskStages ? kNames[index] : "unknown";
+}
+
+/// @brief Wall-clock time and number of calls of every pipeline stage.
+struct StageTimes {
+  /// @brief Accumulated time per stage in seconds, indexed by TaskStage.
+  std::array<double, kNumTaskStages> seconds{};
+  /// @brief Number of calls per stage, indexed by TaskStage.
+  std::array<uint64_t, kNumTaskStages> calls{};
+
+  [[nodiscard]] double Get(TaskStage stage) const {
+    return seconds[static_cast<std::size_t>(stage)];
+  }
+};
+
+/// @brief Where the input or output of an MPI task lives across the ranks of its communicator.
+enum class DataPlacement : uint8_t {
+  /// Complete only on rank 0 (other ranks may hold anything)
+  kRoot,
+  /// Every rank holds the complete data
+  kReplicated
+};
+
+/// @brief Heap statistics of every pipeline stage, indexed by TaskStage (zeros without USE_ALLOC_TRACKER).
+using StageAllocations = std::array<ppc::util::AllocStats, kNumTaskStages>;
+
 template <typename InType, typename OutType>
 /// @brief Base abstract class representing a generic task with a defined pipeline.
 /// @tparam InType Input data type.
 /// @tparam OutType Output data type.
-class Task {
+class Task : public std::enable_shared_from_this<Task<InType, OutType>> {
  public:
   /// @brief Validates input data and task attributes before execution.
   /// @return True if validation is successful.
   virtual bool Validation() final {
-    if (stage_ == PipelineStage::kNone || stage_ == PipelineStage::kDone) {
-      stage_ = PipelineStage::kValidation;
-    } else {
-      stage_ = PipelineStage::kException;
-      throw std::runtime_error("Validation should be called before preprocessing");
-    }
-    return ValidationImpl();
+    WaitAsyncStage();
+    return ValidationStage();
   }
 
   /// @brief Performs preprocessing on the input data.
   /// @return True if preprocessing is successful.
   virtual bool PreProcessing() final {
-    if (stage_ == PipelineStage::kValidation) {
-      stage_ = PipelineStage::kPreProcessing;
-    } else {
-      stage_ = PipelineStage::kException;
-      throw std::runtime_error("Preprocessing should be called after validation");
-    }
-    if (state_of_testing_ == StateOfTesting::kFunc) {
-      InternalTimeTest();
-    }
-    return PreProcessingImpl();
+    WaitAsyncStage();
+    return PreProcessingStage();
   }
 
   /// @brief Executes the main logic of the task.
   /// @return True if execution is successful.
   virtual bool Run() final {
-    if (stage_ == PipelineStage::kPreProcessing || stage_ == PipelineStage::kRun) {
-      stage_ = PipelineStage::kRun;
-    } else {
-      stage_ = PipelineStage::kException;
-      throw std::runtime_error("Run should be called after preprocessing");
-    }
-    return RunImpl();
+    WaitAsyncStage();
+    return RunStage();
   }
 
   /// @brief Performs postprocessing on the output data.
   /// @return True if postprocessing is successful.
   virtual bool PostProcessing() final {
-    if (stage_ == PipelineStage::kRun) {
-      stage_ = PipelineStage::kDone;
-    } else {
+    WaitAsyncStage();
+    return PostProcessingStage();
+  }
+
+  /// @brief Starts Run() on the framework thread pool (see ppc::util::Runtime::GetThreadPool()).
+  /// @details The stage order is checked before returning. Any later stage call and the destructor wait for the
+  ///          asynchronous run to finish. A task owned by a std::shared_ptr is kept alive by the running job;
+  ///          otherwise the caller must keep it alive until the handle is ready.
+  /// @return Handle whose get() returns the result of Run() or rethrows its exception.
+  /// @throws std::runtime_error If Run() may not be called in the current stage, or if the task is an MPI or hybrid
+  ///         task and MPI does not provide MPI_THREAD_MULTIPLE (a pool worker would make the MPI calls).
+  std::shared_future<bool> RunAsync() {
+    WaitAsyncStage();
+    CheckAsyncMpiCalls("RunAsync");
+    EnterRun();
+    return StartAsyncStage([this] { return TimeStage(TaskStage::kRun, [this] { return RunImpl(); }); });
+  }
+
+  /// @brief Starts the whole pipeline (Validation() to PostProcessing()) on the framework thread pool.
+  /// @details Stops at the first stage returning false. Ordering and lifetime rules are the same as for RunAsync().
+  /// @return Handle whose get() returns true if every stage succeeded.
+  /// @throws std::runtime_error If the pipeline of the task is in progress, or under the MPI restriction of
+  ///         RunAsync().
+  std::shared_future<bool> PipelineAsync() {
+    WaitAsyncStage();
+    CheckAsyncMpiCalls("PipelineAsync");
+    if (stage_ != PipelineStage::kNone && stage_ != PipelineStage::kDone) {
       stage_ = PipelineStage::kException;
-      throw std::runtime_error("Postprocessing should be called after run");
+      throw std::runtime_error("PipelineAsync should be called before validation or after postprocessing");
     }
-    if (state_of_testing_ == StateOfTesting::kFunc) {
-      InternalTimeTest();
-    }
-    return PostProcessingImpl();
+    return StartAsyncStage(
+        [this] { return ValidationStage() && PreProcessingStage() && RunStage() && PostProcessingStage(); });
+  }
+
+  /// @brief Gives up the pipeline after a stage returned false, so the task can be destroyed without the
+  ///        incomplete-pipeline check firing; a new pipeline may start with Validation().
+  /// @details For owners that drive inner tasks themselves and stop at the first failure (BatchTask, Pipeline).
+  void Abandon() {
+    WaitAsyncStage();
+    stage_ = PipelineStage::kDone;
   }
 
   /// @brief Returns the current testing mode.
@@ -176,6 +242,47 @@ class Task {
     return type_of_task_;
   }
 
+  /// @brief Sets the communicator the task runs on (MPI_COMM_WORLD by default).
+  /// @details Injected by the test harness before Validation(); see PPC_TASK_GROUPS.
+  /// @throws std::runtime_error If the pipeline has already started.
+  void SetCommunicator(MPI_Comm comm) {
+    if (stage_ != PipelineStage::kNone || async_stage_.valid()) {
+      throw std::runtime_error("SetCommunicator should be called before validation");
+    }
+    comm_ = comm;
+  }
+
+  /// @brief Returns the communicator MPI implementations must use instead of MPI_COMM_WORLD.
+  [[nodiscard]] MPI_Comm GetCommunicator() const {
+    return comm_;
+  }
+
+  /// @brief Declares where the input is available; kReplicated lets MPI implementations slice their part of the
+  ///        input locally instead of scattering it from rank 0.
+  /// @details Set by ppc::task::Pipeline when the previous stage left its output on every rank.
+  /// @throws std::runtime_error If the pipeline has already started.
+  void SetInputPlacement(DataPlacement placement) {
+    if (stage_ != PipelineStage::kNone || async_stage_.valid()) {
+      throw std::runtime_error("SetInputPlacement should be called before validation");
+    }
+    input_placement_ = placement;
+  }
+
+  [[nodiscard]] DataPlacement GetInputPlacement() const {
+    return input_placement_;
+  }
+
+  /// @brief Returns where the output was left by the last Run() (kRoot unless the task declared otherwise).
+  [[nodiscard]] DataPlacement GetOutputPlacement() const {
+    return output_placement_;
+  }
+
+  /// @brief Tells the harness whether the task communicates only through GetCommunicator().
+  /// @details Only such tasks are split into rank groups; others always run on MPI_COMM_WORLD.
+  [[nodiscard]] virtual bool SupportsCommunicator() const {
+    return false;
+  }
+
   /// @brief Returns the current task status.
   /// @return Task status (enabled or disabled).
   [[nodiscard]] StatusOfTask GetStatusOfTask() const {
@@ -200,15 +307,33 @@ class Task {
     return output_;
   }
 
-  /// @brief Destructor. Verifies that the pipeline was executed in the correct order.
+  /// @brief Returns the time spent in every pipeline stage since construction or the last ResetStageTimes().
+  /// @details Each call of a stage is timed, including its user-defined implementation only.
+  [[nodiscard]] const StageTimes &GetStageTimes() const {
+    return stage_times_;
+  }
+
+  /// @brief Returns bytes and number of allocations accumulated per stage since construction or the last
+  ///        ResetStageTimes(), with the largest heap and RSS high-water marks of any call.
+  [[nodiscard]] const StageAllocations &GetStageAllocations() const {
+    return stage_allocations_;
+  }
+
+  /// @brief Clears the accumulated stage times and allocation statistics.
+  void ResetStageTimes() {
+    stage_times_ = {};
+    stage_allocations_ = {};
+  }
+
+  /// @brief Destructor. Verifies that the pipeline was executed in the correct order and applies the
+  ///        OpenMP pool policy (see PPC_OMP_POOL).
   /// @note Terminates the program if the pipeline order is incorrect or incomplete.
   virtual ~Task() {
+    WaitAsyncStage();
     if (stage_ != PipelineStage::kDone && stage_ != PipelineStage::kException) {
       ppc::util::DestructorFailureFlag::Set();
     }
-#if _OPENMP >= 201811
-    omp_pause_resource_all(omp_pause_soft);
-#endif
+    ppc::util::Runtime::ReleaseTaskResources();
   }
 
  protected:
@@ -238,6 +363,11 @@ class Task {
     }
   }
 
+  /// @brief Declares where RunImpl() leaves the output, e.g. kReplicated after a final broadcast.
+  void SetOutputPlacement(DataPlacement placement) {
+    output_placement_ = placement;
+  }
+
   /// @brief User-defined validation logic.
   /// @return True if validation is successful.
   virtual bool ValidationImpl() = 0;
@@ -255,12 +385,125 @@ class Task {
   virtual bool PostProcessingImpl() = 0;
 
  private:
+  bool ValidationStage() {
+    if (stage_ == PipelineStage::kNone || stage_ == PipelineStage::kDone) {
+      stage_ = PipelineStage::kValidation;
+    } else {
+      stage_ = PipelineStage::kException;
+      throw std::runtime_error("Validation should be called before preprocessing");
+    }
+    return TimeStage(TaskStage::kValidation, [this] { return ValidationImpl(); });
+  }
+
+  bool PreProcessingStage() {
+    if (stage_ == PipelineStage::kValidation) {
+      stage_ = PipelineStage::kPreProcessing;
+    } else {
+      stage_ = PipelineStage::kException;
+      throw std::runtime_error("Preprocessing should be called after validation");
+    }
+    if (state_of_testing_ == StateOfTesting::kFunc) {
+      InternalTimeTest();
+    }
+    return TimeStage(TaskStage::kPreProcessing, [this] { return PreProcessingImpl(); });
+  }
+
+  void EnterRun() {
+    if (stage_ == PipelineStage::kPreProcessing || stage_ == PipelineStage::kRun) {
+      stage_ = PipelineStage::kRun;
+    } else {
+      stage_ = PipelineStage::kException;
+      throw std::runtime_error("Run should be called after preprocessing");
+    }
+  }
+
+  bool RunStage() {
+    EnterRun();
+    return TimeStage(TaskStage::kRun, [this] { return RunImpl(); });
+  }
+
+  bool PostProcessingStage() {
+    if (stage_ == PipelineStage::kRun) {
+      stage_ = PipelineStage::kDone;
+    } else {
+      stage_ = PipelineStage::kException;
+      throw std::runtime_error("Postprocessing should be called after run");
+    }
+    if (state_of_testing_ == StateOfTesting::kFunc) {
+      InternalTimeTest();
+    }
+    return TimeStage(TaskStage::kPostProcessing, [this] { return PostProcessingImpl(); });
+  }
+
+  /// @brief Rejects running an MPI or hybrid task on a pool worker unless MPI allows any thread to call it.
+  /// @details The stage is left untouched, so the task can still run synchronously.
+  void CheckAsyncMpiCalls(const char *caller) const {
+    if (type_of_task_ != TypeOfTask::kMPI && type_of_task_ != TypeOfTask::kALL) {
+      return;
+    }
+    const auto level = ppc::util::GetRankThreading().mpi_thread_level;
+    if (level != ppc::util::MpiThreadLevel::kMultiple) {
+      throw std::runtime_error(std::string(caller) + " of an " + TypeOfTaskToString(type_of_task_) +
+                               " task needs MPI_THREAD_MULTIPLE, MPI provides " +
+                               ppc::util::GetMpiThreadLevelName(level));
+    }
+  }
+
+  /// @brief Submits the job to the framework pool; the job holds a reference to the task if it is shared.
+  template <typename Job>
+  std::shared_future<bool> StartAsyncStage(Job job) {
+    auto keep_alive = this->weak_from_this().lock();
+    async_stage_ = ppc::util::Runtime::GetThreadPool()
+                       .Submit([job = std::move(job), keep_alive = std::move(keep_alive)] {
+                         const ppc::util::AsyncStageScope in_flight;
+                         return job();
+                       })
+                       .share();
+    return async_stage_;
+  }
+
+  /// @brief Waits for the asynchronous stage in flight, if any; the calling thread helps the pool meanwhile.
+  void WaitAsyncStage() {
+    if (!async_stage_.valid()) {
+      return;
+    }
+    ppc::util::Runtime::GetThreadPool().Wait(async_stage_);
+    async_stage_ = {};
+  }
+
+  /// @brief Runs a stage implementation and accounts its execution time to the stage.
+  template <typename Impl>
+  bool TimeStage(TaskStage stage, Impl &&impl) {
+    ppc::util::AllocScope alloc_scope;
+    const auto begin = std::chrono::high_resolution_clock::now();
+    const bool result = std::forward<Impl>(impl)();
+    const auto duration =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - begin);
+    const auto alloc = alloc_scope.Stop();
+
+    const auto index = static_cast<std::size_t>(stage);
+    stage_times_.seconds[index] += static_cast<double>(duration.count()) * 1e-9;
+    stage_times_.calls[index]++;
+    auto &stage_alloc = stage_allocations_[index];
+    stage_alloc.bytes += alloc.bytes;
+    stage_alloc.allocations += alloc.allocations;
+    stage_alloc.peak_heap_bytes = std::max(stage_alloc.peak_heap_bytes, alloc.peak_heap_bytes);
+    stage_alloc.process_peak_rss_kb = std::max(stage_alloc.process_peak_rss_kb, alloc.process_peak_rss_kb);
+    return result;
+  }
+
   InType input_{};
   OutType output_{};
+  MPI_Comm comm_ = MPI_COMM_WORLD;
+  DataPlacement input_placement_ = DataPlacement::kRoot;
+  DataPlacement output_placement_ = DataPlacement::kRoot;
   StateOfTesting state_of_testing_ = StateOfTesting::kFunc;
   TypeOfTask type_of_task_ = TypeOfTask::kUnknown;
   StatusOfTask status_of_task_ = StatusOfTask::kEnabled;
   std::chrono::high_resolution_clock::time_point tmp_time_point_;
+  StageTimes stage_times_;
+  StageAllocations stage_allocations_{};
+  std::shared_future<bool> async_stage_;
   enum class PipelineStage : uint8_t {
     kNone,
     kValidation,
@@ -277,14 +520,81 @@ class Task {
 template <typename InType, typename OutType>
 using TaskPtr = std::shared_ptr<Task<InType, OutType>>;
 
+/// @brief Task over a batch of independent inputs of a single-input task type.
+/// @details The default RunImpl() runs the whole pipeline of TaskType for every input in turn. Implementations
+///          that can amortize their per-run overhead (e.g., pack all inputs into one scatter and one reduction)
+///          derive from it, override RunImpl() and publish themselves as TaskType::BatchTask.
+/// @tparam TaskType Single-input task.
+template <typename TaskType, typename InType, typename OutType>
+class BatchTask : public Task<std::vector<InType>, std::vector<OutType>> {
+ public:
+  static constexpr TypeOfTask GetStaticTypeOfTask() {
+    return TaskType::GetStaticTypeOfTask();
+  }
+
+  explicit BatchTask(std::vector<InType> inputs) {
+    this->SetTypeOfTask(GetStaticTypeOfTask());
+    this->GetInput() = std::move(inputs);
+  }
+
+ protected:
+  bool ValidationImpl() override {
+    return !this->GetInput().empty();
+  }
+
+  bool PreProcessingImpl() override {
+    this->GetOutput().assign(this->GetInput().size(), OutType{});
+    return true;
+  }
+
+  bool RunImpl() override {
+    const auto &inputs = this->GetInput();
+    for (std::size_t i = 0; i < inputs.size(); i++) {
+      TaskType task(inputs[i]);
+      task.SetCommunicator(this->GetCommunicator());
+      task.GetStateOfTesting() = this->GetStateOfTesting();
+      if (!task.Validation() || !task.PreProcessing() || !task.Run() || !task.PostProcessing()) {
+        task.Abandon();
+        return false;
+      }
+      this->GetOutput()[i] = std::move(task.GetOutput());
+    }
+    return true;
+  }
+
+  bool PostProcessingImpl() override {
+    return true;
+  }
+};
+
+/// @brief Batched implementation of TaskType: TaskType::BatchTask if the task provides one, otherwise the
+///        one-by-one BatchTask.
+template <typename TaskType, typename InType, typename OutType>
+struct BatchTaskOf {
+  using Type = BatchTask<TaskType, InType, OutType>;
+};
+
+template <typename TaskType, typename InType, typename OutType>
+  requires requires { typename TaskType::BatchTask; }
+struct BatchTaskOf<TaskType, InType, OutType> {
+  using Type = typename TaskType::BatchTask;
+};
+
+/// @brief Read-only input shared between tasks without copying; use it as InType for large inputs that several
+///        tasks (or repeated measurements) read but never modify.
+template <typename T>
+using SharedInput = std::shared_ptr<const T>;
+
 /// @brief Constructs and returns a shared pointer to a task with the given input.
+/// @details The input is moved into the constructor, so a task taking InType by value (and moving it into
+///          GetInput()) receives the test data without a copy; a constructor taking const InType & copies once.
 /// @tparam TaskType Type of the task to create.
 /// @tparam InType Type of the input.
 /// @param in Input to pass to the task constructor.
 /// @return Shared a pointer to the newly created task.
 template <typename TaskType, typename InType>
-std::shared_ptr<TaskType> TaskGetter(const InType &in) {
-  return std::make_shared<TaskType>(in);
+std::shared_ptr<TaskType> TaskGetter(InType in) {
+  return std::make_shared<TaskType>(std::move(in));
 }
 
 }  // namespace ppc::task
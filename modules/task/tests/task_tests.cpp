@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include <mpi.h>
 
 #include <chrono>
 #include <cstddef>
@@ -6,6 +7,7 @@
 #include <exception>
 #include <filesystem>
 #include <fstream>
+#include <future>
 #include <libenvpp/env.hpp>
 #include <memory>
 #include <stdexcept>
@@ -16,8 +18,10 @@
 #include <vector>
 
 #include "runners/include/runners.hpp"
+#include "task/include/pipeline.hpp"
 #include "task/include/task.hpp"
 #include "util/include/util.hpp"
+#include "util/tests/mpi_environment.hpp"
 
 using ppc::task::StatusOfTask;
 using ppc::task::Task;
@@ -307,6 +311,449 @@ TEST(TaskTest, PostProcessingThrowsIfCalledBeforeRun) {
   EXPECT_THROW(task->PostProcessing(), std::runtime_error);
 }
 
+TEST(TaskTest, StageTimesAreAccumulatedPerCall) {
+  env::detail::set_scoped_environment_variable scoped("PPC_TASK_MAX_TIME", "3");
+  std::vector<int32_t> in(20, 1);
+  ppc::test::FakeSlowTask<std::vector<int32_t>, int32_t> test_task(in);
+  test_task.Validation();
+  test_task.PreProcessing();
+  test_task.Run();
+  test_task.PostProcessing();
+
+  const auto &stages = test_task.GetStageTimes();
+  for (std::size_t i = 0; i < ppc::task::kNumTaskStages; i++) {
+    EXPECT_EQ(stages.calls[i], 1U);
+  }
+  EXPECT_GE(stages.Get(ppc::task::TaskStage::kRun), 2.0);
+  EXPECT_LT(stages.Get(ppc::task::TaskStage::kValidation), 1.0);
+
+  test_task.ResetStageTimes();
+  EXPECT_EQ(test_task.GetStageTimes().calls[static_cast<std::size_t>(ppc::task::TaskStage::kRun)], 0U);
+  EXPECT_DOUBLE_EQ(test_task.GetStageTimes().Get(ppc::task::TaskStage::kRun), 0.0);
+}
+
+TEST(TaskTest, GetTaskStageNameReturnsShortNames) {
+  EXPECT_EQ(ppc::task::GetTaskStageName(ppc::task::TaskStage::kPreProcessing), "pre_processing");
+  EXPECT_EQ(ppc::task::GetTaskStageName(ppc::task::TaskStage::kCount), "unknown");
+}
+
+namespace {
+
+class MoveInTask : public ppc::task::Task<std::vector<int32_t>, int32_t> {
+ public:
+  explicit MoveInTask(std::vector<int32_t> in) {
+    GetInput() = std::move(in);
+  }
+
+  bool ValidationImpl() override {
+    return true;
+  }
+  bool PreProcessingImpl() override {
+    return true;
+  }
+  bool RunImpl() override {
+    return true;
+  }
+  bool PostProcessingImpl() override {
+    return true;
+  }
+};
+
+using SharedVector = ppc::task::SharedInput<std::vector<int32_t>>;
+
+class SharedInputTask : public ppc::task::Task<SharedVector, int32_t> {
+ public:
+  explicit SharedInputTask(const SharedVector &in) {
+    GetInput() = in;
+  }
+
+  bool ValidationImpl() override {
+    return GetInput() != nullptr;
+  }
+  bool PreProcessingImpl() override {
+    GetOutput() = 0;
+    return true;
+  }
+  bool RunImpl() override {
+    for (int32_t value : *GetInput()) {
+      GetOutput() += value;
+    }
+    return true;
+  }
+  bool PostProcessingImpl() override {
+    return true;
+  }
+};
+
+class SumTask : public ppc::task::Task<std::vector<int32_t>, int32_t> {
+ public:
+  static constexpr TypeOfTask GetStaticTypeOfTask() {
+    return TypeOfTask::kSEQ;
+  }
+
+  explicit SumTask(const std::vector<int32_t> &in) {
+    SetTypeOfTask(GetStaticTypeOfTask());
+    GetInput() = in;
+  }
+
+  bool ValidationImpl() override {
+    return !GetInput().empty();
+  }
+  bool PreProcessingImpl() override {
+    GetOutput() = 0;
+    return true;
+  }
+  bool RunImpl() override {
+    for (int32_t value : GetInput()) {
+      GetOutput() += value;
+    }
+    return true;
+  }
+  bool PostProcessingImpl() override {
+    return true;
+  }
+};
+
+using SumBatchTask = ppc::task::BatchTaskOf<SumTask, std::vector<int32_t>, int32_t>::Type;
+
+class MpiSumTask : public SumTask {
+ public:
+  static constexpr TypeOfTask GetStaticTypeOfTask() {
+    return TypeOfTask::kMPI;
+  }
+
+  explicit MpiSumTask(const std::vector<int32_t> &in) : SumTask(in) {
+    SetTypeOfTask(GetStaticTypeOfTask());
+  }
+};
+
+class RepeatTask : public ppc::task::Task<int32_t, std::vector<int32_t>> {
+ public:
+  static constexpr TypeOfTask GetStaticTypeOfTask() {
+    return TypeOfTask::kSEQ;
+  }
+
+  explicit RepeatTask(int32_t in) {
+    SetTypeOfTask(GetStaticTypeOfTask());
+    GetInput() = in;
+  }
+
+  bool ValidationImpl() override {
+    return true;
+  }
+  bool PreProcessingImpl() override {
+    return true;
+  }
+  bool RunImpl() override {
+    GetOutput().assign(3, GetInput());
+    // Every rank computed the same output
+    SetOutputPlacement(ppc::task::DataPlacement::kReplicated);
+    return true;
+  }
+  bool PostProcessingImpl() override {
+    return true;
+  }
+};
+
+/// @brief MPI task in the style of the example tasks: the root broadcasts the vector, every rank sums a strided
+///        share of it and the shares are reduced onto every rank of the task communicator.
+class DistributedSumTask : public ppc::task::Task<std::vector<int32_t>, int32_t> {
+ public:
+  static constexpr TypeOfTask GetStaticTypeOfTask() {
+    return TypeOfTask::kMPI;
+  }
+
+  explicit DistributedSumTask(const std::vector<int32_t> &in) {
+    SetTypeOfTask(GetStaticTypeOfTask());
+    GetInput() = in;
+  }
+
+  bool ValidationImpl() override {
+    int size = static_cast<int>(GetInput().size());
+    MPI_Bcast(&size, 1, MPI_INT, 0, GetCommunicator());
+    return size > 0;
+  }
+  bool PreProcessingImpl() override {
+    GetOutput() = 0;
+    return true;
+  }
+  bool RunImpl() override {
+    int rank = 0;
+    int ranks = 1;
+    MPI_Comm_rank(GetCommunicator(), &rank);
+    MPI_Comm_size(GetCommunicator(), &ranks);
+    auto values = GetInput();
+    int size = static_cast<int>(values.size());
+    MPI_Bcast(&size, 1, MPI_INT, 0, GetCommunicator());
+    values.resize(static_cast<std::size_t>(size));
+    MPI_Bcast(values.data(), size, MPI_INT32_T, 0, GetCommunicator());
+
+    int32_t local = 0;
+    for (int i = rank; i < size; i += ranks) {
+      local += values[static_cast<std::size_t>(i)];
+    }
+    MPI_Allreduce(&local, &GetOutput(), 1, MPI_INT32_T, MPI_SUM, GetCommunicator());
+    SetOutputPlacement(ppc::task::DataPlacement::kReplicated);
+    return true;
+  }
+  bool PostProcessingImpl() override {
+    return true;
+  }
+};
+
+template <typename TaskType, typename TaskInput>
+auto RunAlone(const TaskInput &in) {
+  TaskType task(in);
+  EXPECT_TRUE(task.Validation() && task.PreProcessing() && task.Run() && task.PostProcessing());
+  return task.GetOutput();
+}
+
+}  // namespace
+
+TEST(TaskTest, TaskGetterMovesInputIntoTask) {
+  std::vector<int32_t> in(1000, 1);
+  const auto *data = in.data();
+  auto task = ppc::task::TaskGetter<MoveInTask>(std::move(in));
+  EXPECT_EQ(task->GetInput().data(), data);
+  task->Validation();
+  task->PreProcessing();
+  task->Run();
+  task->PostProcessing();
+}
+
+TEST(TaskTest, SharedInputIsNotCopiedBetweenTasks) {
+  const auto in = std::make_shared<const std::vector<int32_t>>(100, 2);
+  auto first = ppc::task::TaskGetter<SharedInputTask>(in);
+  auto second = ppc::task::TaskGetter<SharedInputTask>(in);
+  EXPECT_EQ(first->GetInput().get(), second->GetInput().get());
+  for (const auto &task : {first, second}) {
+    ASSERT_TRUE(task->Validation());
+    task->PreProcessing();
+    task->Run();
+    task->PostProcessing();
+    EXPECT_EQ(task->GetOutput(), 200);
+  }
+}
+
+TEST(TaskTest, CommunicatorDefaultsToWorldAndIsFixedOnceStarted) {
+  auto task = ppc::task::TaskGetter<MoveInTask>(std::vector<int32_t>(4, 1));
+  EXPECT_EQ(task->GetCommunicator(), MPI_COMM_WORLD);
+  EXPECT_FALSE(task->SupportsCommunicator());
+  task->SetCommunicator(MPI_COMM_SELF);
+  EXPECT_EQ(task->GetCommunicator(), MPI_COMM_SELF);
+  task->Validation();
+  EXPECT_THROW(task->SetCommunicator(MPI_COMM_WORLD), std::runtime_error);
+  task->PreProcessing();
+  task->Run();
+  task->PostProcessing();
+}
+
+TEST(TaskTest, BatchTaskRunsEveryInput) {
+  std::vector<std::vector<int32_t>> inputs = {{1, 2, 3}, {10}, {5, 5}};
+  SumBatchTask task(inputs);
+  EXPECT_EQ(task.GetDynamicTypeOfTask(), TypeOfTask::kSEQ);
+  ASSERT_TRUE(task.Validation());
+  ASSERT_TRUE(task.PreProcessing());
+  ASSERT_TRUE(task.Run());
+  ASSERT_TRUE(task.PostProcessing());
+  EXPECT_EQ(task.GetOutput(), (std::vector<int32_t>{6, 10, 10}));
+}
+
+TEST(TaskTest, BatchTaskFailsIfAnyInputIsInvalid) {
+  std::vector<std::vector<int32_t>> inputs = {{1}, {}};
+  SumBatchTask task(inputs);
+  ASSERT_TRUE(task.Validation());
+  ASSERT_TRUE(task.PreProcessing());
+  EXPECT_FALSE(task.Run());
+  // The rejected inner task is abandoned, not left for its destructor to report
+  EXPECT_FALSE(ppc::util::DestructorFailureFlag::Get());
+  task.PostProcessing();
+}
+
+TEST(TaskTest, AbandonedTaskCanBeDestroyedOrRestarted) {
+  {
+    SumTask task({});
+    EXPECT_FALSE(task.Validation());
+    task.Abandon();
+  }
+  EXPECT_FALSE(ppc::util::DestructorFailureFlag::Get());
+
+  SumTask task({4});
+  ASSERT_TRUE(task.Validation());
+  task.Abandon();
+  ASSERT_TRUE(task.Validation());
+  ASSERT_TRUE(task.PreProcessing());
+  ASSERT_TRUE(task.Run());
+  ASSERT_TRUE(task.PostProcessing());
+  EXPECT_EQ(task.GetOutput(), 4);
+}
+
+TEST(TaskTest, RunAsyncReturnsResultOfRun) {
+  auto task = std::make_shared<SumTask>(std::vector<int32_t>{1, 2, 3});
+  ASSERT_TRUE(task->Validation());
+  ASSERT_TRUE(task->PreProcessing());
+  auto done = task->RunAsync();
+  EXPECT_TRUE(done.get());
+  ASSERT_TRUE(task->PostProcessing());
+  EXPECT_EQ(task->GetOutput(), 6);
+}
+
+TEST(TaskTest, RunAsyncThrowsIfCalledBeforePreProcessing) {
+  auto task = std::make_shared<SumTask>(std::vector<int32_t>{1});
+  EXPECT_THROW(task->RunAsync(), std::runtime_error);
+}
+
+TEST(TaskTest, NextStageWaitsForAsyncRun) {
+  ppc::test::FakeSlowTask<std::vector<int32_t>, int32_t> task({4, 5});
+  task.GetStateOfTesting() = ppc::task::StateOfTesting::kPerf;
+  ASSERT_TRUE(task.Validation());
+  ASSERT_TRUE(task.PreProcessing());
+  auto done = task.RunAsync();
+  // PostProcessing() must not overtake the run in flight
+  ASSERT_TRUE(task.PostProcessing());
+  EXPECT_EQ(done.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+  EXPECT_EQ(task.GetOutput(), 9);
+}
+
+TEST(TaskTest, PipelineAsyncRunsEveryStageAndKeepsTaskAlive) {
+  auto task = std::make_shared<SumTask>(std::vector<int32_t>{2, 3});
+  std::weak_ptr<SumTask> observer = task;
+  auto done = task->PipelineAsync();
+  task.reset();
+  EXPECT_TRUE(done.get());
+  EXPECT_TRUE(observer.expired() || observer.lock()->GetOutput() == 5);
+}
+
+TEST(TaskTest, PipelineAsyncThrowsWhilePipelineIsInProgress) {
+  auto task = std::make_shared<SumTask>(std::vector<int32_t>{1});
+  ASSERT_TRUE(task->Validation());
+  EXPECT_THROW(task->PipelineAsync(), std::runtime_error);
+}
+
+TEST(TaskTest, AsyncStagesOfMpiTasksNeedThreadMultiple) {
+  const auto threading = ppc::util::GetRankThreading();
+  ppc::util::SetRankThreading({.mpi_thread_level = ppc::util::MpiThreadLevel::kFunneled, .thread_budget = 1});
+  auto task = std::make_shared<SumTask>(std::vector<int32_t>{1, 2});
+  task->SetTypeOfTask(TypeOfTask::kMPI);
+  EXPECT_THROW(task->PipelineAsync(), std::runtime_error);
+  ASSERT_TRUE(task->Validation());
+  ASSERT_TRUE(task->PreProcessing());
+  EXPECT_THROW(task->RunAsync(), std::runtime_error);
+  // The rejection leaves the pipeline where it was
+  ASSERT_TRUE(task->Run());
+
+  ppc::util::SetRankThreading({.mpi_thread_level = ppc::util::MpiThreadLevel::kMultiple, .thread_budget = 1});
+  auto done = task->RunAsync();
+  EXPECT_TRUE(done.get());
+  ASSERT_TRUE(task->PostProcessing());
+  EXPECT_EQ(task->GetOutput(), 6);
+  ppc::util::SetRankThreading(threading);
+}
+
+TEST(TaskTest, PipelineChainsTasksAndReportsEveryStep) {
+  auto pipeline = ppc::task::PipelineBuilder<std::vector<int32_t>>()
+                      .Then<SumTask>()
+                      .Then<RepeatTask>()
+                      .Then<SumTask>()
+                      .Build({1, 2, 3});
+  ASSERT_TRUE(pipeline->Validation());
+  ASSERT_TRUE(pipeline->PreProcessing());
+  ASSERT_TRUE(pipeline->Run());
+  ASSERT_TRUE(pipeline->Run());
+  ASSERT_TRUE(pipeline->PostProcessing());
+  EXPECT_EQ(pipeline->GetOutput(), 18);
+  EXPECT_EQ(pipeline->GetInput(), (std::vector<int32_t>{1, 2, 3}));
+  EXPECT_EQ(pipeline->GetDynamicTypeOfTask(), TypeOfTask::kSEQ);
+
+  const auto steps = pipeline->GetStepTimes();
+  ASSERT_EQ(steps.size(), 3U);
+  for (const auto &step : steps) {
+    EXPECT_EQ(step.stages.calls[static_cast<std::size_t>(ppc::task::TaskStage::kRun)], 2U);
+  }
+  EXPECT_EQ(steps[0].input_placement, ppc::task::DataPlacement::kRoot);
+  EXPECT_EQ(steps[1].input_placement, ppc::task::DataPlacement::kRoot);
+  EXPECT_EQ(steps[2].input_placement, ppc::task::DataPlacement::kReplicated);
+  EXPECT_EQ(pipeline->GetOutputPlacement(), ppc::task::DataPlacement::kRoot);
+}
+
+TEST(TaskTest, PipelineAppliesAdaptersBetweenSteps) {
+  auto pipeline = ppc::task::PipelineBuilder<std::vector<int32_t>>()
+                      .Then<SumTask>()
+                      .Then<SumTask>([](int32_t sum) { return std::vector<int32_t>{sum, sum}; })
+                      .Build({4, 5});
+  ASSERT_TRUE(pipeline->Validation());
+  ASSERT_TRUE(pipeline->PreProcessing());
+  ASSERT_TRUE(pipeline->Run());
+  ASSERT_TRUE(pipeline->PostProcessing());
+  EXPECT_EQ(pipeline->GetOutput(), 18);
+}
+
+TEST(TaskTest, PipelineTakesTheTypeOfItsMpiSteps) {
+  const auto threading = ppc::util::GetRankThreading();
+  ppc::util::SetRankThreading({.mpi_thread_level = ppc::util::MpiThreadLevel::kFunneled, .thread_budget = 1});
+  auto pipeline = ppc::task::PipelineBuilder<std::vector<int32_t>>()
+                      .Then<SumTask>()
+                      .Then<MpiSumTask>([](int32_t sum) { return std::vector<int32_t>{sum}; })
+                      .Build({2, 3});
+  EXPECT_EQ(pipeline->GetDynamicTypeOfTask(), TypeOfTask::kMPI);
+  // A chain with MPI steps is held to the same threading rules as a single MPI task
+  EXPECT_THROW(pipeline->PipelineAsync(), std::runtime_error);
+  ASSERT_TRUE(pipeline->Validation());
+  ASSERT_TRUE(pipeline->PreProcessing());
+  ASSERT_TRUE(pipeline->Run());
+  ASSERT_TRUE(pipeline->PostProcessing());
+  EXPECT_EQ(pipeline->GetOutput(), 5);
+  ppc::util::SetRankThreading(threading);
+}
+
+TEST(TaskTest, PipelineFailsIfAStepFails) {
+  auto pipeline = ppc::task::PipelineBuilder<std::vector<int32_t>>()
+                      .Then<SumTask>()
+                      .Then<SumTask>([](int32_t /*sum*/) { return std::vector<int32_t>{}; })
+                      .Build({1});
+  ASSERT_TRUE(pipeline->Validation());
+  ASSERT_TRUE(pipeline->PreProcessing());
+  EXPECT_FALSE(pipeline->Run());
+  EXPECT_FALSE(ppc::util::DestructorFailureFlag::Get());
+  pipeline->PostProcessing();
+}
+
+TEST(TaskPipelineMpi, ChainedStepsMatchTheStepsRunOneAfterAnother) {
+  ppc::util::test::MpiEnvironment::EnsureInitialized();
+  const std::vector<int32_t> input = {1, 2, 3, 4, 5, 6, 7};
+
+  // The tasks one after another, each given the previous output by hand
+  const auto sum = RunAlone<DistributedSumTask>(input);
+  const auto repeated = RunAlone<RepeatTask>(sum);
+  const auto expected = RunAlone<DistributedSumTask>(repeated);
+  EXPECT_EQ(expected, 84);
+
+  auto pipeline = ppc::task::PipelineBuilder<std::vector<int32_t>>()
+                      .Then<DistributedSumTask>()
+                      .Then<RepeatTask>()
+                      .Then<DistributedSumTask>()
+                      .Build(input);
+  EXPECT_EQ(pipeline->GetDynamicTypeOfTask(), TypeOfTask::kMPI);
+  ASSERT_TRUE(pipeline->Validation());
+  ASSERT_TRUE(pipeline->PreProcessing());
+  ASSERT_TRUE(pipeline->Run());
+  ASSERT_TRUE(pipeline->PostProcessing());
+  EXPECT_EQ(pipeline->GetOutput(), expected);
+  EXPECT_EQ(pipeline->GetOutputPlacement(), ppc::task::DataPlacement::kReplicated);
+}
+
+TEST(TaskTest, InputPlacementIsFixedOnceStarted) {
+  SumTask task({1});
+  EXPECT_EQ(task.GetInputPlacement(), ppc::task::DataPlacement::kRoot);
+  task.SetInputPlacement(ppc::task::DataPlacement::kReplicated);
+  EXPECT_EQ(task.GetInputPlacement(), ppc::task::DataPlacement::kReplicated);
+  task.Validation();
+  EXPECT_THROW(task.SetInputPlacement(ppc::task::DataPlacement::kRoot), std::runtime_error);
+  task.PreProcessing();
+  task.Run();
+  task.PostProcessing();
+}
+
 int main(int argc, char **argv) {
   return ppc::runners::SimpleInit(argc, argv);
 }
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+namespace ppc::util {
+
+/// @brief Heap and RSS statistics of a code region on the calling rank.
+struct AllocStats {
+  /// @brief Bytes requested from operator new.
+  uint64_t bytes = 0;
+  /// @brief Number of operator new calls.
+  uint64_t allocations = 0;
+  /// @brief High-water mark of live heap bytes above the level at the start of the region.
+  uint64_t peak_heap_bytes = 0;
+  /// @brief Peak resident set size of the process since its start, read at the end of the region, in KiB.
+  /// @details Not specific to the region: the kernel keeps one high-water mark per process.
+  uint64_t process_peak_rss_kb = 0;
+};
+
+/// @brief Process-wide allocation counters filled by the global operator new/delete replacements.
+/// @details The replacements are compiled only with -D USE_ALLOC_TRACKER=ON; otherwise every query returns
+///          zeros and AllocScope costs nothing.
+class AllocTracker {
+ public:
+  /// @brief Checks whether the operator new/delete hooks are linked into the binary.
+  static constexpr bool IsEnabled() {
+#ifdef USE_ALLOC_TRACKER
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  /// @brief Number of scopes whose heap high-water marks can be tracked at the same time.
+  static constexpr std::size_t kMaxScopes = 64;
+
+  static void RecordAlloc(std::size_t requested, std::size_t usable) {
+    bytes.fetch_add(requested, std::memory_order_relaxed);
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    const uint64_t current = live_bytes.fetch_add(usable, std::memory_order_relaxed) + usable;
+    for (uint64_t open = open_scopes.load(std::memory_order_relaxed); open != 0; open &= open - 1) {
+      RaisePeak(scope_peaks[static_cast<std::size_t>(std::countr_zero(open))], current);
+    }
+  }
+
+  static void RecordFree(std::size_t usable) {
+    live_bytes.fetch_sub(usable, std::memory_order_relaxed);
+  }
+
+  /// @brief Returns the peak resident set size of the process since its start in KiB (0 if unknown).
+  static uint64_t GetProcessPeakRssKb();
+
+ private:
+  friend class AllocScope;
+
+  static void RaisePeak(std::atomic<uint64_t> &peak, uint64_t value) {
+    uint64_t seen = peak.load(std::memory_order_relaxed);
+    while (value > seen && !peak.compare_exchange_weak(seen, value, std::memory_order_relaxed)) {
+    }
+  }
+
+  /// @brief Claims a free high-water mark slot starting at the current live bytes; kMaxScopes if none is free.
+  static std::size_t OpenScope() {
+    uint64_t open = open_scopes.load(std::memory_order_relaxed);
+    while (open != ~uint64_t{0}) {
+      const auto slot = static_cast<std::size_t>(std::countr_one(open));
+      if (open_scopes.compare_exchange_weak(open, open | (uint64_t{1} << slot), std::memory_order_relaxed)) {
+        scope_peaks[slot].store(live_bytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        return slot;
+      }
+    }
+    return kMaxScopes;
+  }
+
+  static void CloseScope(std::size_t slot) {
+    open_scopes.fetch_and(~(uint64_t{1} << slot), std::memory_order_relaxed);
+  }
+
+  inline static std::atomic<uint64_t> bytes{0};
+  inline static std::atomic<uint64_t> allocations{0};
+  inline static std::atomic<uint64_t> live_bytes{0};
+  /// @brief Bit i is set while slot i of scope_peaks belongs to an open scope.
+  inline static std::atomic<uint64_t> open_scopes{0};
+  inline static std::array<std::atomic<uint64_t>, kMaxScopes> scope_peaks{};
+};
+
+/// @brief Measures the allocations of the calling process between construction and Stop().
+/// @details Every open scope keeps its own heap high-water mark, so scopes may nest or overlap in any order, e.g.
+///          stages of several tasks running asynchronously. The marks are process-wide: an outer scope includes its
+///          inner scopes, and overlapping scopes include each other's allocations. Beyond
+///          AllocTracker::kMaxScopes open scopes, peak_heap_bytes is reported as 0.
+class AllocScope {
+ public:
+  AllocScope() {
+    if constexpr (AllocTracker::IsEnabled()) {
+      start_bytes_ = AllocTracker::bytes.load(std::memory_order_relaxed);
+      start_allocations_ = AllocTracker::allocations.load(std::memory_order_relaxed);
+      start_live_ = AllocTracker::live_bytes.load(std::memory_order_relaxed);
+      slot_ = AllocTracker::OpenScope();
+    }
+  }
+
+  ~AllocScope() {
+    if (slot_ < AllocTracker::kMaxScopes) {
+      AllocTracker::CloseScope(slot_);
+    }
+  }
+
+  AllocScope(const AllocScope &) = delete;
+  AllocScope &operator=(const AllocScope &) = delete;
+  AllocScope(AllocScope &&) = delete;
+  AllocScope &operator=(AllocScope &&) = delete;
+
+  /// @brief Returns the statistics of the region; must be called once.
+  AllocStats Stop() {
+    AllocStats stats;
+    if constexpr (AllocTracker::IsEnabled()) {
+      stats.bytes = AllocTracker::bytes.load(std::memory_order_relaxed) - start_bytes_;
+      stats.allocations = AllocTracker::allocations.load(std::memory_order_relaxed) - start_allocations_;
+      if (slot_ < AllocTracker::kMaxScopes) {
+        const uint64_t peak = AllocTracker::scope_peaks[slot_].load(std::memory_order_relaxed);
+        stats.peak_heap_bytes = peak > start_live_ ? peak - start_live_ : 0;
+        AllocTracker::CloseScope(slot_);
+        slot_ = AllocTracker::kMaxScopes;
+      }
+      stats.process_peak_rss_kb = AllocTracker::GetProcessPeakRssKb();
+    }
+    return stats;
+  }
+
+ private:
+  uint64_t start_bytes_ = 0;
+  uint64_t start_allocations_ = 0;
+  uint64_t start_live_ = 0;
+  std::size_t slot_ = AllocTracker::kMaxScopes;
+};
+
+}  // namespace ppc::util
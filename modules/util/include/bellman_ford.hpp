@@ -0,0 +1,258 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "util/include/local_csr.hpp"
+#include "util/include/partition.hpp"
+#include "util/include/scatter_gather.hpp"
+
+namespace ppc::util {
+
+/// @brief Distributed single-source shortest paths by frontier-driven Bellman-Ford.
+/// @details Vertices are split between the ranks of comm by a contiguous Partition. Each round relaxes only the
+///          out-edges of the vertices whose distance changed in the previous round; improvements of vertices owned
+///          by other ranks are sent to their owners as sparse (vertex, distance) deltas with one MPI_Alltoallv, so
+///          a round costs O(frontier) work and traffic instead of a full-vector reduction. Weights may be negative.
+///
+///          A negative cycle reachable from the source is reported two ways: every vertex remembers the vertex it
+///          was last improved from, and a cycle among these parents is always negative, so the parents are checked
+///          after rounds 1, 2, 4, 8, ...; as a backstop, distances are final after V - 1 rounds without such a
+///          cycle, so a frontier still non-empty after V rounds proves one.
+/// @tparam Weight Arithmetic edge weight type.
+/// @tparam Dist Distance type, wide enough for sums of weights along a path.
+template <typename Weight, typename Dist = Weight>
+class FrontierBellmanFord {
+  static_assert(std::is_arithmetic_v<Weight> && std::is_arithmetic_v<Dist>,
+                "Bellman-Ford needs arithmetic weights and distances");
+
+ public:
+  struct Result {
+    /// @brief Distances of the vertices owned by this rank in local order; unreachable vertices keep the value
+    ///        passed to Run(). Not meaningful if has_negative_cycle is set.
+    std::vector<Dist> local_dist;
+    bool has_negative_cycle = false;
+    /// @brief Relaxation rounds until the frontier emptied or the cycle was found.
+    int rounds = 0;
+  };
+
+  /// @brief Collective over comm.
+  FrontierBellmanFord(LocalCsr<Weight> graph, Partition vertices, MPI_Comm comm)
+      : graph_(graph), vertices_(std::move(vertices)), comm_(comm) {
+    MPI_Comm_rank(comm_, &rank_);
+    MPI_Comm_size(comm_, &size_);
+    if (vertices_.Parts() != size_ || !vertices_.IsContiguous() ||
+        graph_.offsets.size() != static_cast<std::size_t>(vertices_.Count(rank_)) + 1) {
+      throw std::runtime_error("FrontierBellmanFord: the local rows do not match a contiguous vertex partition");
+    }
+    first_ = vertices_.Offset(rank_);
+    last_ = first_ + vertices_.Count(rank_);
+  }
+
+  /// @brief Computes the distances from source; collective over comm.
+  /// @param unreachable Distance reported for vertices the source cannot reach; must exceed every real distance.
+  Result Run(int source, Dist unreachable) {
+    if (source < 0 || source >= vertices_.Total()) {
+      throw std::runtime_error("FrontierBellmanFord: source vertex out of range");
+    }
+    Result result;
+    dist_.assign(static_cast<std::size_t>(vertices_.Count(rank_)), unreachable);
+    parent_.assign(dist_.size(), kNoParent);
+    frontier_mark_.assign(dist_.size(), 0);
+    sent_mark_.assign(static_cast<std::size_t>(vertices_.Total()), 0);
+    sent_slot_.assign(sent_mark_.size(), 0);
+    frontier_stamp_ = 1;
+    outbox_.assign(static_cast<std::size_t>(size_), {});
+    frontier_.clear();
+    dense_ = false;
+    if (vertices_.Owner(source) == rank_) {
+      Relax(vertices_.LocalIndex(source), Dist{}, kNoParent);
+    }
+
+    bool pending = true;
+    while (pending) {
+      pending = RelaxFrontier();
+      result.rounds++;
+      if (!pending) {
+        break;
+      }
+      if ((result.rounds & (result.rounds - 1)) == 0 && ParentsFormCycle()) {
+        result.has_negative_cycle = true;
+        break;
+      }
+      if (result.rounds >= vertices_.Total()) {
+        // pending may be a delta that improved nothing, so check the frontiers themselves before blaming a cycle
+        int local_active = HasFrontier() ? 1 : 0;
+        int active = 0;
+        MPI_Allreduce(&local_active, &active, 1, MPI_INT, MPI_MAX, comm_);
+        result.has_negative_cycle = active != 0;
+        break;
+      }
+    }
+    result.local_dist = std::move(dist_);
+    return result;
+  }
+
+ private:
+  static constexpr int kNoParent = -1;
+  /// @brief Frontiers above 1 / kDenseFrontierRatio of the local vertices are processed in vertex order.
+  static constexpr std::size_t kDenseFrontierRatio = 8;
+
+  struct Delta {
+    int vertex;
+    int parent;
+    Dist distance;
+  };
+
+  /// @brief Lowers the distance of a local vertex and queues it for the next round once.
+  /// @details In a dense round only the distance is stored: the next frontier is every vertex that ended below its
+  ///          snapshot from the start of the round, which spares a check per improvement when nearly every vertex
+  ///          improves anyway.
+  void Relax(int local, Dist distance, int parent) {
+    const auto index = static_cast<std::size_t>(local);
+    if (!(distance < dist_[index])) {
+      return;
+    }
+    dist_[index] = distance;
+    parent_[index] = parent;
+    if (!dense_ && frontier_mark_[index] != frontier_stamp_) {
+      frontier_mark_[index] = frontier_stamp_;
+      frontier_.push_back(local);
+    }
+  }
+
+  /// @brief Queues a delta for a foreign vertex, keeping only the best one per vertex and round.
+  void Send(int owner, int target, Dist distance, int parent) {
+    const auto index = static_cast<std::size_t>(target);
+    auto &outbox = outbox_[static_cast<std::size_t>(owner)];
+    if (sent_mark_[index] == frontier_stamp_) {
+      auto &queued = outbox[static_cast<std::size_t>(sent_slot_[index])];
+      if (distance < queued.distance) {
+        queued.distance = distance;
+        queued.parent = parent;
+      }
+      return;
+    }
+    sent_mark_[index] = frontier_stamp_;
+    sent_slot_[index] = static_cast<int>(outbox.size());
+    outbox.push_back({.vertex = target, .parent = parent, .distance = distance});
+  }
+
+  /// @brief Runs one round; false once no rank has a frontier left or deltas in flight.
+  bool RelaxFrontier() {
+    std::vector<int> current;
+    std::swap(current, frontier_);
+    if (dense_) {
+      // Collected in vertex order, so the rows are read sequentially instead of at random
+      for (std::size_t v = 0; v < dist_.size(); v++) {
+        if (dist_[v] < snapshot_[v]) {
+          current.push_back(static_cast<int>(v));
+        }
+      }
+    }
+    dense_ = current.size() * kDenseFrontierRatio > dist_.size();
+    if (dense_) {
+      snapshot_ = dist_;
+    }
+    // Vertices improved from here on belong to the next round, even those relaxed in this one
+    ++frontier_stamp_;
+    // Locals, since the stores into dist_ may alias the members as far as the compiler knows
+    const int total = vertices_.Total();
+    const int first = first_;
+    const int last = last_;
+    for (const int v : current) {
+      const Dist distance = dist_[static_cast<std::size_t>(v)];
+      const auto begin = static_cast<std::size_t>(graph_.offsets[static_cast<std::size_t>(v)]);
+      const auto end = static_cast<std::size_t>(graph_.offsets[static_cast<std::size_t>(v) + 1]);
+      for (std::size_t edge = begin; edge < end; edge++) {
+        const int target = graph_.columns[edge];
+        if (target < 0 || target >= total) {
+          continue;
+        }
+        const Dist candidate = distance + static_cast<Dist>(graph_.weights[edge]);
+        if (target >= first && target < last) {
+          Relax(target - first, candidate, first + v);
+        } else {
+          Send(vertices_.Owner(target), target, candidate, first + v);
+        }
+      }
+    }
+    bool pending = HasFrontier();
+    for (const auto &delta : ExchangeOutbox(outbox_, comm_, pending)) {
+      Relax(delta.vertex - first, delta.distance, delta.parent);
+    }
+    return pending;
+  }
+
+  [[nodiscard]] bool HasFrontier() const {
+    if (!dense_) {
+      return !frontier_.empty();
+    }
+    for (std::size_t v = 0; v < dist_.size(); v++) {
+      if (dist_[v] < snapshot_[v]) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /// @brief Gathers the parents and looks for a cycle among them; collective over comm.
+  /// @details Following parents from a vertex ends at the source, at an unreached vertex or in a cycle; walks stop
+  ///          at vertices already walked, so every vertex is visited once.
+  bool ParentsFormCycle() {
+    const auto parents = Allgatherv(parent_, vertices_, comm_);
+    // 0: not walked yet, start + 1: on the walk from start, -1: the walk from here ends outside a cycle
+    std::vector<int> walk(parents.size(), 0);
+    for (std::size_t start = 0; start < parents.size(); start++) {
+      const int id = static_cast<int>(start) + 1;
+      int v = static_cast<int>(start);
+      while (v != kNoParent && walk[static_cast<std::size_t>(v)] == 0) {
+        walk[static_cast<std::size_t>(v)] = id;
+        v = parents[static_cast<std::size_t>(v)];
+      }
+      if (v != kNoParent && walk[static_cast<std::size_t>(v)] == id) {
+        return true;
+      }
+      for (v = static_cast<int>(start); v != kNoParent && walk[static_cast<std::size_t>(v)] == id;
+           v = parents[static_cast<std::size_t>(v)]) {
+        walk[static_cast<std::size_t>(v)] = -1;
+      }
+    }
+    return false;
+  }
+
+  LocalCsr<Weight> graph_;
+  Partition vertices_;
+  MPI_Comm comm_;
+  int rank_ = 0;
+  int size_ = 1;
+  /// @brief Global ids of the local vertices are [first_, last_).
+  int first_ = 0;
+  int last_ = 0;
+
+  std::vector<Dist> dist_;
+  /// @brief Global id of the vertex each local vertex was last improved from.
+  std::vector<int> parent_;
+  /// @brief Local vertices whose distance changed since their out-edges were last relaxed.
+  std::vector<int> frontier_;
+  /// @brief Stamp marking the vertices already queued in frontier_.
+  std::vector<std::uint32_t> frontier_mark_;
+  std::uint32_t frontier_stamp_ = 1;
+  /// @brief Whether the current round relaxes a dense frontier; frontier_ then stays empty and the next frontier
+  ///        is read off against snapshot_, the distances at the start of the round.
+  bool dense_ = false;
+  std::vector<Dist> snapshot_;
+  /// @brief Pending distance deltas per owner rank.
+  std::vector<std::vector<Delta>> outbox_;
+  /// @brief Stamp and outbox position of the foreign vertices with a delta queued this round.
+  std::vector<std::uint32_t> sent_mark_;
+  std::vector<int> sent_slot_;
+};
+
+}  // namespace ppc::util
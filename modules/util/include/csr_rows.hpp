@@ -0,0 +1,212 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "util/include/partition.hpp"
+#include "util/include/scatter_gather.hpp"
+#include "util/include/spgemm.hpp"
+
+namespace ppc::util {
+
+namespace detail {
+
+/// @brief Sends every rank a CRS block of rows of root_matrix, packed on the root.
+/// @details root_rows lists the rows for rank 0, then those for rank 1 and so on, row_counts[r] of them for rank r
+///          (both only read on root); local_rows is the count of this rank. The block moves in three collectives
+///          (row lengths, columns, values) whatever the number of rows, and every receiver rebuilds its row_ptr
+///          from the lengths.
+template <typename Value>
+CsrMatrix<Value> ScatterPackedCsrRows(const CsrView<Value> &root_matrix, std::span<const int> root_rows,
+                                      std::span<const int> row_counts, int local_rows, MPI_Comm comm, int root) {
+  int rank = 0;
+  int size = 0;
+  MPI_Comm_rank(comm, &rank);
+  MPI_Comm_size(comm, &size);
+
+  std::vector<int> lengths;
+  std::vector<int> col_idx;
+  std::vector<Value> values;
+  std::vector<int> row_displs;
+  std::vector<int> nnz_counts;
+  std::vector<int> nnz_displs;
+  if (rank == root) {
+    row_displs.resize(static_cast<std::size_t>(size));
+    std::exclusive_scan(row_counts.begin(), row_counts.end(), row_displs.begin(), 0);
+    nnz_counts.assign(static_cast<std::size_t>(size), 0);
+    nnz_displs.assign(static_cast<std::size_t>(size), 0);
+    lengths.reserve(root_rows.size());
+    for (std::size_t dest = 0; dest < static_cast<std::size_t>(size); dest++) {
+      nnz_displs[dest] = static_cast<int>(col_idx.size());
+      const auto first = root_rows.begin() + row_displs[dest];
+      for (const int row : std::span<const int>(first, first + row_counts[dest])) {
+        const int begin = root_matrix.row_ptr[static_cast<std::size_t>(row)];
+        const int end = root_matrix.row_ptr[static_cast<std::size_t>(row) + 1];
+        lengths.push_back(end - begin);
+        col_idx.insert(col_idx.end(), root_matrix.col_idx.begin() + begin, root_matrix.col_idx.begin() + end);
+        values.insert(values.end(), root_matrix.values.begin() + begin, root_matrix.values.begin() + end);
+      }
+      nnz_counts[dest] = static_cast<int>(col_idx.size()) - nnz_displs[dest];
+    }
+  }
+
+  CsrMatrix<Value> local;
+  local.rows = local_rows;
+  local.cols = root_matrix.cols;
+  local.row_ptr.assign(static_cast<std::size_t>(local_rows) + 1, 0);
+  MPI_Scatterv(lengths.data(), row_counts.data(), row_displs.data(), MPI_INT, local.row_ptr.data() + 1, local_rows,
+               MPI_INT, root, comm);
+  std::partial_sum(local.row_ptr.begin(), local.row_ptr.end(), local.row_ptr.begin());
+  const int local_nnz = local.row_ptr.back();
+  local.col_idx.resize(static_cast<std::size_t>(local_nnz));
+  local.values.resize(static_cast<std::size_t>(local_nnz));
+  MPI_Scatterv(col_idx.data(), nnz_counts.data(), nnz_displs.data(), MPI_INT, local.col_idx.data(), local_nnz,
+               MPI_INT, root, comm);
+  MPI_Scatterv(values.data(), nnz_counts.data(), nnz_displs.data(), MpiTypeOf<Value>(), local.values.data(),
+               local_nnz, MpiTypeOf<Value>(), root, comm);
+  return local;
+}
+
+}  // namespace detail
+
+/// @brief Sends every rank its rows of a CRS matrix as one packed block.
+/// @details Replaces per-row point-to-point messages: the number of messages grows with the ranks, not the rows.
+/// @param root_matrix Only read on root, except cols, which every rank passes and which the blocks inherit.
+/// @param rows Partition of the rows of the matrix over the ranks of comm.
+/// @return The rows.Count(rank) rows of this rank in local order, row_ptr starting at 0.
+/// @throws std::runtime_error On every rank if the matrix on root does not have rows.Total() rows.
+template <typename Value>
+CsrMatrix<Value> ScatterCsrRows(const CsrView<Value> &root_matrix, const Partition &rows, MPI_Comm comm,
+                                int root = 0) {
+  detail::CheckPartitionMatchesComm(rows, comm);
+  int rank = 0;
+  MPI_Comm_rank(comm, &rank);
+  std::string error;
+  if (rank == root && root_matrix.Rows() != rows.Total()) {
+    error = "ScatterCsrRows: the matrix has " + std::to_string(root_matrix.Rows()) + " rows but the partition covers " +
+            std::to_string(rows.Total());
+  }
+  detail::ThrowIfAnyRankFailed(error, "ScatterCsrRows", comm);
+  std::vector<int> root_rows;
+  if (rank == root) {
+    root_rows.reserve(static_cast<std::size_t>(rows.Total()));
+    for (int part = 0; part < rows.Parts(); part++) {
+      for (int local = 0; local < rows.Count(part); local++) {
+        root_rows.push_back(rows.GlobalIndex(part, local));
+      }
+    }
+  }
+  return detail::ScatterPackedCsrRows(root_matrix, std::span<const int>(root_rows), rows.Counts(), rows.Count(rank),
+                                      comm, root);
+}
+
+/// @brief Sends every rank the rows of a CRS matrix it asks for, e.g. the rows of B referenced by the columns of
+///        its rows of A in a distributed A * B.
+/// @details The requests reach the root in one gather, the rows come back as packed blocks as in ScatterCsrRows().
+/// @param root_matrix Only read on root, except cols, which every rank passes.
+/// @param wanted_rows Rows this rank needs, in the order they are returned.
+/// @throws std::runtime_error On every rank if some rank asks for a row outside the matrix.
+template <typename Value>
+CsrMatrix<Value> FetchCsrRows(const CsrView<Value> &root_matrix, std::span<const int> wanted_rows, MPI_Comm comm,
+                              int root = 0) {
+  int rank = 0;
+  int size = 0;
+  MPI_Comm_rank(comm, &rank);
+  MPI_Comm_size(comm, &size);
+  const int wanted = static_cast<int>(wanted_rows.size());
+  std::vector<int> row_counts(rank == root ? static_cast<std::size_t>(size) : 0);
+  MPI_Gather(&wanted, 1, MPI_INT, row_counts.data(), 1, MPI_INT, root, comm);
+
+  std::vector<int> root_rows;
+  std::vector<int> row_displs(row_counts.size());
+  if (rank == root) {
+    std::exclusive_scan(row_counts.begin(), row_counts.end(), row_displs.begin(), 0);
+    root_rows.resize(static_cast<std::size_t>(std::reduce(row_counts.begin(), row_counts.end())));
+  }
+  MPI_Gatherv(wanted_rows.data(), wanted, MPI_INT, root_rows.data(), row_counts.data(), row_displs.data(), MPI_INT,
+              root, comm);
+  std::string error;
+  if (rank == root && std::ranges::any_of(root_rows, [&](int row) { return row < 0 || row >= root_matrix.Rows(); })) {
+    error = "FetchCsrRows: a rank asked for a row outside the matrix";
+  }
+  detail::ThrowIfAnyRankFailed(error, "FetchCsrRows", comm);
+  return detail::ScatterPackedCsrRows(root_matrix, std::span<const int>(root_rows), row_counts, wanted, comm, root);
+}
+
+/// @brief Inverse of ScatterCsrRows(): assembles the row blocks of every rank on root in global row order.
+/// @return The whole matrix on root; other ranks get an empty matrix.
+/// @throws std::runtime_error On every rank if the block of some rank does not have its rows.Count() rows.
+template <typename Value>
+CsrMatrix<Value> GatherCsrRows(const CsrMatrix<Value> &local, const Partition &rows, MPI_Comm comm, int root = 0) {
+  detail::CheckPartitionMatchesComm(rows, comm);
+  int rank = 0;
+  MPI_Comm_rank(comm, &rank);
+  std::string error;
+  if (local.rows != rows.Count(rank)) {
+    error = "GatherCsrRows: the local block has " + std::to_string(local.rows) + " rows but " +
+            std::to_string(rows.Count(rank)) + " belong to this rank";
+  }
+  detail::ThrowIfAnyRankFailed(error, "GatherCsrRows", comm);
+  std::vector<int> local_lengths(static_cast<std::size_t>(local.rows));
+  std::adjacent_difference(local.row_ptr.begin() + 1, local.row_ptr.end(), local_lengths.begin());
+  if (!local_lengths.empty()) {
+    local_lengths.front() -= local.row_ptr.front();
+  }
+
+  // Row lengths and entries arrive in rank order, the lengths alone are enough to size every rank's entries
+  const bool is_root = rank == root;
+  std::vector<int> packed_lengths(is_root ? static_cast<std::size_t>(rows.Total()) : 0);
+  MPI_Gatherv(local_lengths.data(), local.rows, MPI_INT, packed_lengths.data(), rows.Counts().data(),
+              rows.Displs().data(), MPI_INT, root, comm);
+  std::vector<int> nnz_counts(is_root ? static_cast<std::size_t>(rows.Parts()) : 0);
+  std::vector<int> nnz_displs(nnz_counts.size());
+  for (std::size_t part = 0; part < nnz_counts.size(); part++) {
+    const auto first = packed_lengths.begin() + rows.Offset(static_cast<int>(part));
+    nnz_counts[part] = std::reduce(first, first + rows.Count(static_cast<int>(part)));
+  }
+  std::exclusive_scan(nnz_counts.begin(), nnz_counts.end(), nnz_displs.begin(), 0);
+  const auto total_nnz = static_cast<std::size_t>(std::reduce(nnz_counts.begin(), nnz_counts.end()));
+  std::vector<int> packed_cols(total_nnz);
+  std::vector<Value> packed_values(total_nnz);
+  const int local_nnz = local.row_ptr.back() - local.row_ptr.front();
+  MPI_Gatherv(local.col_idx.data() + local.row_ptr.front(), local_nnz, MPI_INT, packed_cols.data(),
+              nnz_counts.data(), nnz_displs.data(), MPI_INT, root, comm);
+  MPI_Gatherv(local.values.data() + local.row_ptr.front(), local_nnz, MpiTypeOf<Value>(), packed_values.data(),
+              nnz_counts.data(), nnz_displs.data(), MpiTypeOf<Value>(), root, comm);
+
+  CsrMatrix<Value> result;
+  if (!is_root) {
+    return result;
+  }
+  result.rows = rows.Total();
+  result.cols = local.cols;
+  result.row_ptr.assign(static_cast<std::size_t>(result.rows) + 1, 0);
+  for (int part = 0; part < rows.Parts(); part++) {
+    for (int row = 0; row < rows.Count(part); row++) {
+      result.row_ptr[static_cast<std::size_t>(rows.GlobalIndex(part, row)) + 1] =
+          packed_lengths[static_cast<std::size_t>(rows.Offset(part) + row)];
+    }
+  }
+  std::partial_sum(result.row_ptr.begin(), result.row_ptr.end(), result.row_ptr.begin());
+  result.col_idx.resize(total_nnz);
+  result.values.resize(total_nnz);
+  for (int part = 0; part < rows.Parts(); part++) {
+    int read = nnz_displs[static_cast<std::size_t>(part)];
+    for (int row = 0; row < rows.Count(part); row++) {
+      const int length = packed_lengths[static_cast<std::size_t>(rows.Offset(part) + row)];
+      const int write = result.row_ptr[static_cast<std::size_t>(rows.GlobalIndex(part, row))];
+      std::copy_n(packed_cols.begin() + read, length, result.col_idx.begin() + write);
+      std::copy_n(packed_values.begin() + read, length, result.values.begin() + write);
+      read += length;
+    }
+  }
+  return result;
+}
+
+}  // namespace ppc::util
@@ -0,0 +1,255 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace ppc::util {
+
+/// @brief Element type of the weights section of a CSR snapshot.
+enum class CsrWeightType : std::uint32_t { kInt32 = 1, kInt64 = 2, kFloat32 = 3, kFloat64 = 4 };
+
+template <typename T>
+constexpr CsrWeightType CsrWeightTypeOf() {
+  if constexpr (std::is_same_v<T, std::int32_t>) {
+    return CsrWeightType::kInt32;
+  } else if constexpr (std::is_same_v<T, std::int64_t>) {
+    return CsrWeightType::kInt64;
+  } else if constexpr (std::is_same_v<T, float>) {
+    return CsrWeightType::kFloat32;
+  } else {
+    static_assert(std::is_same_v<T, double>, "CSR snapshot weights are int32, int64, float or double");
+    return CsrWeightType::kFloat64;
+  }
+}
+
+/// @brief Fixed 64-byte header at the start of a CSR snapshot file.
+/// @details A snapshot is this header followed by three sections, each starting at a 64-byte aligned offset:
+///          row_ptr (vertices + 1 int32), col_idx (edges int32) and weights (edges values of weight_type). All
+///          values are little-endian, so a mapped file is used in place without parsing.
+struct CsrSnapshotHeader {
+  static constexpr std::array<char, 8> kMagic = {'P', 'P', 'C', 'C', 'S', 'R', '\0', '\0'};
+  static constexpr std::uint32_t kVersion = 1;
+
+  std::array<char, 8> magic = kMagic;
+  std::uint32_t version = kVersion;
+  CsrWeightType weight_type = CsrWeightType::kInt32;
+  std::int64_t vertices = 0;
+  std::int64_t edges = 0;
+  /// @brief Suggested source vertex of shortest-path runs.
+  std::int64_t source = 0;
+  std::uint64_t row_ptr_offset = 0;
+  std::uint64_t col_idx_offset = 0;
+  std::uint64_t weights_offset = 0;
+};
+static_assert(sizeof(CsrSnapshotHeader) == 64 && std::is_trivially_copyable_v<CsrSnapshotHeader>);
+
+/// @brief Memory mapping of a whole file; unmapped on destruction.
+class MappedFile {
+ public:
+  MappedFile() = default;
+  ~MappedFile();
+
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+  MappedFile(MappedFile &&other) noexcept;
+  MappedFile &operator=(MappedFile &&other) noexcept;
+
+  /// @throws std::runtime_error If the file cannot be opened or mapped.
+  static MappedFile OpenReadOnly(const std::filesystem::path &path);
+  /// @brief Creates (or truncates) the file with the given size and maps it writable.
+  /// @throws std::runtime_error If the file cannot be created or mapped.
+  static MappedFile Create(const std::filesystem::path &path, std::size_t bytes);
+
+  [[nodiscard]] std::byte *Data() const {
+    return data_;
+  }
+
+  [[nodiscard]] std::size_t Size() const {
+    return size_;
+  }
+
+ private:
+  void Release();
+
+  std::byte *data_ = nullptr;
+  std::size_t size_ = 0;
+#ifdef _WIN32
+  void *file_ = nullptr;
+  void *mapping_ = nullptr;
+#endif
+};
+
+/// @brief Read-only CSR graph backed by a memory-mapped snapshot file.
+/// @details Opening checks the header, the section bounds and, in one linear scan, the row offsets and column
+///          indices. Nothing is parsed or copied, and the spans stay valid while the snapshot lives.
+class CsrSnapshot {
+ public:
+  /// @throws std::runtime_error If the file is missing, truncated, not a snapshot of this version or its arrays do
+  ///         not form a CSR graph.
+  static CsrSnapshot Open(const std::filesystem::path &path);
+
+  [[nodiscard]] const CsrSnapshotHeader &Header() const {
+    return header_;
+  }
+
+  [[nodiscard]] int Vertices() const {
+    return static_cast<int>(header_.vertices);
+  }
+
+  [[nodiscard]] std::int64_t Edges() const {
+    return header_.edges;
+  }
+
+  [[nodiscard]] int Source() const {
+    return static_cast<int>(header_.source);
+  }
+
+  [[nodiscard]] std::span<const int> RowPtr() const {
+    return Section<int>(header_.row_ptr_offset, static_cast<std::size_t>(header_.vertices) + 1);
+  }
+
+  [[nodiscard]] std::span<const int> ColIdx() const {
+    return Section<int>(header_.col_idx_offset, static_cast<std::size_t>(header_.edges));
+  }
+
+  /// @brief Weights in place; the stored type must be W.
+  template <typename W>
+  [[nodiscard]] std::span<const W> Weights() const {
+    if (header_.weight_type != CsrWeightTypeOf<W>()) {
+      throw std::runtime_error("CsrSnapshot: the weights are stored as another type");
+    }
+    return Section<W>(header_.weights_offset, static_cast<std::size_t>(header_.edges));
+  }
+
+  /// @brief Weights converted to W, for tasks whose weight type differs from the stored one.
+  template <typename W>
+  [[nodiscard]] std::vector<W> CopyWeights() const {
+    switch (header_.weight_type) {
+      case CsrWeightType::kInt32:
+        return Convert<W, std::int32_t>();
+      case CsrWeightType::kInt64:
+        return Convert<W, std::int64_t>();
+      case CsrWeightType::kFloat32:
+        return Convert<W, float>();
+      case CsrWeightType::kFloat64:
+        return Convert<W, double>();
+    }
+    throw std::runtime_error("CsrSnapshot: unknown weight type");
+  }
+
+ private:
+  template <typename T>
+  [[nodiscard]] std::span<const T> Section(std::uint64_t offset, std::size_t count) const {
+    return {reinterpret_cast<const T *>(file_.Data() + offset), count};
+  }
+
+  template <typename W, typename Stored>
+  [[nodiscard]] std::vector<W> Convert() const {
+    const auto stored = Section<Stored>(header_.weights_offset, static_cast<std::size_t>(header_.edges));
+    std::vector<W> weights(stored.size());
+    for (std::size_t i = 0; i < stored.size(); i++) {
+      weights[i] = static_cast<W>(stored[i]);
+    }
+    return weights;
+  }
+
+  MappedFile file_;
+  CsrSnapshotHeader header_;
+};
+
+namespace detail {
+
+void WriteCsrSnapshot(const std::filesystem::path &path, std::span<const int> row_ptr, std::span<const int> col_idx,
+                      const void *weights, CsrWeightType weight_type, int source);
+
+}  // namespace detail
+
+/// @brief Writes a CSR graph as a snapshot.
+/// @throws std::runtime_error If the arrays do not form a CSR graph or the file cannot be written.
+template <typename W>
+void WriteCsrSnapshot(const std::filesystem::path &path, std::span<const int> row_ptr, std::span<const int> col_idx,
+                      std::span<const W> weights, int source = 0) {
+  if (weights.size() != col_idx.size()) {
+    throw std::runtime_error("WriteCsrSnapshot: col_idx and weights differ in length");
+  }
+  detail::WriteCsrSnapshot(path, row_ptr, col_idx, weights.data(), CsrWeightTypeOf<W>(), source);
+}
+
+/// @brief Random graph models of GenerateCsrSnapshot().
+enum class GraphModel : std::uint8_t {
+  /// Every edge joins two uniformly random vertices (G(n, m))
+  kErdosRenyi,
+  /// Recursive matrix: each edge descends into one of four adjacency quadrants with probabilities a, b, c and
+  /// 1 - a - b - c, giving the skewed degrees of web and social graphs
+  kRmat
+};
+
+struct GraphGeneratorOptions {
+  GraphModel model = GraphModel::kRmat;
+  int vertices = 0;
+  std::int64_t edges = 0;
+  /// @brief Weights are uniform in [min_weight, max_weight]; integers include both ends.
+  double min_weight = 1.0;
+  double max_weight = 100.0;
+  std::uint64_t seed = 1;
+  int source = 0;
+  /// @brief R-MAT quadrant probabilities (Graph500 defaults).
+  double a = 0.57;
+  double b = 0.19;
+  double c = 0.19;
+};
+
+/// @brief Generates a random graph straight into a snapshot file.
+/// @details Edges are drawn twice from the same seeded stream, first to count the out-degrees and then to fill the
+///          mapped sections, so memory beyond the file mapping is one counter per vertex even at 10^8 edges. The
+///          result depends only on the options, not on the platform or standard library.
+/// @throws std::runtime_error On invalid options or if the file cannot be written.
+void GenerateCsrSnapshot(const std::filesystem::path &path, const GraphGeneratorOptions &options,
+                         CsrWeightType weight_type = CsrWeightType::kInt32);
+
+/// @brief Converts a text edge list into a snapshot.
+/// @details The text holds "vertices edges", then one "from to weight" line per edge and an optional source
+///          vertex (the format of the graph files in tasks/<task>/data). Edges keep their file order within a row.
+/// @throws std::runtime_error If the text is malformed or a file cannot be accessed.
+void ConvertEdgeListToCsrSnapshot(const std::filesystem::path &text_path, const std::filesystem::path &snapshot_path,
+                                  CsrWeightType weight_type = CsrWeightType::kInt32);
+
+/// @brief Snapshot of a text edge list kept in the temporary directory, converted on first use and again whenever
+///        the text is newer; safe to call from several ranks at once.
+/// @return Path of the snapshot.
+std::filesystem::path CachedEdgeListSnapshot(const std::filesystem::path &text_path,
+                                             CsrWeightType weight_type = CsrWeightType::kInt32);
+
+/// @brief Generated graph kept in the temporary directory, generated on first use; safe to call from several ranks
+///        at once.
+/// @return Path of the snapshot.
+std::filesystem::path CachedGeneratedSnapshot(const GraphGeneratorOptions &options,
+                                              CsrWeightType weight_type = CsrWeightType::kInt32);
+
+/// @brief Graph requested through PPC_PERF_GRAPH for performance tests of graph tasks.
+/// @details The value is a snapshot path, or "rmat:<vertices>:<edges>[:<seed>]" or "er:<vertices>:<edges>[:<seed>]"
+///          for a generated graph cached in the temporary directory.
+/// @return Path of the snapshot, or nullopt if PPC_PERF_GRAPH is unset.
+/// @throws std::runtime_error If the value is malformed.
+std::optional<std::filesystem::path> GetPerfGraphSnapshot(CsrWeightType weight_type = CsrWeightType::kInt32);
+
+/// @brief Runs make on the first rank of every node of comm and hands its result to the other ranks of that node.
+/// @details Collective over comm. The snapshot cache lives in the node-local temporary directory, so one rank per
+///          node generates or converts the graph while the others wait for the written file, instead of every rank
+///          building the same snapshot at once.
+/// @return The path returned by make on the node leader.
+/// @throws std::runtime_error On every rank of a node whose leader failed in make.
+std::optional<std::filesystem::path> PrepareSnapshotPerNode(
+    MPI_Comm comm, const std::function<std::optional<std::filesystem::path>()> &make);
+
+}  // namespace ppc::util
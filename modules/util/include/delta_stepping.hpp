@@ -0,0 +1,228 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "util/include/local_csr.hpp"
+#include "util/include/partition.hpp"
+#include "util/include/scatter_gather.hpp"
+
+namespace ppc::util {
+
+/// @brief Distributed single-source shortest paths by delta-stepping (Meyer & Sanders).
+/// @details Vertices are split between the ranks of comm by a contiguous Partition. Tentative distances live in
+///          buckets of width delta; the ranks settle the globally smallest non-empty bucket together, first
+///          relaxing light edges (weight <= delta) until the bucket stays empty, then the heavy edges of every
+///          vertex settled in it. Relaxations of vertices owned by other ranks are sent as sparse (vertex,
+///          distance) requests with one MPI_Alltoallv per round, so communication follows the frontier instead of
+///          the number of vertices. Weights must be non-negative.
+/// @tparam Weight Arithmetic edge weight and distance type; unreachable vertices get Unreachable().
+template <typename Weight>
+class DeltaSteppingSssp {
+  static_assert(std::is_arithmetic_v<Weight>, "Delta-stepping needs arithmetic weights");
+
+ public:
+  /// @brief Collective over comm.
+  /// @param delta Bucket width; a non-positive value picks max weight / average degree.
+  DeltaSteppingSssp(LocalCsr<Weight> graph, Partition vertices, MPI_Comm comm, Weight delta = Weight{})
+      : graph_(graph), vertices_(std::move(vertices)), comm_(comm) {
+    MPI_Comm_rank(comm_, &rank_);
+    MPI_Comm_size(comm_, &size_);
+    if (vertices_.Parts() != size_ || !vertices_.IsContiguous() ||
+        graph_.offsets.size() != static_cast<std::size_t>(vertices_.Count(rank_)) + 1) {
+      throw std::runtime_error("DeltaSteppingSssp: the local rows do not match a contiguous vertex partition");
+    }
+    ChooseDelta(delta);
+  }
+
+  [[nodiscard]] static constexpr Weight Unreachable() {
+    if constexpr (std::numeric_limits<Weight>::has_infinity) {
+      return std::numeric_limits<Weight>::infinity();
+    } else {
+      return std::numeric_limits<Weight>::max();
+    }
+  }
+
+  [[nodiscard]] Weight GetDelta() const {
+    return delta_;
+  }
+
+  /// @brief Computes the distances from source; collective over comm.
+  /// @return Distances of the vertices owned by this rank, in local order.
+  std::vector<Weight> Run(int source) {
+    if (source < 0 || source >= vertices_.Total()) {
+      throw std::runtime_error("DeltaSteppingSssp: source vertex out of range");
+    }
+    dist_.assign(static_cast<std::size_t>(vertices_.Count(rank_)), Unreachable());
+    buckets_.assign(bucket_slots_, {});
+    outbox_.assign(static_cast<std::size_t>(size_), {});
+    settled_mark_.assign(dist_.size(), 0);
+    frontier_mark_.assign(dist_.size(), 0);
+    if (vertices_.Owner(source) == rank_) {
+      Relax(vertices_.LocalIndex(source), Weight{});
+    }
+
+    for (std::uint64_t bucket = NextBucket(0); bucket != kNoBucket; bucket = NextBucket(bucket + 1)) {
+      SettleBucket(bucket);
+    }
+    return std::move(dist_);
+  }
+
+ private:
+  struct Request {
+    int vertex;
+    Weight distance;
+  };
+
+  static constexpr std::uint64_t kNoBucket = std::numeric_limits<std::uint64_t>::max();
+
+  void ChooseDelta(Weight delta) {
+    Weight local_max = Weight{};
+    Weight local_min = Weight{};
+    for (const Weight weight : graph_.weights.subspan(
+             static_cast<std::size_t>(graph_.offsets.front()),
+             static_cast<std::size_t>(graph_.offsets.back() - graph_.offsets.front()))) {
+      local_max = std::max(local_max, weight);
+      local_min = std::min(local_min, weight);
+    }
+    std::int64_t local_edges = graph_.offsets.back() - graph_.offsets.front();
+    std::int64_t edges = 0;
+    MPI_Allreduce(&local_max, &max_weight_, 1, MpiTypeOf<Weight>(), MPI_MAX, comm_);
+    Weight min_weight = Weight{};
+    MPI_Allreduce(&local_min, &min_weight, 1, MpiTypeOf<Weight>(), MPI_MIN, comm_);
+    MPI_Allreduce(&local_edges, &edges, 1, MPI_INT64_T, MPI_SUM, comm_);
+    if (min_weight < Weight{}) {
+      throw std::runtime_error("DeltaSteppingSssp: negative edge weights are not supported");
+    }
+
+    delta_ = delta;
+    if (!(delta_ > Weight{})) {
+      const double average_degree =
+          vertices_.Total() > 0 ? static_cast<double>(edges) / static_cast<double>(vertices_.Total()) : 0.0;
+      delta_ = static_cast<Weight>(static_cast<double>(max_weight_) / std::max(1.0, average_degree));
+    }
+    if (!(delta_ > Weight{})) {
+      delta_ = Weight{1};
+    }
+    // Tentative distances never run further than max_weight_ past the current bucket, so a ring of buckets suffices
+    bucket_slots_ = static_cast<std::size_t>(static_cast<double>(max_weight_) / static_cast<double>(delta_)) + 3;
+  }
+
+  [[nodiscard]] std::uint64_t BucketOf(Weight distance) const {
+    return static_cast<std::uint64_t>(distance / delta_);
+  }
+
+  std::vector<int> &Slot(std::uint64_t bucket) {
+    return buckets_[static_cast<std::size_t>(bucket % bucket_slots_)];
+  }
+
+  void Relax(int local, Weight distance) {
+    auto &current = dist_[static_cast<std::size_t>(local)];
+    if (distance < current) {
+      current = distance;
+      Slot(BucketOf(distance)).push_back(local);
+    }
+  }
+
+  /// @brief Smallest non-empty bucket at or after from over all ranks, dropping stale entries on the way.
+  std::uint64_t NextBucket(std::uint64_t from) {
+    std::uint64_t local = kNoBucket;
+    for (std::uint64_t bucket = from; bucket < from + bucket_slots_ && local == kNoBucket; bucket++) {
+      auto &slot = Slot(bucket);
+      std::erase_if(slot, [&](int v) { return BucketOf(dist_[static_cast<std::size_t>(v)]) != bucket; });
+      if (!slot.empty()) {
+        local = bucket;
+      }
+    }
+    std::uint64_t global = kNoBucket;
+    MPI_Allreduce(&local, &global, 1, MPI_UINT64_T, MPI_MIN, comm_);
+    return global;
+  }
+
+  void SettleBucket(std::uint64_t bucket) {
+    std::vector<int> settled;
+    std::vector<int> frontier;
+    ++round_stamp_;
+    int active = 1;
+    while (active != 0) {
+      frontier.clear();
+      std::swap(frontier, Slot(bucket));
+      ++frontier_stamp_;
+      for (const int v : frontier) {
+        const auto index = static_cast<std::size_t>(v);
+        // A vertex improved twice in one round is queued twice but relaxes once with its latest distance
+        if (BucketOf(dist_[index]) != bucket || frontier_mark_[index] == frontier_stamp_) {
+          continue;
+        }
+        frontier_mark_[index] = frontier_stamp_;
+        if (settled_mark_[index] != round_stamp_) {
+          settled_mark_[index] = round_stamp_;
+          settled.push_back(v);
+        }
+        RelaxEdges(v, true);
+      }
+      ExchangeRequests();
+      int local_active = Slot(bucket).empty() ? 0 : 1;
+      MPI_Allreduce(&local_active, &active, 1, MPI_INT, MPI_MAX, comm_);
+    }
+    for (const int v : settled) {
+      RelaxEdges(v, false);
+    }
+    ExchangeRequests();
+  }
+
+  void RelaxEdges(int local, bool light) {
+    const Weight distance = dist_[static_cast<std::size_t>(local)];
+    const auto begin = static_cast<std::size_t>(graph_.offsets[static_cast<std::size_t>(local)]);
+    const auto end = static_cast<std::size_t>(graph_.offsets[static_cast<std::size_t>(local) + 1]);
+    for (std::size_t edge = begin; edge < end; edge++) {
+      const Weight weight = graph_.weights[edge];
+      const int target = graph_.columns[edge];
+      if ((weight <= delta_) != light || target < 0 || target >= vertices_.Total()) {
+        continue;
+      }
+      const int owner = vertices_.Owner(target);
+      if (owner == rank_) {
+        Relax(target - vertices_.Offset(rank_), distance + weight);
+      } else {
+        outbox_[static_cast<std::size_t>(owner)].push_back({.vertex = target, .distance = distance + weight});
+      }
+    }
+  }
+
+  void ExchangeRequests() {
+    for (const auto &request : ExchangeOutbox(outbox_, comm_)) {
+      Relax(request.vertex - vertices_.Offset(rank_), request.distance);
+    }
+  }
+
+  LocalCsr<Weight> graph_;
+  Partition vertices_;
+  MPI_Comm comm_;
+  int rank_ = 0;
+  int size_ = 1;
+  Weight delta_{};
+  Weight max_weight_{};
+  std::size_t bucket_slots_ = 1;
+
+  std::vector<Weight> dist_;
+  /// @brief Ring of buckets of local vertex ids; entries whose distance moved to another bucket are stale.
+  std::vector<std::vector<int>> buckets_;
+  /// @brief Pending relaxation requests per owner rank.
+  std::vector<std::vector<Request>> outbox_;
+  /// @brief Stamps marking the vertices settled in the current bucket and relaxed in the current round.
+  std::vector<std::uint32_t> settled_mark_;
+  std::vector<std::uint32_t> frontier_mark_;
+  std::uint32_t round_stamp_ = 0;
+  std::uint32_t frontier_stamp_ = 0;
+};
+
+}  // namespace ppc::util
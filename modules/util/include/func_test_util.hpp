@@ -14,6 +14,7 @@
 #include <utility>
 
 #include "task/include/task.hpp"
+#include "util/include/task_groups.hpp"
 #include "util/include/util.hpp"
 
 namespace ppc::util {
@@ -94,6 +95,7 @@ class BaseRunFuncTests : public ::testing::TestWithParam<FuncTestParam<InType, O
   /// @brief Initializes task instance and runs it through the full pipeline.
   void InitializeAndRunTask(const FuncTestParam<InType, OutType, TestType> &test_param) {
     task_ = std::get<static_cast<std::size_t>(GTestParamIndex::kTaskGetter)>(test_param)(GetTestInputData());
+    AssignTaskGroup(*task_);
     ExecuteTaskPipeline();
   }
 
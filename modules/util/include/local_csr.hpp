@@ -0,0 +1,18 @@
+#pragma once
+
+#include <span>
+
+namespace ppc::util {
+
+/// @brief CRS rows of the vertices owned by one rank.
+/// @details The edges of local vertex v are columns[offsets[v] .. offsets[v + 1]) with the matching weights, so
+///          offsets has one entry more than the rank owns vertices and may index into the edge arrays of the whole
+///          graph (offsets[0] does not have to be 0). Columns are global vertex ids.
+template <typename Weight>
+struct LocalCsr {
+  std::span<const int> offsets;
+  std::span<const int> columns;
+  std::span<const Weight> weights;
+};
+
+}  // namespace ppc::util
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <cstddef>
+#include <span>
+#include <type_traits>
+
+namespace ppc::util {
+
+/// @brief Read-only bytes of the root rank shared by all ranks of a node through an MPI-3 shared-memory window.
+/// @details The constructor is collective over comm. Every node gets a single segment owned by its leader (the root
+///          leads its own node), the leaders receive the bytes with one broadcast, and the other ranks of the node
+///          map the leader's segment. Memory use and copy time per node therefore do not grow with the number of
+///          ranks on it, unlike an MPI_Bcast into a private buffer on every rank.
+/// @note Destruction frees the window and is collective over the node: all ranks must destroy their buffers in the
+///       same order, before MPI_Finalize.
+class NodeSharedBuffer {
+ public:
+  NodeSharedBuffer() = default;
+
+  /// @param root_data Bytes to share; only read on the root.
+  /// @param bytes Number of bytes; only read on the root.
+  /// @param comm Communicator whose ranks take part.
+  /// @param root Rank of comm that holds the data.
+  NodeSharedBuffer(const void *root_data, std::size_t bytes, MPI_Comm comm, int root = 0);
+  ~NodeSharedBuffer();
+
+  NodeSharedBuffer(const NodeSharedBuffer &) = delete;
+  NodeSharedBuffer &operator=(const NodeSharedBuffer &) = delete;
+  NodeSharedBuffer(NodeSharedBuffer &&other) noexcept;
+  NodeSharedBuffer &operator=(NodeSharedBuffer &&other) noexcept;
+
+  [[nodiscard]] const std::byte *Data() const {
+    return data_;
+  }
+
+  [[nodiscard]] std::size_t Size() const {
+    return size_;
+  }
+
+  /// @brief True on the rank that owns the segment of its node.
+  [[nodiscard]] bool IsNodeLeader() const {
+    return node_leader_;
+  }
+
+ private:
+  void Release();
+
+  const std::byte *data_ = nullptr;
+  std::size_t size_ = 0;
+  bool node_leader_ = false;
+  MPI_Win win_ = MPI_WIN_NULL;
+  MPI_Comm node_comm_ = MPI_COMM_NULL;
+};
+
+/// @brief Typed read-only view of a NodeSharedBuffer, e.g. a CSR array broadcast from rank 0.
+/// @tparam T Trivially copyable element type.
+template <typename T>
+class NodeSharedArray {
+  static_assert(std::is_trivially_copyable_v<T>, "NodeSharedArray elements are copied as raw bytes");
+
+ public:
+  NodeSharedArray() = default;
+
+  /// @brief Collective over comm; root_data is only read on the root.
+  NodeSharedArray(std::span<const T> root_data, MPI_Comm comm, int root = 0)
+      : buffer_(root_data.data(), root_data.size_bytes(), comm, root) {}
+
+  [[nodiscard]] std::span<const T> View() const {
+    return {Data(), Size()};
+  }
+
+  [[nodiscard]] const T *Data() const {
+    return reinterpret_cast<const T *>(buffer_.Data());
+  }
+
+  [[nodiscard]] std::size_t Size() const {
+    return buffer_.Size() / sizeof(T);
+  }
+
+  const T &operator[](std::size_t index) const {
+    return Data()[index];
+  }
+
+ private:
+  NodeSharedBuffer buffer_;
+};
+
+}  // namespace ppc::util
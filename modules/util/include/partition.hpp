@@ -0,0 +1,132 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace ppc::util {
+
+/// @brief Assignment of the indices [0, total) of a one-dimensional range (vector elements, matrix rows or columns,
+///        graph vertices) to parts, usually the ranks of a communicator.
+/// @details Part p holds Count(p) indices stored at Offset(p) of the part-major ("packed") order, so Counts() and
+///          Displs() can be passed to MPI_Scatterv and friends as they are. Block and weighted partitions are
+///          contiguous: the packed order is the original order. Cyclic and block-cyclic partitions interleave the
+///          parts and are converted with Pack() and Unpack(); the typed collectives of scatter_gather.hpp do that
+///          internally.
+class Partition {
+ public:
+  Partition() = default;
+
+  /// @brief Contiguous blocks of total / parts indices; the first total % parts parts get one more.
+  static Partition Block(int total, int parts);
+  /// @brief Index i belongs to part i % parts.
+  static Partition Cyclic(int total, int parts);
+  /// @brief Blocks of block_size consecutive indices dealt round-robin to the parts.
+  static Partition BlockCyclic(int total, int parts, int block_size);
+  /// @brief Contiguous blocks sized in proportion to non-negative weights (largest remainder rounding).
+  static Partition Weighted(int total, std::span<const double> weights);
+
+  [[nodiscard]] int Total() const {
+    return total_;
+  }
+
+  [[nodiscard]] int Parts() const {
+    return static_cast<int>(counts_.size());
+  }
+
+  [[nodiscard]] int Count(int part) const {
+    return counts_[static_cast<std::size_t>(part)];
+  }
+
+  [[nodiscard]] int Offset(int part) const {
+    return displs_[static_cast<std::size_t>(part)];
+  }
+
+  [[nodiscard]] const std::vector<int> &Counts() const {
+    return counts_;
+  }
+
+  [[nodiscard]] const std::vector<int> &Displs() const {
+    return displs_;
+  }
+
+  /// @brief True if every part is one range of the original order (block and weighted partitions).
+  [[nodiscard]] bool IsContiguous() const {
+    return block_size_ == 0;
+  }
+
+  /// @brief Part holding the global index.
+  [[nodiscard]] int Owner(int index) const;
+  /// @brief Position of the global index inside its part.
+  [[nodiscard]] int LocalIndex(int index) const;
+  /// @brief Global index of the local position of a part.
+  [[nodiscard]] int GlobalIndex(int part, int local) const;
+
+  /// @brief Widens every part of a contiguous partition by halo indices on both sides, clipped to [0, Total()).
+  /// @details The parts of the result overlap, so it describes what every rank holds after a halo exchange (the
+  ///          ghost columns of a stencil, see ExchangeColumnHalos()), never the buffer of a collective: MPI forbids a
+  ///          scatter from reading a root location twice. Owner() and LocalIndex() are meaningless for it.
+  [[nodiscard]] Partition WithHalo(int halo) const;
+
+  /// @brief Reorders data of Total() elements into the packed order.
+  template <typename T>
+  [[nodiscard]] std::vector<T> Pack(std::span<const T> data) const {
+    CheckSize(data.size());
+    if (IsContiguous()) {
+      return {data.begin(), data.end()};
+    }
+    std::vector<T> packed(data.size());
+    ForEachBlock([&](int begin, int end, std::size_t packed_begin) {
+      std::copy(data.begin() + begin, data.begin() + end, packed.begin() + static_cast<std::ptrdiff_t>(packed_begin));
+    });
+    return packed;
+  }
+
+  /// @brief Inverse of Pack(): writes packed elements back to their global positions in data.
+  template <typename T>
+  void Unpack(std::span<const T> packed, std::span<T> data) const {
+    CheckSize(packed.size());
+    CheckSize(data.size());
+    if (IsContiguous()) {
+      std::ranges::copy(packed, data.begin());
+      return;
+    }
+    ForEachBlock([&](int begin, int end, std::size_t packed_begin) {
+      const auto first = packed.begin() + static_cast<std::ptrdiff_t>(packed_begin);
+      std::copy(first, first + (end - begin), data.begin() + begin);
+    });
+  }
+
+ private:
+  Partition(int total, std::vector<int> counts, std::vector<int> displs, int block_size);
+  static std::vector<int> PrefixSums(const std::vector<int> &counts);
+
+  void CheckSize(std::size_t size) const {
+    if (size != static_cast<std::size_t>(total_)) {
+      throw std::runtime_error("Partition: data size does not match the partitioned range");
+    }
+  }
+
+  /// @brief Calls fn(begin, end, packed_begin) for every block of a block-cyclic partition.
+  template <typename Fn>
+  void ForEachBlock(Fn &&fn) const {
+    const int parts = Parts();
+    for (int begin = 0, block = 0; begin < total_; begin += block_size_, block++) {
+      const int part = block % parts;
+      const auto packed_begin =
+          static_cast<std::size_t>(displs_[static_cast<std::size_t>(part)]) +
+          (static_cast<std::size_t>(block / parts) * static_cast<std::size_t>(block_size_));
+      fn(begin, std::min(total_, begin + block_size_), packed_begin);
+    }
+  }
+
+  int total_ = 0;
+  /// @brief Size of the dealt blocks, 0 for contiguous partitions.
+  int block_size_ = 0;
+  std::vector<int> counts_;
+  std::vector<int> displs_;
+};
+
+}  // namespace ppc::util
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <compare>
+#include <cstddef>
+#include <map>
+#include <string>
+
+#include "nlohmann/json_fwd.hpp"
+#include "performance/include/performance.hpp"
+#include "util/include/util.hpp"
+
+namespace ppc::util {
+
+/// @brief Comparison of one scaling sweep point with the SEQ implementation.
+struct ScalingPoint {
+  PerfScalingMode mode = PerfScalingMode::kNone;
+  /// @brief Input size of the SEQ reference run (equals the measured size for strong scaling).
+  std::size_t base_size = 0;
+  /// @brief Number of processes and/or threads used by the measured implementation.
+  int workers = 1;
+  double seq_time_sec = -1.0;
+  /// @brief Strong: T_seq / T_par; weak: scaled speedup workers * T_seq / T_par.
+  double speedup = -1.0;
+  /// @brief Speedup divided by the number of workers.
+  double efficiency = -1.0;
+};
+
+/// @brief Computes speedup and parallel efficiency of a parallel run against the SEQ reference time.
+/// @details Speedup and efficiency stay negative when either time is not positive.
+ScalingPoint MakeScalingPoint(PerfScalingMode mode, std::size_t base_size, int workers, double seq_time_sec,
+                              double par_time_sec);
+
+/// @brief One structured performance measurement as written to the PPC_PERF_OUTPUT file.
+struct PerfRecord {
+  /// @brief Task namespace (e.g., "baranov_a_dijkstra_crs").
+  std::string task;
+  /// @brief Implementation type ("seq", "mpi", "omp", "tbb", "stl", "all").
+  std::string implementation;
+  /// @brief Measurement mode ("pipeline" or "task_run").
+  std::string mode;
+  int num_proc = 1;
+  int num_threads = 1;
+  /// @brief Number of input elements when the input type (or the object it points to) exposes size(), otherwise 0.
+  std::size_t input_size = 0;
+  std::string host;
+  std::string revision;
+  /// @brief CPU binding policy of the run (see PPC_BIND).
+  std::string bind = "none";
+  /// @brief CPUs of every rank after binding (e.g., "0:0-3;1:4-7").
+  std::string core_map;
+  ppc::performance::PerfResults results;
+  /// @brief Filled only for records produced by a PPC_PERF_SCALING sweep.
+  ScalingPoint scaling;
+  /// @brief Number of inputs processed per run by a batch measurement (0 for single-input records).
+  std::size_t batch_size = 0;
+  /// @brief Inputs processed per second by a batch or in-flight measurement.
+  double throughput = 0.0;
+  /// @brief Tasks kept in flight by a PPC_PERF_IN_FLIGHT measurement (0 for other records).
+  int in_flight = 0;
+};
+
+/// @brief CPU binding of the job as applied by the test runner.
+struct ProcessBinding {
+  std::string policy = "none";
+  std::string core_map;
+};
+
+/// @brief Stores the binding reported in perf records; called by the runner after binding.
+void SetProcessBinding(ProcessBinding binding);
+const ProcessBinding &GetProcessBinding();
+
+/// @brief Identifies comparable measurements in a baseline.
+struct PerfRecordKey {
+  std::string task;
+  std::string implementation;
+  std::string mode;
+  int num_proc = 1;
+  int num_threads = 1;
+
+  auto operator<=>(const PerfRecordKey &) const = default;
+};
+
+PerfRecordKey GetPerfRecordKey(const PerfRecord &record);
+
+/// @brief Baseline measurements loaded from a file previously written via PPC_PERF_OUTPUT.
+class PerfBaselineStore {
+ public:
+  /// @brief Loads a JSON Lines file. Later records replace earlier ones with the same key; scaling sweep
+  ///        points are skipped.
+  /// @throws std::runtime_error If the file cannot be opened.
+  static PerfBaselineStore Load(const std::string &path);
+
+  /// @brief Returns the baseline record for the key or nullptr if there is none.
+  [[nodiscard]] const PerfRecord *Find(const PerfRecordKey &key) const;
+  [[nodiscard]] std::size_t Size() const {
+    return records_.size();
+  }
+
+ private:
+  std::map<PerfRecordKey, PerfRecord> records_;
+};
+
+/// @brief Returns the baseline named by PPC_PERF_BASELINE, loaded once per process (empty if unset).
+const PerfBaselineStore &GetPerfBaseline();
+
+/// @brief Returns the relative slowdown of the median treated as a regression (PPC_PERF_REGRESSION_THRESHOLD).
+double GetPerfRegressionThreshold();
+
+/// @brief Checks whether a detected regression fails the performance test (PPC_PERF_FAIL_ON_REGRESSION).
+bool IsPerfRegressionFatal();
+
+/// @brief Returns the path from PPC_PERF_OUTPUT or an empty string when structured output is disabled.
+std::string GetPerfOutputPath();
+
+/// @brief Returns the source revision the binaries were built from ("unknown" if not available).
+std::string GetGitRevision();
+
+/// @brief Converts the record to a flat JSON object including all samples and statistics.
+nlohmann::json PerfRecordToJson(const PerfRecord &record);
+
+/// @brief Restores a record written by PerfRecordToJson (hardware counters and stage times are not restored).
+PerfRecord PerfRecordFromJson(const nlohmann::json &json);
+
+/// @brief Appends the record to the file: CSV (with a header for a new file) if the path ends with
+///        ".csv", JSON Lines otherwise.
+/// @throws std::runtime_error If the file cannot be opened.
+void AppendPerfRecord(const std::string &path, const PerfRecord &record);
+
+template <typename InType>
+std::size_t GetInputSize(const InType &input) {
+  if constexpr (requires { input.size(); }) {
+    return static_cast<std::size_t>(input.size());
+  } else if constexpr (requires { input.get(); (*input).size(); }) {
+    // Shared input views such as ppc::task::SharedInput<T>
+    return input ? static_cast<std::size_t>((*input).size()) : 0;
+  } else {
+    return 0;
+  }
+}
+
+}  // namespace ppc::util
@@ -6,27 +6,91 @@
 #include <chrono>
 #include <csignal>
 #include <cstddef>
+#include <deque>
 #include <functional>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <map>
 #include <sstream>
 #include <stdexcept>
 #include <string>
 #include <tuple>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
+#include "performance/include/perf_compare.hpp"
 #include "performance/include/performance.hpp"
 #include "task/include/task.hpp"
+#include "util/include/perf_report.hpp"
+#include "util/include/task_groups.hpp"
 #include "util/include/util.hpp"
 
 namespace ppc::util {
 
 double GetTimeMPI();
 int GetMPIRank();
+int GetMPIWorldSize();
+void BarrierMPI();
+std::string GetHostName();
+/// @brief Reduces per-rank results over MPI_COMM_WORLD: samples become per-iteration critical-path
+/// times and the rank min/max/mean and load imbalance fields are filled.
+void ReduceRankTimesMPI(ppc::performance::PerfResults &perf_results);
 
 template <typename InType, typename OutType>
 using PerfTestParam = std::tuple<std::function<ppc::task::TaskPtr<InType, OutType>(InType)>, std::string,
                                  ppc::performance::PerfResults::TypeOfRunning>;
 
+template <typename InType, typename OutType>
+/// @brief SEQ task getters of all performance suites keyed by task namespace.
+/// @details Filled by MakePerfTaskTuples() and used as the reference implementation of scaling sweeps.
+class PerfSeqReferences {
+ public:
+  using TaskGetter = std::function<ppc::task::TaskPtr<InType, OutType>(InType)>;
+
+  static void Register(const std::string &task_namespace, TaskGetter task_getter) {
+    Storage()[task_namespace] = std::move(task_getter);
+  }
+
+  /// @brief Returns the registered getter or an empty function if the suite has no SEQ implementation.
+  static TaskGetter Find(const std::string &task_namespace) {
+    const auto it = Storage().find(task_namespace);
+    return it == Storage().end() ? TaskGetter{} : it->second;
+  }
+
+ private:
+  static std::map<std::string, TaskGetter> &Storage() {
+    static std::map<std::string, TaskGetter> storage;
+    return storage;
+  }
+};
+
+template <typename InType, typename OutType>
+/// @brief Batched task getters of all performance suites keyed by test name ("<namespace>_<implementation>_<status>").
+/// @details Filled by MakePerfTaskTuples() and used by the batch measurement.
+class PerfBatchTasks {
+ public:
+  using TaskGetter =
+      std::function<ppc::task::TaskPtr<std::vector<InType>, std::vector<OutType>>(std::vector<InType>)>;
+
+  static void Register(const std::string &test_name, TaskGetter task_getter) {
+    Storage()[test_name] = std::move(task_getter);
+  }
+
+  /// @brief Returns the registered getter or an empty function.
+  static TaskGetter Find(const std::string &test_name) {
+    const auto it = Storage().find(test_name);
+    return it == Storage().end() ? TaskGetter{} : it->second;
+  }
+
+ private:
+  static std::map<std::string, TaskGetter> &Storage() {
+    static std::map<std::string, TaskGetter> storage;
+    return storage;
+  }
+};
+
 template <typename InType, typename OutType>
 /// @brief Base class for performance testing of parallel tasks.
 /// @tparam InType Input data type.
@@ -45,11 +109,36 @@ class BaseRunPerfTests : public ::testing::TestWithParam<PerfTestParam<InType, O
   /// @brief Supplies input data for performance testing.
   virtual InType GetTestInputData() = 0;
 
+  /// @brief Input sizes of the PPC_PERF_SCALING sweep. Suites opt in by overriding it together with
+  ///        GetScaledInputData(); the default disables the sweep.
+  virtual std::vector<std::size_t> GetScalingSizes() {
+    return {};
+  }
+
+  /// @brief Generates input data of the given size for the scaling sweep.
+  virtual InType GetScaledInputData(std::size_t /*size*/) {
+    throw std::runtime_error("GetScaledInputData() must be overridden when GetScalingSizes() is not empty.");
+  }
+
+  /// @brief Inputs of the batch measurement. Suites opt in by overriding it together with
+  ///        CheckBatchOutputData(); the default disables the measurement.
+  virtual std::vector<InType> GetBatchInputData() {
+    return {};
+  }
+
+  /// @brief Verifies the outputs of the batch measurement, one per input of GetBatchInputData().
+  virtual bool CheckBatchOutputData(std::vector<OutType> & /*outputs*/) {
+    return true;
+  }
+
   virtual void SetPerfAttributes(ppc::performance::PerfAttr &perf_attrs) {
+    perf_attrs.hw_counters = IsPerfHwCountersEnabled();
     if (task_->GetDynamicTypeOfTask() == ppc::task::TypeOfTask::kMPI ||
         task_->GetDynamicTypeOfTask() == ppc::task::TypeOfTask::kALL) {
       const double t0 = GetTimeMPI();
       perf_attrs.current_timer = [t0] { return GetTimeMPI() - t0; };
+      perf_attrs.rank_sync = BarrierMPI;
+      perf_attrs.rank_reduce = ReduceRankTimesMPI;
     } else if (task_->GetDynamicTypeOfTask() == ppc::task::TypeOfTask::kOMP) {
       const double t0 = omp_get_wtime();
       perf_attrs.current_timer = [t0] { return omp_get_wtime() - t0; };
@@ -57,7 +146,7 @@ class BaseRunPerfTests : public ::testing::TestWithParam<PerfTestParam<InType, O
                task_->GetDynamicTypeOfTask() == ppc::task::TypeOfTask::kSTL ||
                task_->GetDynamicTypeOfTask() == ppc::task::TypeOfTask::kTBB) {
       const auto t0 = std::chrono::high_resolution_clock::now();
-      perf_attrs.current_timer = [&] {
+      perf_attrs.current_timer = [t0] {
         auto now = std::chrono::high_resolution_clock::now();
         auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(now - t0).count();
         return static_cast<double>(ns) * 1e-9;
@@ -80,10 +169,35 @@ class BaseRunPerfTests : public ::testing::TestWithParam<PerfTestParam<InType, O
     const auto test_env_scope = ppc::util::test::MakePerTestEnvForCurrentGTest(test_name);
 
     task_ = task_getter(GetTestInputData());
+    AssignTaskGroup(*task_);
     ppc::performance::Perf perf(task_);
     ppc::performance::PerfAttr perf_attr;
     SetPerfAttributes(perf_attr);
+    RunPerf(perf, perf_attr, mode);
+
+    if (GetMPIRank() == 0) {
+      perf.PrintPerfStatistic(test_name);
+      const auto record = MakePerfRecord(test_name, perf.GetPerfResults());
+      WritePerfRecord(record);
+      CompareWithBaseline(test_name, record);
+    }
+
+    ASSERT_TRUE(CheckTestOutputData(task_->GetOutput()));
 
+    if (IsPerfColdCacheEnabled()) {
+      RunColdCacheMeasurement(test_name, task_getter, mode);
+    }
+    RunBatchMeasurement(test_name, mode);
+    RunInFlightMeasurement(test_name, task_getter, mode);
+    RunScalingSweep(test_name, task_getter, mode);
+  }
+
+ private:
+  using TaskGetter = std::function<ppc::task::TaskPtr<InType, OutType>(InType)>;
+
+  template <typename PerfType>
+  static void RunPerf(PerfType &perf, const ppc::performance::PerfAttr &perf_attr,
+                      ppc::performance::PerfResults::TypeOfRunning mode) {
     if (mode == ppc::performance::PerfResults::TypeOfRunning::kPipeline) {
       perf.PipelineRun(perf_attr);
     } else if (mode == ppc::performance::PerfResults::TypeOfRunning::kTaskRun) {
@@ -93,16 +207,292 @@ class BaseRunPerfTests : public ::testing::TestWithParam<PerfTestParam<InType, O
       err_msg << '\n' << "The type of performance check for the task was not selected.\n";
       throw std::runtime_error(err_msg.str().c_str());
     }
+  }
+
+  /// @brief Repeats the measurement on a fresh task with caches flushed and the input restored before every
+  ///        iteration; reported as "<mode>_cold" next to the regular warm-cache numbers.
+  void RunColdCacheMeasurement(const std::string &test_name, const TaskGetter &task_getter,
+                               ppc::performance::PerfResults::TypeOfRunning mode) {
+    task_ = task_getter(GetTestInputData());
+    AssignTaskGroup(*task_);
+    ppc::performance::Perf perf(task_);
+    ppc::performance::PerfAttr perf_attr;
+    SetPerfAttributes(perf_attr);
+    perf_attr.flush_cache = true;
+    perf_attr.fresh_input = true;
+    RunPerf(perf, perf_attr, mode);
 
     if (GetMPIRank() == 0) {
       perf.PrintPerfStatistic(test_name);
+      const auto record = MakePerfRecord(test_name, perf.GetPerfResults());
+      WritePerfRecord(record);
+      CompareWithBaseline(test_name, record);
     }
 
-    OutType output_data = task_->GetOutput();
-    ASSERT_TRUE(CheckTestOutputData(output_data));
+    ASSERT_TRUE(CheckTestOutputData(task_->GetOutput()));
+  }
+
+  /// @brief Measures the batched implementation on GetBatchInputData() and reports it as "<mode>_batch" with the
+  ///        number of inputs processed per second. The whole batch is one pipeline run, so a batched implementation
+  ///        pays its per-run communication once per batch.
+  void RunBatchMeasurement(const std::string &test_name, ppc::performance::PerfResults::TypeOfRunning mode) {
+    auto inputs = GetBatchInputData();
+    const auto batch_getter = PerfBatchTasks<InType, OutType>::Find(test_name);
+    if (inputs.empty() || !batch_getter) {
+      return;
+    }
+    const std::size_t batch_size = inputs.size();
+    auto batch_task = batch_getter(std::move(inputs));
+    AssignTaskGroup(*batch_task);
+    ppc::performance::Perf perf(batch_task);
+    ppc::performance::PerfAttr perf_attr;
+    SetPerfAttributes(perf_attr);
+    RunPerf(perf, perf_attr, mode);
+
+    if (GetMPIRank() == 0) {
+      const auto &perf_results = perf.GetPerfResults();
+      auto record = MakePerfRecord(test_name, perf_results);
+      record.mode += "_batch";
+      record.batch_size = batch_size;
+      record.throughput = perf_results.time_sec > 0.0 ? static_cast<double>(batch_size) / perf_results.time_sec : 0.0;
+
+      std::stringstream batch_str;
+      batch_str << std::fixed << std::setprecision(10);
+      batch_str << "size=" << batch_size << ",time=" << perf_results.time_sec << ",throughput=" << record.throughput;
+      std::cout << test_name << ":" << ppc::performance::GetStringParamName(mode) << ":batch:" << batch_str.str()
+                << '\n';
+      WritePerfRecord(record);
+      CompareWithBaseline(test_name, record);
+    }
+
+    ASSERT_TRUE(CheckBatchOutputData(batch_task->GetOutput()));
+  }
+
+  /// @brief Keeps PPC_PERF_IN_FLIGHT tasks running with PipelineAsync() and reports the completed tasks per second
+  ///        as "pipeline_inflight<N>". A new task is created (copying the input) while the others run, so the
+  ///        measurement shows how well preparing the next input overlaps with the runs in flight.
+  /// @details Only the pipeline mode is measured. MPI and hybrid tasks are skipped: concurrent instances would
+  ///          issue collectives on the same communicator from several threads.
+  void RunInFlightMeasurement(const std::string &test_name, const TaskGetter &task_getter,
+                              ppc::performance::PerfResults::TypeOfRunning mode) {
+    const int in_flight = GetPerfInFlight();
+    const auto type = task_->GetDynamicTypeOfTask();
+    if (in_flight == 0 || mode != ppc::performance::PerfResults::TypeOfRunning::kPipeline) {
+      return;
+    }
+    if (type == ppc::task::TypeOfTask::kMPI || type == ppc::task::TypeOfTask::kALL) {
+      if (GetMPIRank() == 0) {
+        std::cout << test_name << ":pipeline:inflight:skipped=" << ppc::task::TypeOfTaskToString(type) << '\n';
+      }
+      return;
+    }
+
+    ppc::performance::PerfAttr perf_attr;
+    SetPerfAttributes(perf_attr);
+    const auto input = GetTestInputData();
+    const auto total = static_cast<std::size_t>(in_flight) * perf_attr.num_running;
+
+    struct InFlightTask {
+      ppc::task::TaskPtr<InType, OutType> task;
+      std::shared_future<bool> done;
+    };
+    std::deque<InFlightTask> window;
+    auto launch = [&] {
+      auto task = task_getter(input);
+      task->GetStateOfTesting() = ppc::task::StateOfTesting::kPerf;
+      auto done = task->PipelineAsync();
+      window.push_back({.task = std::move(task), .done = std::move(done)});
+    };
+
+    ppc::performance::PerfResults perf_results;
+    perf_results.type_of_running = mode;
+    bool outputs_ok = true;
+    std::size_t launched = 0;
+    const double begin = perf_attr.current_timer();
+    double last = begin;
+    for (; launched < std::min(total, static_cast<std::size_t>(in_flight)); launched++) {
+      launch();
+    }
+    while (!window.empty()) {
+      auto finished = std::move(window.front());
+      window.pop_front();
+      outputs_ok = finished.done.get() && outputs_ok;
+      const double now = perf_attr.current_timer();
+      perf_results.samples.push_back(now - last);
+      last = now;
+      if (launched < total) {
+        launch();
+        launched++;
+      }
+      outputs_ok = CheckTestOutputData(finished.task->GetOutput()) && outputs_ok;
+    }
+    // Samples are the intervals between completions, so their mean is the steady-state time per task
+    const double elapsed = last - begin;
+    ppc::performance::CalculateStatistics(perf_results);
+
+    if (GetMPIRank() == 0) {
+      auto record = MakePerfRecord(test_name, perf_results);
+      record.mode += "_inflight" + std::to_string(in_flight);
+      record.in_flight = in_flight;
+      record.throughput = elapsed > 0.0 ? static_cast<double>(total) / elapsed : 0.0;
+
+      std::stringstream in_flight_str;
+      in_flight_str << std::fixed << std::setprecision(10);
+      in_flight_str << "n=" << in_flight << ",tasks=" << total << ",time=" << elapsed
+                    << ",throughput=" << record.throughput;
+      std::cout << test_name << ":pipeline:inflight:" << in_flight_str.str() << '\n';
+      WritePerfRecord(record);
+      CompareWithBaseline(test_name, record);
+    }
+
+    ASSERT_TRUE(outputs_ok);
+  }
+
+  /// @brief Number of processes and/or threads the task of the given type runs on.
+  static int GetNumWorkers(ppc::task::TypeOfTask type) {
+    if (type == ppc::task::TypeOfTask::kSEQ) {
+      return 1;
+    }
+    if (type == ppc::task::TypeOfTask::kMPI) {
+      return GetMPIWorldSize();
+    }
+    if (type == ppc::task::TypeOfTask::kALL) {
+      return GetMPIWorldSize() * GetNumThreads();
+    }
+    return GetNumThreads();
+  }
+
+  /// @brief Extracts the task namespace from "<namespace>_<implementation>_<status>", see MakePerfTaskTuples.
+  [[nodiscard]] std::string GetTaskNamespace(const std::string &test_name) const {
+    const auto implementation = ppc::task::TypeOfTaskToString(task_->GetDynamicTypeOfTask());
+    return test_name.substr(0, test_name.rfind("_" + implementation + "_"));
+  }
+
+  /// @brief Measures a freshly created task on input of the given size.
+  ppc::performance::PerfResults MeasureScaled(const TaskGetter &task_getter, std::size_t size,
+                                              ppc::performance::PerfResults::TypeOfRunning mode) {
+    // SetPerfAttributes() inspects task_, so it has to point to the measured task
+    task_ = task_getter(GetScaledInputData(size));
+    AssignTaskGroup(*task_);
+    ppc::performance::Perf perf(task_);
+    ppc::performance::PerfAttr perf_attr;
+    SetPerfAttributes(perf_attr);
+    RunPerf(perf, perf_attr, mode);
+    return perf.GetPerfResults();
+  }
+
+  /// @brief Runs the PPC_PERF_SCALING sweep and reports speedup and efficiency against the SEQ implementation.
+  /// @details Strong scaling measures both implementations on every size; weak scaling multiplies the size of
+  ///          the measured implementation by the number of workers. Scaled outputs are not verified, the
+  ///          regular measurement covers correctness.
+  void RunScalingSweep(const std::string &test_name, const TaskGetter &task_getter,
+                       ppc::performance::PerfResults::TypeOfRunning mode) {
+    const auto scaling_mode = GetPerfScalingMode();
+    const auto sizes = GetScalingSizes();
+    if (scaling_mode == PerfScalingMode::kNone || sizes.empty()) {
+      return;
+    }
+
+    const auto type = task_->GetDynamicTypeOfTask();
+    const auto task_namespace = GetTaskNamespace(test_name);
+    const int workers = GetNumWorkers(type);
+    const auto seq_getter = PerfSeqReferences<InType, OutType>::Find(task_namespace);
+
+    for (std::size_t base_size : sizes) {
+      const std::size_t size =
+          scaling_mode == PerfScalingMode::kWeak ? base_size * static_cast<std::size_t>(workers) : base_size;
+      const auto perf_results = MeasureScaled(task_getter, size, mode);
+      const auto measured_task = task_;
+
+      double seq_time = -1.0;
+      if (type == ppc::task::TypeOfTask::kSEQ) {
+        seq_time = perf_results.time_sec;
+      } else if (seq_getter) {
+        seq_time = MeasureScaled(seq_getter, base_size, mode).time_sec;
+      }
+      task_ = measured_task;
+
+      if (GetMPIRank() == 0) {
+        const auto point = MakeScalingPoint(scaling_mode, base_size, workers, seq_time, perf_results.time_sec);
+        PrintScalingPoint(test_name, mode, size, perf_results, point);
+        WritePerfRecord(MakePerfRecord(test_name, perf_results, point));
+      }
+    }
+  }
+
+  static void PrintScalingPoint(const std::string &test_name, ppc::performance::PerfResults::TypeOfRunning mode,
+                                std::size_t size, const ppc::performance::PerfResults &perf_results,
+                                const ScalingPoint &point) {
+    std::stringstream point_str;
+    point_str << std::fixed << std::setprecision(10);
+    point_str << "size=" << size << ",workers=" << point.workers << ",time=" << perf_results.time_sec
+              << ",seq_time=" << point.seq_time_sec << ",speedup=" << point.speedup
+              << ",efficiency=" << point.efficiency;
+    std::cout << test_name << ":" << ppc::performance::GetStringParamName(mode)
+              << ":scaling:" << PerfScalingModeToString(point.mode) << ":" << point_str.str() << '\n';
+  }
+
+  [[nodiscard]] PerfRecord MakePerfRecord(const std::string &test_name,
+                                          const ppc::performance::PerfResults &perf_results,
+                                          const ScalingPoint &scaling = {}) const {
+    PerfRecord record;
+    record.implementation = ppc::task::TypeOfTaskToString(task_->GetDynamicTypeOfTask());
+    record.task = GetTaskNamespace(test_name);
+    record.mode = ppc::performance::GetStringParamName(perf_results.type_of_running) +
+                  (perf_results.cold_cache ? "_cold" : "");
+    if (task_->SupportsCommunicator() && GetTaskGroupCount() > 1) {
+      // Concurrent instances on rank groups are not comparable with a single instance on the world
+      record.mode += "_groups" + std::to_string(GetTaskGroupCount());
+    }
+    record.num_proc = GetNumProc();
+    record.num_threads = GetNumThreads();
+    record.input_size = GetInputSize(task_->GetInput());
+    record.host = GetHostName();
+    record.revision = GetGitRevision();
+    record.bind = GetProcessBinding().policy;
+    record.core_map = GetProcessBinding().core_map;
+    record.results = perf_results;
+    record.scaling = scaling;
+    return record;
+  }
+
+  /// @brief Appends the record to PPC_PERF_OUTPUT if it is set.
+  static void WritePerfRecord(const PerfRecord &record) {
+    const auto path = GetPerfOutputPath();
+    if (!path.empty()) {
+      AppendPerfRecord(path, record);
+    }
+  }
+
+  /// @brief Compares the samples with the PPC_PERF_BASELINE record of the same task, implementation, mode and
+  ///        process/thread count. A regression fails the test only with PPC_PERF_FAIL_ON_REGRESSION=1 and only
+  ///        if the baseline was measured on the same host.
+  static void CompareWithBaseline(const std::string &test_name, const PerfRecord &record) {
+    const auto *baseline = GetPerfBaseline().Find(GetPerfRecordKey(record));
+    if (baseline == nullptr) {
+      return;
+    }
+    const double threshold = GetPerfRegressionThreshold();
+    const auto comparison =
+        ppc::performance::ComparePerfSamples(baseline->results.samples, record.results.samples, threshold);
+    const bool same_host = baseline->host == record.host;
+
+    std::stringstream cmp_str;
+    cmp_str << std::fixed << std::setprecision(10);
+    cmp_str << "median=" << comparison.current_median << ",baseline_median=" << comparison.baseline_median
+            << ",change=" << comparison.change << ",p_value=" << comparison.p_value
+            << ",baseline_revision=" << baseline->revision << ",same_host=" << (same_host ? 1 : 0)
+            << ",verdict=" << ppc::performance::GetPerfVerdictName(comparison.verdict);
+    std::cout << test_name << ":" << record.mode << ":baseline:" << cmp_str.str() << '\n';
+
+    if (IsPerfRegressionFatal() && same_host) {
+      EXPECT_FALSE(comparison.verdict == ppc::performance::PerfVerdict::kRegression)
+          << "Median time of " << test_name << " (" << record.mode << ") regressed by " << comparison.change * 100.0
+          << "% against revision " << baseline->revision << " (threshold " << threshold * 100.0
+          << "%, p-value " << comparison.p_value << ")";
+    }
   }
 
- private:
   ppc::task::TaskPtr<InType, OutType> task_;
 };
 
@@ -111,6 +501,17 @@ auto MakePerfTaskTuples(const std::string &settings_path) {
   const auto name = std::string(GetNamespace<TaskType>()) + "_" +
                     ppc::task::GetStringTaskType(TaskType::GetStaticTypeOfTask(), settings_path);
 
+  using OutputType = std::remove_cvref_t<decltype(std::declval<TaskType &>().GetOutput())>;
+  if constexpr (TaskType::GetStaticTypeOfTask() == ppc::task::TypeOfTask::kSEQ) {
+    PerfSeqReferences<InputType, OutputType>::Register(std::string(GetNamespace<TaskType>()),
+                                                       ppc::task::TaskGetter<TaskType, InputType>);
+  }
+  using BatchType = typename ppc::task::BatchTaskOf<TaskType, InputType, OutputType>::Type;
+  // The one-by-one fallback needs to construct a task per input and to default-construct the outputs
+  if constexpr (std::is_constructible_v<TaskType, const InputType &> && std::is_default_constructible_v<OutputType>) {
+    PerfBatchTasks<InputType, OutputType>::Register(name, ppc::task::TaskGetter<BatchType, std::vector<InputType>>);
+  }
+
   return std::make_tuple(std::make_tuple(ppc::task::TaskGetter<TaskType, InputType>, name,
                                          ppc::performance::PerfResults::TypeOfRunning::kPipeline),
                          std::make_tuple(ppc::task::TaskGetter<TaskType, InputType>, name,
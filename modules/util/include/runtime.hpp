@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "oneapi/tbb/task_arena.h"
+#include "util/include/thread_pool.hpp"
+
+namespace ppc::util {
+
+/// @brief What happens to the OpenMP worker threads after every task.
+enum class OmpPoolPolicy : uint8_t {
+  /// Keep the threads alive between tasks
+  kPersistent,
+  /// Release them with omp_pause_resource_all after every task
+  kPause
+};
+
+/// @brief Reads the policy from PPC_OMP_POOL ("persistent", "pause"; default "persistent").
+/// @throws std::runtime_error If the value is not recognized.
+OmpPoolPolicy GetOmpPoolPolicy();
+std::string GetOmpPoolPolicyName(OmpPoolPolicy policy);
+
+/// @brief Owns the worker threads shared by all tasks of the process.
+/// @details The STL thread pool and the TBB arena are created on first use with GetRankThreadBudget()
+///          threads and kept warm until Shutdown(), so task timings do not include thread startup.
+class Runtime {
+ public:
+  /// @brief Returns the shared pool; it is recreated when the thread budget has changed since the last call.
+  /// @note The returned reference stays valid until the next call with a different budget or Shutdown().
+  static ThreadPool &GetThreadPool();
+
+  /// @brief Returns the shared TBB arena; run parallel algorithms inside arena.execute(...).
+  /// @note Recreated under the same conditions as the thread pool.
+  static tbb::task_arena &GetTaskArena();
+
+  /// @brief Sets the OpenMP pool policy applied by ReleaseTaskResources(); the runners pass GetOmpPoolPolicy() once
+  ///        at startup (default kPersistent).
+  static void SetOmpPoolPolicy(OmpPoolPolicy policy);
+
+  /// @brief Applies the OpenMP pool policy; called when a task is destroyed.
+  /// @details While asynchronous task stages are running the pause is deferred until the last of them ends, so it
+  ///          never hits an OpenMP region in flight.
+  static void ReleaseTaskResources() noexcept;
+
+  /// @brief Counts an asynchronous task stage as running (see AsyncStageScope).
+  static void BeginAsyncStage() noexcept;
+  static void EndAsyncStage() noexcept;
+
+  /// @brief Joins the pool threads and terminates the arena.
+  static void Shutdown();
+};
+
+/// @brief Marks an asynchronous task stage as running for the lifetime of the scope.
+class AsyncStageScope {
+ public:
+  AsyncStageScope() noexcept {
+    Runtime::BeginAsyncStage();
+  }
+  ~AsyncStageScope() {
+    Runtime::EndAsyncStage();
+  }
+
+  AsyncStageScope(const AsyncStageScope &) = delete;
+  AsyncStageScope &operator=(const AsyncStageScope &) = delete;
+  AsyncStageScope(AsyncStageScope &&) = delete;
+  AsyncStageScope &operator=(AsyncStageScope &&) = delete;
+};
+
+}  // namespace ppc::util
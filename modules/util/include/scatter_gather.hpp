@@ -0,0 +1,293 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "util/include/partition.hpp"
+
+namespace ppc::util {
+
+template <typename T>
+inline constexpr bool kAlwaysFalse = false;
+
+/// @brief Predefined MPI datatype of an arithmetic element type.
+template <typename T>
+MPI_Datatype MpiTypeOf() {
+  using U = std::remove_cv_t<T>;
+  if constexpr (std::is_same_v<U, double>) {
+    return MPI_DOUBLE;
+  } else if constexpr (std::is_same_v<U, float>) {
+    return MPI_FLOAT;
+  } else if constexpr (std::is_same_v<U, bool>) {
+    return MPI_CXX_BOOL;
+  } else if constexpr (std::is_same_v<U, char>) {
+    return MPI_CHAR;
+  } else if constexpr (std::is_integral_v<U> && std::is_signed_v<U> && sizeof(U) == 1) {
+    return MPI_INT8_T;
+  } else if constexpr (std::is_integral_v<U> && std::is_signed_v<U> && sizeof(U) == 2) {
+    return MPI_INT16_T;
+  } else if constexpr (std::is_integral_v<U> && std::is_signed_v<U> && sizeof(U) == 4) {
+    return MPI_INT32_T;
+  } else if constexpr (std::is_integral_v<U> && std::is_signed_v<U> && sizeof(U) == 8) {
+    return MPI_INT64_T;
+  } else if constexpr (std::is_integral_v<U> && sizeof(U) == 1) {
+    return MPI_UINT8_T;
+  } else if constexpr (std::is_integral_v<U> && sizeof(U) == 2) {
+    return MPI_UINT16_T;
+  } else if constexpr (std::is_integral_v<U> && sizeof(U) == 4) {
+    return MPI_UINT32_T;
+  } else if constexpr (std::is_integral_v<U> && sizeof(U) == 8) {
+    return MPI_UINT64_T;
+  } else {
+    static_assert(kAlwaysFalse<T>, "No predefined MPI datatype for this element type");
+  }
+}
+
+/// @brief Owner of a committed derived MPI datatype; frees it on destruction.
+class MpiDatatype {
+ public:
+  MpiDatatype() = default;
+  /// @brief Takes ownership of a committed datatype.
+  explicit MpiDatatype(MPI_Datatype type) : type_(type) {}
+  ~MpiDatatype();
+
+  MpiDatatype(const MpiDatatype &) = delete;
+  MpiDatatype &operator=(const MpiDatatype &) = delete;
+  MpiDatatype(MpiDatatype &&other) noexcept;
+  MpiDatatype &operator=(MpiDatatype &&other) noexcept;
+
+  [[nodiscard]] MPI_Datatype Get() const {
+    return type_;
+  }
+
+ private:
+  MPI_Datatype type_ = MPI_DATATYPE_NULL;
+};
+
+/// @brief count blocks of block_length elements, stride elements apart, resized to an extent of extent elements.
+/// @details The extent decides where the next item of a (v)scatter/gather starts: a column of a row-major matrix
+///          is StridedType(base, rows, 1, row_length, 1), so displacements count columns instead of elements.
+MpiDatatype StridedType(MPI_Datatype base, int count, int block_length, int stride, int extent);
+
+/// @brief One column of a row-major rows x row_length matrix whose cells are element_size consecutive values
+///        (e.g. the channels of a pixel), with the extent of one cell.
+template <typename T>
+MpiDatatype ColumnType(int rows, int row_length, int element_size = 1) {
+  return StridedType(MpiTypeOf<T>(), rows, element_size, row_length * element_size, element_size);
+}
+
+/// @brief Contiguous type of the given number of bytes, for sending trivially copyable records.
+MpiDatatype BytesType(std::size_t bytes);
+
+namespace detail {
+
+void CheckPartitionMatchesComm(const Partition &partition, MPI_Comm comm);
+/// @brief Collective over comm: throws on every rank if error is non-empty on any of them.
+/// @details Lets a check that only one rank can make (e.g. on root data) fail without leaving the other ranks
+///          blocked in the next collective. Ranks without an error of their own report "<caller>: invalid input on
+///          another rank".
+void ThrowIfAnyRankFailed(const std::string &error, const char *caller, MPI_Comm comm);
+/// @brief Throws unless the parts of partition are contiguous and do not overlap, as MPI requires of the root
+///        buffer of a (v)scatter or gather.
+void CheckDisjointColumns(const Partition &columns, const char *caller);
+/// @brief Throws unless every halo of columns.WithHalo(halo) lies within the neighbouring parts.
+void CheckHaloNeighbours(const Partition &columns, int halo);
+/// @brief Receives the halo columns of this rank into extended, whose middle already holds its own columns.
+void SendrecvColumnHalos(const void *local, void *extended, MPI_Datatype base, int rows, int element_size,
+                         const Partition &columns, int halo, MPI_Comm comm);
+
+}  // namespace detail
+
+/// @brief Sends every rank its part of root_data (only read on root) and returns it in local order.
+/// @details Non-contiguous partitions are packed on the root first.
+template <std::ranges::contiguous_range Range, typename T = std::ranges::range_value_t<Range>>
+std::vector<T> Scatterv(const Range &root_data, const Partition &partition, MPI_Comm comm, int root = 0) {
+  detail::CheckPartitionMatchesComm(partition, comm);
+  int rank = 0;
+  MPI_Comm_rank(comm, &rank);
+  std::vector<T> packed;
+  const T *send = std::ranges::data(root_data);
+  if (rank == root && !partition.IsContiguous()) {
+    packed = partition.Pack(std::span<const T>(root_data));
+    send = packed.data();
+  }
+  std::vector<T> local(static_cast<std::size_t>(partition.Count(rank)));
+  MPI_Scatterv(send, partition.Counts().data(), partition.Displs().data(), MpiTypeOf<T>(), local.data(),
+               partition.Count(rank), MpiTypeOf<T>(), root, comm);
+  return local;
+}
+
+/// @brief Collects the parts of every rank on root in global order; other ranks get an empty vector.
+template <std::ranges::contiguous_range Range, typename T = std::ranges::range_value_t<Range>>
+std::vector<T> Gatherv(const Range &local, const Partition &partition, MPI_Comm comm, int root = 0) {
+  detail::CheckPartitionMatchesComm(partition, comm);
+  int rank = 0;
+  MPI_Comm_rank(comm, &rank);
+  std::vector<T> result(rank == root ? static_cast<std::size_t>(partition.Total()) : 0);
+  std::vector<T> packed(rank == root && !partition.IsContiguous() ? result.size() : 0);
+  T *recv = packed.empty() ? result.data() : packed.data();
+  MPI_Gatherv(std::ranges::data(local), partition.Count(rank), MpiTypeOf<T>(), recv, partition.Counts().data(),
+              partition.Displs().data(), MpiTypeOf<T>(), root, comm);
+  if (!packed.empty()) {
+    partition.Unpack(std::span<const T>(packed), std::span<T>(result));
+  }
+  return result;
+}
+
+/// @brief Collects the parts of every rank into result (partition.Total() elements) on every rank in global order.
+/// @details Writes in place for contiguous partitions, so iterative solvers can reuse one buffer.
+template <std::ranges::contiguous_range Range, typename T = std::ranges::range_value_t<Range>>
+void Allgatherv(const Range &local, std::type_identity_t<std::span<T>> result, const Partition &partition,
+                MPI_Comm comm) {
+  detail::CheckPartitionMatchesComm(partition, comm);
+  int rank = 0;
+  MPI_Comm_rank(comm, &rank);
+  std::vector<T> packed(partition.IsContiguous() ? 0 : result.size());
+  T *recv = partition.IsContiguous() ? result.data() : packed.data();
+  MPI_Allgatherv(std::ranges::data(local), partition.Count(rank), MpiTypeOf<T>(), recv, partition.Counts().data(),
+                 partition.Displs().data(), MpiTypeOf<T>(), comm);
+  if (!partition.IsContiguous()) {
+    partition.Unpack(std::span<const T>(packed), result);
+  }
+}
+
+/// @brief Collects the parts of every rank on every rank in global order.
+template <std::ranges::contiguous_range Range, typename T = std::ranges::range_value_t<Range>>
+std::vector<T> Allgatherv(const Range &local, const Partition &partition, MPI_Comm comm) {
+  std::vector<T> result(static_cast<std::size_t>(partition.Total()));
+  Allgatherv(local, std::span<T>(result), partition, comm);
+  return result;
+}
+
+/// @brief Sends outbox[r] to rank r of comm and returns what the ranks sent here, ordered by source rank.
+/// @details Collective over comm; the outbox is cleared for the next round. Records are sent as raw bytes, so any
+///          trivially copyable T works, e.g. sparse (vertex, distance) updates for the owners of the vertices.
+/// @param pending In: whether this rank has work left. Out: whether any rank had work left or sent records. It
+///                rides along with the counts, so a round loop needs no extra reduction to detect quiescence.
+template <typename T>
+std::vector<T> ExchangeOutbox(std::vector<std::vector<T>> &outbox, MPI_Comm comm, bool &pending) {
+  static_assert(std::is_trivially_copyable_v<T>, "Outbox records are sent as raw bytes");
+  int size = 0;
+  MPI_Comm_size(comm, &size);
+  if (outbox.size() != static_cast<std::size_t>(size)) {
+    throw std::runtime_error("ExchangeOutbox: the outbox needs one entry per rank");
+  }
+  std::vector<int> send_counts(outbox.size());
+  std::vector<int> send_displs(outbox.size());
+  std::vector<T> send;
+  for (std::size_t dest = 0; dest < outbox.size(); dest++) {
+    send_counts[dest] = static_cast<int>(outbox[dest].size());
+    send_displs[dest] = static_cast<int>(send.size());
+    send.insert(send.end(), outbox[dest].begin(), outbox[dest].end());
+    outbox[dest].clear();
+  }
+  // Every rank gets (records for it, sender has work) from every rank
+  const int local_pending = pending || !send.empty() ? 1 : 0;
+  std::vector<int> send_header(2 * outbox.size());
+  for (std::size_t dest = 0; dest < outbox.size(); dest++) {
+    send_header[2 * dest] = send_counts[dest];
+    send_header[(2 * dest) + 1] = local_pending;
+  }
+  std::vector<int> recv_header(send_header.size());
+  MPI_Alltoall(send_header.data(), 2, MPI_INT, recv_header.data(), 2, MPI_INT, comm);
+  std::vector<int> recv_counts(outbox.size());
+  std::vector<int> recv_displs(outbox.size());
+  int total_recv = 0;
+  pending = false;
+  for (std::size_t src = 0; src < recv_counts.size(); src++) {
+    recv_counts[src] = recv_header[2 * src];
+    recv_displs[src] = total_recv;
+    total_recv += recv_counts[src];
+    pending = pending || recv_header[(2 * src) + 1] != 0;
+  }
+  std::vector<T> recv(static_cast<std::size_t>(total_recv));
+  const auto type = BytesType(sizeof(T));
+  MPI_Alltoallv(send.data(), send_counts.data(), send_displs.data(), type.Get(), recv.data(), recv_counts.data(),
+                recv_displs.data(), type.Get(), comm);
+  return recv;
+}
+
+/// @brief ExchangeOutbox() for callers that track progress themselves.
+template <typename T>
+std::vector<T> ExchangeOutbox(std::vector<std::vector<T>> &outbox, MPI_Comm comm) {
+  bool pending = false;
+  return ExchangeOutbox(outbox, comm, pending);
+}
+
+/// @brief Scatters column blocks of a row-major matrix without packing them by hand.
+/// @param root_matrix rows x columns.Total() cells of element_size values; only read on root.
+/// @param columns Contiguous column partition with disjoint parts; ghost columns come from ExchangeColumnHalos().
+/// @return The rows x columns.Count(rank) block of this rank, row-major.
+template <std::ranges::contiguous_range Range, typename T = std::ranges::range_value_t<Range>>
+std::vector<T> ScatterColumns(const Range &root_matrix, int rows, int element_size, const Partition &columns,
+                              MPI_Comm comm, int root = 0) {
+  detail::CheckPartitionMatchesComm(columns, comm);
+  detail::CheckDisjointColumns(columns, "ScatterColumns");
+  int rank = 0;
+  MPI_Comm_rank(comm, &rank);
+  const int local_cols = columns.Count(rank);
+  const auto send_type = ColumnType<T>(rows, columns.Total(), element_size);
+  const auto recv_type = ColumnType<T>(rows, local_cols, element_size);
+  std::vector<T> local(static_cast<std::size_t>(rows) * static_cast<std::size_t>(local_cols) *
+                       static_cast<std::size_t>(element_size));
+  MPI_Scatterv(std::ranges::data(root_matrix), columns.Counts().data(), columns.Displs().data(), send_type.Get(),
+               local.data(), local_cols, recv_type.Get(), root, comm);
+  return local;
+}
+
+/// @brief Inverse of ScatterColumns(): writes the column block of every rank into root_matrix on root.
+/// @param root_matrix rows x columns.Total() cells of element_size values; only written on root.
+template <std::ranges::contiguous_range Range, typename T = std::ranges::range_value_t<Range>>
+void GatherColumns(const Range &local, std::type_identity_t<std::span<T>> root_matrix, int rows, int element_size,
+                   const Partition &columns, MPI_Comm comm, int root = 0) {
+  detail::CheckPartitionMatchesComm(columns, comm);
+  detail::CheckDisjointColumns(columns, "GatherColumns");
+  int rank = 0;
+  MPI_Comm_rank(comm, &rank);
+  const int local_cols = columns.Count(rank);
+  const auto send_type = ColumnType<T>(rows, local_cols, element_size);
+  const auto recv_type = ColumnType<T>(rows, columns.Total(), element_size);
+  MPI_Gatherv(std::ranges::data(local), local_cols, send_type.Get(), root_matrix.data(), columns.Counts().data(),
+              columns.Displs().data(), recv_type.Get(), root, comm);
+}
+
+/// @brief Widens the column block of every rank by up to halo ghost columns on each side, taken from its neighbours.
+/// @details Stencils scatter disjoint blocks with ScatterColumns() and then trade the outer columns with the left
+///          and right neighbour through MPI_Sendrecv, so no cell is sent by the root twice. Blocks at the edges of
+///          the matrix are clipped as in Partition::WithHalo().
+/// @param local rows x columns.Count(rank) cells of element_size values.
+/// @return The rows x columns.WithHalo(halo).Count(rank) block of this rank, row-major.
+/// @throws std::runtime_error If columns is not contiguous and disjoint or a halo reaches past a neighbouring part.
+template <std::ranges::contiguous_range Range, typename T = std::ranges::range_value_t<Range>>
+std::vector<T> ExchangeColumnHalos(const Range &local, int rows, int element_size, const Partition &columns, int halo,
+                                   MPI_Comm comm) {
+  detail::CheckPartitionMatchesComm(columns, comm);
+  detail::CheckDisjointColumns(columns, "ExchangeColumnHalos");
+  const auto extended = columns.WithHalo(halo);
+  detail::CheckHaloNeighbours(columns, halo);
+  int rank = 0;
+  MPI_Comm_rank(comm, &rank);
+  const auto row_cells = static_cast<std::size_t>(columns.Count(rank)) * static_cast<std::size_t>(element_size);
+  const auto extended_row_cells =
+      static_cast<std::size_t>(extended.Count(rank)) * static_cast<std::size_t>(element_size);
+  const auto left_cells =
+      static_cast<std::size_t>(columns.Offset(rank) - extended.Offset(rank)) * static_cast<std::size_t>(element_size);
+  std::vector<T> result(static_cast<std::size_t>(rows) * extended_row_cells);
+  for (std::size_t row = 0; row < static_cast<std::size_t>(rows) && row_cells > 0; row++) {
+    std::copy_n(std::ranges::data(local) + (row * row_cells), row_cells,
+                result.begin() + static_cast<std::ptrdiff_t>((row * extended_row_cells) + left_cells));
+  }
+  detail::SendrecvColumnHalos(std::ranges::data(local), result.data(), MpiTypeOf<T>(), rows, element_size, columns,
+                              halo, comm);
+  return result;
+}
+
+}  // namespace ppc::util
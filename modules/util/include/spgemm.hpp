@@ -0,0 +1,199 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace ppc::util {
+
+/// @brief Read-only CRS matrix.
+/// @details Row r holds col_idx[row_ptr[r] .. row_ptr[r + 1]) with the matching values, so row_ptr has one entry
+///          more than the matrix has rows and may index into the arrays of a larger matrix (row_ptr[0] does not have
+///          to be 0), which lets a rank pass its block of rows without copying.
+template <typename Value>
+struct CsrView {
+  int cols = 0;
+  std::span<const int> row_ptr;
+  std::span<const int> col_idx;
+  std::span<const Value> values;
+
+  [[nodiscard]] int Rows() const {
+    return row_ptr.empty() ? 0 : static_cast<int>(row_ptr.size()) - 1;
+  }
+};
+
+/// @brief CRS matrix owning its arrays; row_ptr starts at 0.
+template <typename Value>
+struct CsrMatrix {
+  int rows = 0;
+  int cols = 0;
+  std::vector<int> row_ptr;
+  std::vector<int> col_idx;
+  std::vector<Value> values;
+};
+
+/// @brief Sparse matrix product C = A * B by Gustavson's row-by-row algorithm.
+/// @details Row i of C is the sum of the rows B[k] scaled by A[i][k]. Every row is formed in a hash accumulator
+///          whose capacity follows the row's flop count (the number of products it adds up), never the width of C,
+///          so a row with a handful of nonzeros costs a handful of operations even when C has 10^6 columns. The
+///          product is computed in two passes: a symbolic pass counts the distinct columns of every row to size C
+///          exactly, then a numeric pass accumulates the values into place.
+/// @tparam Value Arithmetic element type.
+template <typename Value>
+class SpGemm {
+  static_assert(std::is_arithmetic_v<Value>, "SpGemm needs arithmetic values");
+
+ public:
+  struct Options {
+    /// @brief Entries of C whose magnitude does not exceed this are left out; 0 drops exact zeros only.
+    Value drop_tolerance{};
+    /// @brief Whether the columns of every row of C come out in ascending order.
+    bool sorted_columns = true;
+  };
+
+  SpGemm() = default;
+  explicit SpGemm(Options options) : options_(options) {}
+
+  /// @brief Computes a * b; the column indices of b must lie in [0, b.cols).
+  /// @throws std::runtime_error If the columns of a do not match the rows of b.
+  CsrMatrix<Value> Multiply(const CsrView<Value> &a, const CsrView<Value> &b) {
+    if (a.Rows() > 0 && a.cols != b.Rows()) {
+      throw std::runtime_error("SpGemm: A has " + std::to_string(a.cols) + " columns but B has " +
+                               std::to_string(b.Rows()) + " rows");
+    }
+    CsrMatrix<Value> c;
+    c.rows = a.Rows();
+    c.cols = b.cols;
+    c.row_ptr.assign(static_cast<std::size_t>(c.rows) + 1, 0);
+
+    // Symbolic pass: distinct columns per row, which bound the row's nonzeros
+    for (int row = 0; row < c.rows; row++) {
+      const auto next = static_cast<std::size_t>(row) + 1;
+      c.row_ptr[next] = c.row_ptr[next - 1] + CountRowColumns(a, b, row);
+    }
+    c.col_idx.resize(static_cast<std::size_t>(c.row_ptr.back()));
+    c.values.resize(c.col_idx.size());
+
+    // Numeric pass; rows shrink only by dropped entries, so each row is written at or before its symbolic slot
+    int write = 0;
+    for (int row = 0; row < c.rows; row++) {
+      const int begin = write;
+      write = AccumulateRow(a, b, row, c, write);
+      c.row_ptr[static_cast<std::size_t>(row)] = begin;
+    }
+    c.row_ptr.back() = write;
+    c.col_idx.resize(static_cast<std::size_t>(write));
+    c.values.resize(static_cast<std::size_t>(write));
+    return c;
+  }
+
+ private:
+  static constexpr int kEmpty = -1;
+
+  /// @brief Products summed into row `row` of C, an upper bound on its nonzeros.
+  static std::int64_t RowFlops(const CsrView<Value> &a, const CsrView<Value> &b, int row) {
+    std::int64_t flops = 0;
+    for (int k = a.row_ptr[static_cast<std::size_t>(row)]; k < a.row_ptr[static_cast<std::size_t>(row) + 1]; k++) {
+      const auto b_row = static_cast<std::size_t>(a.col_idx[static_cast<std::size_t>(k)]);
+      flops += b.row_ptr[b_row + 1] - b.row_ptr[b_row];
+    }
+    return flops;
+  }
+
+  /// @brief Empties the table and sizes it for up to `keys` distinct columns at most half full.
+  void ResetTable(std::int64_t keys, int cols) {
+    const auto distinct = static_cast<std::size_t>(std::min<std::int64_t>(keys, cols));
+    const std::size_t capacity = std::bit_ceil(std::max<std::size_t>(2 * distinct, 2));
+    if (keys_.size() < capacity) {
+      keys_.resize(capacity);
+      sums_.resize(capacity);
+    }
+    std::fill_n(keys_.begin(), capacity, kEmpty);
+    mask_ = capacity - 1;
+    shift_ = 32 - std::countr_zero(capacity);
+  }
+
+  /// @brief Slot of column col, claiming an empty one for a new column.
+  std::size_t Slot(int col) {
+    // Fibonacci hashing keeps the high bits of the product, which mix every bit of the column
+    auto slot = static_cast<std::size_t>((static_cast<std::uint32_t>(col) * 0x9E3779B1U) >> shift_);
+    while (keys_[slot] != kEmpty && keys_[slot] != col) {
+      slot = (slot + 1) & mask_;
+    }
+    return slot;
+  }
+
+  int CountRowColumns(const CsrView<Value> &a, const CsrView<Value> &b, int row) {
+    ResetTable(RowFlops(a, b, row), b.cols);
+    int distinct = 0;
+    for (int k = a.row_ptr[static_cast<std::size_t>(row)]; k < a.row_ptr[static_cast<std::size_t>(row) + 1]; k++) {
+      const auto b_row = static_cast<std::size_t>(a.col_idx[static_cast<std::size_t>(k)]);
+      for (int j = b.row_ptr[b_row]; j < b.row_ptr[b_row + 1]; j++) {
+        const int col = b.col_idx[static_cast<std::size_t>(j)];
+        const std::size_t slot = Slot(col);
+        if (keys_[slot] == kEmpty) {
+          keys_[slot] = col;
+          distinct++;
+        }
+      }
+    }
+    return distinct;
+  }
+
+  /// @brief Computes row `row` of C into c from position write on.
+  /// @return Position after the last entry written.
+  int AccumulateRow(const CsrView<Value> &a, const CsrView<Value> &b, int row, CsrMatrix<Value> &c, int write) {
+    ResetTable(RowFlops(a, b, row), b.cols);
+    touched_.clear();
+    for (int k = a.row_ptr[static_cast<std::size_t>(row)]; k < a.row_ptr[static_cast<std::size_t>(row) + 1]; k++) {
+      const Value scale = a.values[static_cast<std::size_t>(k)];
+      const auto b_row = static_cast<std::size_t>(a.col_idx[static_cast<std::size_t>(k)]);
+      for (int j = b.row_ptr[b_row]; j < b.row_ptr[b_row + 1]; j++) {
+        const int col = b.col_idx[static_cast<std::size_t>(j)];
+        const std::size_t slot = Slot(col);
+        if (keys_[slot] == kEmpty) {
+          keys_[slot] = col;
+          sums_[slot] = Value{};
+          touched_.push_back(slot);
+        }
+        sums_[slot] += scale * b.values[static_cast<std::size_t>(j)];
+      }
+    }
+    if (options_.sorted_columns) {
+      std::ranges::sort(touched_, {}, [&](std::size_t slot) { return keys_[slot]; });
+    }
+    for (const std::size_t slot : touched_) {
+      if (!(Magnitude(sums_[slot]) <= options_.drop_tolerance)) {
+        c.col_idx[static_cast<std::size_t>(write)] = keys_[slot];
+        c.values[static_cast<std::size_t>(write)] = sums_[slot];
+        write++;
+      }
+    }
+    return write;
+  }
+
+  static Value Magnitude(Value value) {
+    if constexpr (std::is_signed_v<Value>) {
+      return value < Value{} ? -value : value;
+    } else {
+      return value;
+    }
+  }
+
+  Options options_;
+  /// @brief Open-addressing accumulator: column (kEmpty if free) and running sum per slot.
+  std::vector<int> keys_;
+  std::vector<Value> sums_;
+  std::size_t mask_ = 1;
+  int shift_ = 31;
+  /// @brief Occupied slots of the current row in insertion order.
+  std::vector<std::size_t> touched_;
+};
+
+}  // namespace ppc::util
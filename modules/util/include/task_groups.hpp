@@ -0,0 +1,38 @@
+#pragma once
+
+#include <mpi.h>
+
+#include "task/include/task.hpp"
+
+namespace ppc::util {
+
+/// @brief Number of rank groups running independent task instances concurrently (PPC_TASK_GROUPS, default 1).
+/// @throws std::runtime_error If the value is not positive.
+int GetTaskGroupCount();
+
+/// @brief Splits MPI_COMM_WORLD into GetTaskGroupCount() contiguous blocks of ranks.
+/// @details Collective; called by the MPI runner after initialization.
+/// @throws std::runtime_error If there are more groups than ranks.
+void InitTaskGroups();
+
+/// @brief Frees the group communicator; called by the MPI runner before finalization.
+void FreeTaskGroups();
+
+/// @brief Returns the communicator of the group of the calling rank (MPI_COMM_WORLD without groups).
+MPI_Comm GetTaskGroupComm();
+
+/// @brief Returns the index of the group of the calling rank.
+int GetTaskGroupIndex();
+
+/// @brief Runs the task on the group communicator if the task supports an injected communicator.
+/// @return True if the task was assigned to a group smaller than the world.
+template <typename InType, typename OutType>
+bool AssignTaskGroup(ppc::task::Task<InType, OutType> &task) {
+  if (GetTaskGroupComm() == MPI_COMM_WORLD || !task.SupportsCommunicator()) {
+    return false;
+  }
+  task.SetCommunicator(GetTaskGroupComm());
+  return true;
+}
+
+}  // namespace ppc::util
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ppc::util {
+
+/// @brief Fixed-size work-stealing thread pool for STL implementations.
+/// @details Every worker owns a queue: jobs submitted from a worker go to the front of its own queue
+///          (LIFO, cache-warm), jobs submitted from other threads are distributed round-robin. Idle
+///          workers take jobs from the back of other queues. Threads are started once and reused by
+///          all tasks, so RunImpl does not pay for thread creation.
+class ThreadPool {
+ public:
+  /// @param num_threads Number of worker threads (at least one is started).
+  explicit ThreadPool(int num_threads);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+  ThreadPool(ThreadPool &&) = delete;
+  ThreadPool &operator=(ThreadPool &&) = delete;
+
+  [[nodiscard]] int Size() const {
+    return static_cast<int>(threads_.size());
+  }
+
+  /// @brief Schedules the callable on the pool.
+  /// @return Future with the result; an exception thrown by the callable is rethrown by get().
+  template <typename Func>
+  auto Submit(Func &&func) -> std::future<std::invoke_result_t<std::decay_t<Func>>> {
+    using Result = std::invoke_result_t<std::decay_t<Func>>;
+    auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<Func>(func));
+    auto future = task->get_future();
+    Push([task] { (*task)(); });
+    return future;
+  }
+
+  /// @brief Calls func(i) for every i in [begin, end), split into at most Size() contiguous chunks.
+  /// @details Blocks until all chunks are done; the calling thread executes queued jobs while waiting, so
+  ///          the call may be nested inside pool jobs. The first exception of a chunk is rethrown.
+  template <typename Func>
+  void ParallelFor(int begin, int end, Func &&func) {
+    if (begin >= end) {
+      return;
+    }
+    const int total = end - begin;
+    const int chunks = std::min(total, Size());
+    std::vector<std::future<void>> futures;
+    futures.reserve(static_cast<std::size_t>(chunks));
+    for (int chunk = 0; chunk < chunks; chunk++) {
+      const int first = begin + static_cast<int>(static_cast<long long>(total) * chunk / chunks);
+      const int last = begin + static_cast<int>(static_cast<long long>(total) * (chunk + 1) / chunks);
+      futures.push_back(Submit([first, last, &func] {
+        for (int i = first; i < last; i++) {
+          func(i);
+        }
+      }));
+    }
+    for (auto &future : futures) {
+      Wait(future);
+    }
+    for (auto &future : futures) {
+      future.get();
+    }
+  }
+
+  /// @brief Waits for a future returned by Submit() (std::future or std::shared_future) while executing queued
+  ///        jobs on the calling thread.
+  /// @details With nothing left to run, the thread sleeps until a job is submitted or finishes.
+  template <typename Future>
+  void Wait(const Future &future) {
+    while (!IsReady(future)) {
+      const auto progress = progress_.load();
+      if (RunPendingJob() || IsReady(future)) {
+        continue;
+      }
+      progress_.wait(progress);
+    }
+  }
+
+  /// @brief Executes one queued job on the calling thread.
+  /// @return False if all queues were empty.
+  bool RunPendingJob();
+
+ private:
+  struct WorkerQueue {
+    std::mutex mutex;
+    std::deque<std::function<void()>> jobs;
+  };
+
+  template <typename Future>
+  static bool IsReady(const Future &future) {
+    return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+  }
+
+  void Push(std::function<void()> job);
+  void RunJob(std::function<void()> &job);
+  bool TakeJob(std::size_t preferred, std::function<void()> &job);
+  void WorkerLoop(std::size_t index);
+
+  std::vector<std::unique_ptr<WorkerQueue>> queues_;
+  std::vector<std::thread> threads_;
+  std::mutex wake_mutex_;
+  std::condition_variable wake_;
+  std::atomic<std::size_t> pending_{0};
+  std::atomic<std::size_t> next_queue_{0};
+  /// Bumped whenever a job is submitted or finishes; threads in Wait() sleep on it
+  std::atomic<std::uint64_t> progress_{0};
+  bool stop_ = false;
+};
+
+}  // namespace ppc::util
@@ -71,6 +71,67 @@ int GetNumThreads();
 int GetNumProc();
 double GetTaskMaxTime();
 double GetPerfMaxTime();
+bool IsPerfHwCountersEnabled();
+bool IsPerfColdCacheEnabled();
+
+/// @brief Reads the number of tasks kept in flight by the pipelined throughput measurement from
+///        PPC_PERF_IN_FLIGHT (unset or 0 disables it).
+/// @throws std::runtime_error If the value is negative.
+int GetPerfInFlight();
+
+/// @brief Scaling study performed by performance tests on top of the regular measurement.
+enum class PerfScalingMode : uint8_t {
+  /// Only the regular measurement
+  kNone,
+  /// Fixed total input size for every worker count
+  kStrong,
+  /// Input size grows proportionally with the worker count
+  kWeak
+};
+
+/// @brief Reads the scaling mode from PPC_PERF_SCALING ("strong", "weak"; unset or "none" disables it).
+/// @throws std::runtime_error If the value is not recognized.
+PerfScalingMode GetPerfScalingMode();
+std::string PerfScalingModeToString(PerfScalingMode mode);
+
+/// @brief MPI thread support requested from MPI_Init_thread (ordered as the MPI_THREAD_* constants).
+enum class MpiThreadLevel : uint8_t {
+  /// Only one thread exists in the rank
+  kSingle,
+  /// Worker threads exist, only the main thread calls MPI
+  kFunneled,
+  /// Any thread calls MPI, one at a time
+  kSerialized,
+  /// Any thread calls MPI concurrently
+  kMultiple
+};
+
+/// @brief Reads the requested level from PPC_MPI_THREAD_LEVEL ("single", "funneled", "serialized",
+///        "multiple"; default "funneled").
+/// @throws std::runtime_error If the value is not recognized.
+MpiThreadLevel GetMpiThreadLevel();
+std::string GetMpiThreadLevelName(MpiThreadLevel level);
+
+/// @brief Threading setup of the calling rank established by the runner.
+struct RankThreading {
+  /// @brief Thread support provided by the MPI library.
+  MpiThreadLevel mpi_thread_level = MpiThreadLevel::kSingle;
+  /// @brief Worker threads the rank may run; 0 until the runner sets it.
+  int thread_budget = 0;
+};
+
+void SetRankThreading(RankThreading threading);
+const RankThreading &GetRankThreading();
+
+/// @brief Caps the requested threads per rank so the ranks of one node do not oversubscribe its CPUs.
+/// @param num_threads Requested threads per rank (PPC_NUM_THREADS).
+/// @param node_cpus CPUs of the node available to the job (0 if unknown, no cap is applied then).
+/// @param local_ranks Number of ranks on the node.
+int ComputeRankThreadBudget(int num_threads, int node_cpus, int local_ranks);
+
+/// @brief Returns the number of worker threads hybrid (kALL) implementations should start in this rank.
+/// @details Equals the runner budget, or GetNumThreads() when the runner did not set one.
+int GetRankThreadBudget();
 
 template <typename T>
 std::string GetNamespace() {
@@ -0,0 +1,194 @@
+#include "util/include/alloc_tracker.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+#if defined(__linux__)
+#  include <malloc.h>
+#  include <sys/resource.h>
+#elif defined(__APPLE__)
+#  include <malloc/malloc.h>
+#  include <sys/resource.h>
+#elif defined(_WIN32)
+#  include <malloc.h>
+#endif
+
+uint64_t ppc::util::AllocTracker::GetProcessPeakRssKb() {
+#if defined(__linux__) || defined(__APPLE__)
+  rusage usage{};
+  if (getrusage(RUSAGE_SELF, &usage) != 0) {
+    return 0;
+  }
+#  ifdef __APPLE__
+  // macOS reports bytes, Linux reports KiB
+  return static_cast<uint64_t>(usage.ru_maxrss) / 1024;
+#  else
+  return static_cast<uint64_t>(usage.ru_maxrss);
+#  endif
+#else
+  return 0;
+#endif
+}
+
+#ifdef USE_ALLOC_TRACKER
+
+namespace {
+
+std::size_t UsableSize(void *ptr) {
+#  if defined(__linux__)
+  return malloc_usable_size(ptr);
+#  elif defined(__APPLE__)
+  return malloc_size(ptr);
+#  else
+  return _msize(ptr);
+#  endif
+}
+
+void *TrackedAlloc(std::size_t size) {
+  void *ptr = std::malloc(size == 0 ? 1 : size);
+  if (ptr != nullptr) {
+    ppc::util::AllocTracker::RecordAlloc(size, UsableSize(ptr));
+  }
+  return ptr;
+}
+
+void *TrackedAlignedAlloc(std::size_t size, std::align_val_t alignment) {
+  const auto align = static_cast<std::size_t>(alignment);
+#  ifdef _WIN32
+  void *ptr = _aligned_malloc(size == 0 ? 1 : size, align);
+  if (ptr != nullptr) {
+    ppc::util::AllocTracker::RecordAlloc(size, _aligned_msize(ptr, align, 0));
+  }
+#  else
+  // aligned_alloc requires the size to be a multiple of the alignment
+  const std::size_t rounded = ((size == 0 ? 1 : size) + align - 1) / align * align;
+  void *ptr = std::aligned_alloc(align, rounded);
+  if (ptr != nullptr) {
+    ppc::util::AllocTracker::RecordAlloc(size, UsableSize(ptr));
+  }
+#  endif
+  return ptr;
+}
+
+void TrackedFree(void *ptr) {
+  if (ptr == nullptr) {
+    return;
+  }
+  ppc::util::AllocTracker::RecordFree(UsableSize(ptr));
+  std::free(ptr);
+}
+
+void TrackedAlignedFree(void *ptr, std::align_val_t alignment) {
+  if (ptr == nullptr) {
+    return;
+  }
+#  ifdef _WIN32
+  ppc::util::AllocTracker::RecordFree(_aligned_msize(ptr, static_cast<std::size_t>(alignment), 0));
+  _aligned_free(ptr);
+#  else
+  (void)alignment;
+  TrackedFree(ptr);
+#  endif
+}
+
+// Follows the standard operator new contract: retry through the new-handler, throw when there is none
+template <typename Alloc>
+void *AllocOrThrow(Alloc &&alloc) {
+  while (true) {
+    void *ptr = alloc();
+    if (ptr != nullptr) {
+      return ptr;
+    }
+    const auto handler = std::get_new_handler();
+    if (handler == nullptr) {
+      throw std::bad_alloc();
+    }
+    handler();
+  }
+}
+
+}  // namespace
+
+void *operator new(std::size_t size) {
+  return AllocOrThrow([size] { return TrackedAlloc(size); });
+}
+
+void *operator new[](std::size_t size) {
+  return AllocOrThrow([size] { return TrackedAlloc(size); });
+}
+
+void *operator new(std::size_t size, const std::nothrow_t & /*tag*/) noexcept {
+  return TrackedAlloc(size);
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t & /*tag*/) noexcept {
+  return TrackedAlloc(size);
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment) {
+  return AllocOrThrow([size, alignment] { return TrackedAlignedAlloc(size, alignment); });
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment) {
+  return AllocOrThrow([size, alignment] { return TrackedAlignedAlloc(size, alignment); });
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t & /*tag*/) noexcept {
+  return TrackedAlignedAlloc(size, alignment);
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t & /*tag*/) noexcept {
+  return TrackedAlignedAlloc(size, alignment);
+}
+
+void operator delete(void *ptr) noexcept {
+  TrackedFree(ptr);
+}
+
+void operator delete[](void *ptr) noexcept {
+  TrackedFree(ptr);
+}
+
+void operator delete(void *ptr, std::size_t /*size*/) noexcept {
+  TrackedFree(ptr);
+}
+
+void operator delete[](void *ptr, std::size_t /*size*/) noexcept {
+  TrackedFree(ptr);
+}
+
+void operator delete(void *ptr, const std::nothrow_t & /*tag*/) noexcept {
+  TrackedFree(ptr);
+}
+
+void operator delete[](void *ptr, const std::nothrow_t & /*tag*/) noexcept {
+  TrackedFree(ptr);
+}
+
+void operator delete(void *ptr, std::align_val_t alignment) noexcept {
+  TrackedAlignedFree(ptr, alignment);
+}
+
+void operator delete[](void *ptr, std::align_val_t alignment) noexcept {
+  TrackedAlignedFree(ptr, alignment);
+}
+
+void operator delete(void *ptr, std::size_t /*size*/, std::align_val_t alignment) noexcept {
+  TrackedAlignedFree(ptr, alignment);
+}
+
+void operator delete[](void *ptr, std::size_t /*size*/, std::align_val_t alignment) noexcept {
+  TrackedAlignedFree(ptr, alignment);
+}
+
+void operator delete(void *ptr, std::align_val_t alignment, const std::nothrow_t & /*tag*/) noexcept {
+  TrackedAlignedFree(ptr, alignment);
+}
+
+void operator delete[](void *ptr, std::align_val_t alignment, const std::nothrow_t & /*tag*/) noexcept {
+  TrackedAlignedFree(ptr, alignment);
+}
+
+#endif  // USE_ALLOC_TRACKER
@@ -0,0 +1,706 @@
+#include "util/include/csr_snapshot.hpp"
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cctype>
+#include <charconv>
+#include <climits>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <libenvpp/detail/get.hpp>
+#include <optional>
+#include <random>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#  define NOMINMAX
+#  define WIN32_LEAN_AND_MEAN
+#  include <windows.h>
+#else
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+static_assert(std::endian::native == std::endian::little, "CSR snapshots are mapped as little-endian data");
+
+namespace ppc::util {
+
+namespace {
+
+constexpr std::uint64_t kSectionAlignment = 64;
+
+std::uint64_t AlignUp(std::uint64_t offset) {
+  return (offset + kSectionAlignment - 1) / kSectionAlignment * kSectionAlignment;
+}
+
+std::size_t WeightSize(CsrWeightType type) {
+  switch (type) {
+    case CsrWeightType::kInt32:
+    case CsrWeightType::kFloat32:
+      return 4;
+    case CsrWeightType::kInt64:
+    case CsrWeightType::kFloat64:
+      return 8;
+  }
+  return 0;
+}
+
+/// @brief Calls fn(std::type_identity<W>{}) with the weight type W stored as type.
+template <typename Fn>
+decltype(auto) VisitWeightType(CsrWeightType type, Fn &&fn) {
+  switch (type) {
+    case CsrWeightType::kInt32:
+      return std::forward<Fn>(fn)(std::type_identity<std::int32_t>{});
+    case CsrWeightType::kInt64:
+      return std::forward<Fn>(fn)(std::type_identity<std::int64_t>{});
+    case CsrWeightType::kFloat32:
+      return std::forward<Fn>(fn)(std::type_identity<float>{});
+    case CsrWeightType::kFloat64:
+      return std::forward<Fn>(fn)(std::type_identity<double>{});
+  }
+  throw std::runtime_error("CSR snapshot: unknown weight type");
+}
+
+/// @brief Header with the section offsets of a graph of the given size.
+CsrSnapshotHeader MakeHeader(std::int64_t vertices, std::int64_t edges, std::int64_t source, CsrWeightType type) {
+  CsrSnapshotHeader header;
+  header.weight_type = type;
+  header.vertices = vertices;
+  header.edges = edges;
+  header.source = source;
+  header.row_ptr_offset = AlignUp(sizeof(CsrSnapshotHeader));
+  header.col_idx_offset = AlignUp(header.row_ptr_offset + (sizeof(int) * static_cast<std::uint64_t>(vertices + 1)));
+  header.weights_offset = AlignUp(header.col_idx_offset + (sizeof(int) * static_cast<std::uint64_t>(edges)));
+  return header;
+}
+
+std::uint64_t FileSize(const CsrSnapshotHeader &header) {
+  return header.weights_offset + (WeightSize(header.weight_type) * static_cast<std::uint64_t>(header.edges));
+}
+
+/// @brief Mapped output file with the header written; the caller fills the sections.
+MappedFile CreateSnapshotFile(const std::filesystem::path &path, const CsrSnapshotHeader &header) {
+  auto file = MappedFile::Create(path, static_cast<std::size_t>(FileSize(header)));
+  std::memcpy(file.Data(), &header, sizeof(header));
+  return file;
+}
+
+template <typename T>
+std::span<T> MutableSection(const MappedFile &file, std::uint64_t offset, std::size_t count) {
+  return {reinterpret_cast<T *>(file.Data() + offset), count};
+}
+
+void CheckGraphSize(std::int64_t vertices, std::int64_t edges) {
+  if (vertices < 0 || vertices >= INT_MAX || edges < 0 || edges > INT_MAX) {
+    throw std::runtime_error("CSR snapshot: " + std::to_string(vertices) + " vertices and " + std::to_string(edges) +
+                             " edges do not fit int32 row offsets and column indices");
+  }
+}
+
+void CheckSource(std::int64_t source, std::int64_t vertices) {
+  if (source < 0 || source >= std::max<std::int64_t>(vertices, 1)) {
+    throw std::runtime_error("CSR snapshot: source vertex " + std::to_string(source) + " out of range");
+  }
+}
+
+/// @brief Writes next to path first and renames, so concurrent readers never see a partial snapshot.
+template <typename WriteFn>
+void WriteAtomically(const std::filesystem::path &path, WriteFn &&write) {
+  auto temp = path;
+  temp += ".tmp" + std::to_string(std::random_device{}());
+  std::error_code ignored;
+  try {
+    write(temp);
+  } catch (...) {
+    std::filesystem::remove(temp, ignored);
+    throw;
+  }
+  std::error_code error;
+  std::filesystem::rename(temp, path, error);
+  if (error) {
+    std::filesystem::remove(temp, ignored);
+    // Only a lost race is fine: another rank renamed an identical file first and its readers keep it mapped
+    if (!std::filesystem::exists(path, ignored)) {
+      throw std::filesystem::filesystem_error("Cannot publish the CSR snapshot", temp, path, error);
+    }
+  }
+}
+
+std::filesystem::path CacheDirectory() {
+  auto directory = std::filesystem::temp_directory_path() / "ppc_csr_snapshots";
+  std::error_code error;
+  std::filesystem::create_directories(directory, error);
+  if (error && !std::filesystem::is_directory(directory)) {
+    throw std::runtime_error("Cannot create " + directory.string() + ": " + error.message());
+  }
+  return directory;
+}
+
+/// @brief Uniform double in [0, 1) from the top 53 bits, identical on every standard library.
+double UnitInterval(std::mt19937_64 &gen) {
+  return static_cast<double>(gen() >> 11) * 0x1.0p-53;
+}
+
+int UniformVertex(std::mt19937_64 &gen, int vertices) {
+  return std::min(static_cast<int>(UnitInterval(gen) * vertices), vertices - 1);
+}
+
+class EdgeSampler {
+ public:
+  explicit EdgeSampler(const GraphGeneratorOptions &options) : options_(options), gen_(options.seed) {
+    while ((std::int64_t{1} << levels_) < options_.vertices) {
+      levels_++;
+    }
+  }
+
+  std::pair<int, int> Next() {
+    if (options_.model == GraphModel::kErdosRenyi) {
+      const int from = UniformVertex(gen_, options_.vertices);
+      return {from, UniformVertex(gen_, options_.vertices)};
+    }
+    // R-MAT works on a power of two vertices; edges landing past the last vertex are drawn again
+    while (true) {
+      std::int64_t from = 0;
+      std::int64_t to = 0;
+      for (int level = 0; level < levels_; level++) {
+        // Quadrants a | b over c | d: c and d pick the lower half of the rows, b and d the right half of the columns
+        const double r = UnitInterval(gen_);
+        const double ab = options_.a + options_.b;
+        const bool lower = r >= ab;
+        const bool right = (r >= options_.a && r < ab) || r >= ab + options_.c;
+        from = (from << 1) | (lower ? 1 : 0);
+        to = (to << 1) | (right ? 1 : 0);
+      }
+      if (from < options_.vertices && to < options_.vertices) {
+        return {static_cast<int>(from), static_cast<int>(to)};
+      }
+    }
+  }
+
+ private:
+  const GraphGeneratorOptions &options_;
+  std::mt19937_64 gen_;
+  int levels_ = 0;
+};
+
+template <typename W>
+W DrawWeight(std::mt19937_64 &gen, double min_weight, double max_weight) {
+  const double r = UnitInterval(gen);
+  if constexpr (std::is_integral_v<W>) {
+    const double span = std::floor(max_weight) - std::ceil(min_weight) + 1.0;
+    return static_cast<W>(std::ceil(min_weight) + std::min(std::floor(r * span), span - 1.0));
+  } else {
+    return static_cast<W>(min_weight + (r * (max_weight - min_weight)));
+  }
+}
+
+void CheckGeneratorOptions(const GraphGeneratorOptions &options, CsrWeightType weight_type) {
+  if (options.vertices <= 0) {
+    throw std::runtime_error("GenerateCsrSnapshot: the graph needs at least one vertex");
+  }
+  CheckGraphSize(options.vertices, options.edges);
+  CheckSource(options.source, options.vertices);
+  const bool integral = weight_type == CsrWeightType::kInt32 || weight_type == CsrWeightType::kInt64;
+  if (!(options.min_weight <= options.max_weight) ||
+      (integral && std::ceil(options.min_weight) > std::floor(options.max_weight))) {
+    throw std::runtime_error("GenerateCsrSnapshot: empty weight range");
+  }
+  if (options.model == GraphModel::kRmat &&
+      (options.a < 0.0 || options.b < 0.0 || options.c < 0.0 || options.a + options.b + options.c > 1.0)) {
+    throw std::runtime_error("GenerateCsrSnapshot: R-MAT probabilities must be non-negative and sum to at most 1");
+  }
+}
+
+template <typename W>
+void GenerateSnapshot(const std::filesystem::path &path, const GraphGeneratorOptions &options) {
+  const auto header = MakeHeader(options.vertices, options.edges, options.source, CsrWeightTypeOf<W>());
+  auto file = CreateSnapshotFile(path, header);
+  auto row_ptr = MutableSection<int>(file, header.row_ptr_offset, static_cast<std::size_t>(options.vertices) + 1);
+  auto col_idx = MutableSection<int>(file, header.col_idx_offset, static_cast<std::size_t>(options.edges));
+  auto weights = MutableSection<W>(file, header.weights_offset, static_cast<std::size_t>(options.edges));
+
+  // Pass 1 counts the out-degrees into row_ptr, shifted by one for the prefix sum
+  std::ranges::fill(row_ptr, 0);
+  EdgeSampler counting(options);
+  for (std::int64_t edge = 0; edge < options.edges; edge++) {
+    row_ptr[static_cast<std::size_t>(counting.Next().first) + 1]++;
+  }
+  for (std::size_t v = 1; v < row_ptr.size(); v++) {
+    row_ptr[v] += row_ptr[v - 1];
+  }
+
+  // Pass 2 replays the same edges into their rows, in generation order within a row
+  std::vector<int> cursor(row_ptr.begin(), row_ptr.end() - 1);
+  EdgeSampler filling(options);
+  std::mt19937_64 weight_gen(options.seed ^ 0x9E3779B97F4A7C15ULL);
+  for (std::int64_t edge = 0; edge < options.edges; edge++) {
+    const auto [from, to] = filling.Next();
+    const auto slot = static_cast<std::size_t>(cursor[static_cast<std::size_t>(from)]++);
+    col_idx[slot] = to;
+    weights[slot] = DrawWeight<W>(weight_gen, options.min_weight, options.max_weight);
+  }
+}
+
+/// @brief Reads whitespace-separated numbers off a text buffer.
+class NumberReader {
+ public:
+  explicit NumberReader(const std::string &text) : text_(text) {}
+
+  /// @return False at the end of the text.
+  template <typename T>
+  bool Read(T &value) {
+    while (pos_ < text_.size() && std::isspace(static_cast<unsigned char>(text_[pos_])) != 0) {
+      pos_++;
+    }
+    if (pos_ == text_.size()) {
+      return false;
+    }
+    const char *begin = text_.data() + pos_;
+    const char *end = text_.data() + text_.size();
+    const char *next = begin;
+    if constexpr (std::is_integral_v<T>) {
+      const auto result = std::from_chars(begin, end, value);
+      next = result.ec == std::errc() ? result.ptr : begin;
+    } else {
+      // std::from_chars for floating point is missing from older standard libraries still used in CI
+      char *parsed = nullptr;
+      value = static_cast<T>(std::strtod(begin, &parsed));
+      next = parsed;
+    }
+    if (next == begin) {
+      throw std::runtime_error("Malformed number at offset " + std::to_string(pos_) + " of the edge list");
+    }
+    pos_ = static_cast<std::size_t>(next - text_.data());
+    return true;
+  }
+
+ private:
+  const std::string &text_;
+  std::size_t pos_ = 0;
+};
+
+std::string ReadTextFile(const std::filesystem::path &path) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file.is_open()) {
+    throw std::runtime_error("Cannot open " + path.string());
+  }
+  std::ostringstream text;
+  text << file.rdbuf();
+  return std::move(text).str();
+}
+
+template <typename W>
+void ConvertEdgeList(const std::string &text, const std::filesystem::path &snapshot_path) {
+  NumberReader reader(text);
+  std::int64_t vertices = 0;
+  std::int64_t edges = 0;
+  if (!reader.Read(vertices) || !reader.Read(edges)) {
+    throw std::runtime_error("The edge list has no \"vertices edges\" line");
+  }
+  CheckGraphSize(vertices, edges);
+
+  std::vector<int> from(static_cast<std::size_t>(edges));
+  std::vector<int> to(from.size());
+  std::vector<W> weight(from.size());
+  for (std::size_t edge = 0; edge < from.size(); edge++) {
+    if (!reader.Read(from[edge]) || !reader.Read(to[edge]) || !reader.Read(weight[edge])) {
+      throw std::runtime_error("The edge list ends after " + std::to_string(edge) + " of " + std::to_string(edges) +
+                               " edges");
+    }
+    if (from[edge] < 0 || from[edge] >= vertices || to[edge] < 0 || to[edge] >= vertices) {
+      throw std::runtime_error("Edge " + std::to_string(edge) + " of the edge list joins vertices out of range");
+    }
+  }
+  std::int64_t source = 0;
+  reader.Read(source);
+  CheckSource(source, vertices);
+
+  const auto header = MakeHeader(vertices, edges, source, CsrWeightTypeOf<W>());
+  auto file = CreateSnapshotFile(snapshot_path, header);
+  auto row_ptr = MutableSection<int>(file, header.row_ptr_offset, static_cast<std::size_t>(vertices) + 1);
+  auto col_idx = MutableSection<int>(file, header.col_idx_offset, from.size());
+  auto weights = MutableSection<W>(file, header.weights_offset, from.size());
+  // Counting sort by source vertex, stable so that a row lists its edges in file order
+  std::ranges::fill(row_ptr, 0);
+  for (const int v : from) {
+    row_ptr[static_cast<std::size_t>(v) + 1]++;
+  }
+  for (std::size_t v = 1; v < row_ptr.size(); v++) {
+    row_ptr[v] += row_ptr[v - 1];
+  }
+  std::vector<int> cursor(row_ptr.begin(), row_ptr.end() - 1);
+  for (std::size_t edge = 0; edge < from.size(); edge++) {
+    const auto slot = static_cast<std::size_t>(cursor[static_cast<std::size_t>(from[edge])]++);
+    col_idx[slot] = to[edge];
+    weights[slot] = weight[edge];
+  }
+}
+
+std::string WeightTypeSuffix(CsrWeightType type) {
+  return "w" + std::to_string(static_cast<std::uint32_t>(type));
+}
+
+/// @brief Parses "rmat:<vertices>:<edges>[:<seed>]" or "er:..." into generator options.
+/// @return nullopt if spec names neither model, i.e. is a path.
+std::optional<GraphGeneratorOptions> ParseGraphSpec(std::string_view spec) {
+  GraphGeneratorOptions options;
+  if (spec.starts_with("rmat:")) {
+    options.model = GraphModel::kRmat;
+  } else if (spec.starts_with("er:")) {
+    options.model = GraphModel::kErdosRenyi;
+  } else {
+    return std::nullopt;
+  }
+  std::vector<std::string_view> fields;
+  for (auto rest = spec.substr(spec.find(':') + 1);; rest.remove_prefix(rest.find(':') + 1)) {
+    fields.push_back(rest.substr(0, rest.find(':')));
+    if (rest.find(':') == std::string_view::npos) {
+      break;
+    }
+  }
+  const auto parse = [](std::string_view field, auto &value) {
+    const auto result = std::from_chars(field.data(), field.data() + field.size(), value);
+    return result.ec == std::errc() && result.ptr == field.data() + field.size();
+  };
+  if (fields.size() < 2 || fields.size() > 3 || !parse(fields[0], options.vertices) ||
+      !parse(fields[1], options.edges) || (fields.size() == 3 && !parse(fields[2], options.seed))) {
+    throw std::runtime_error("PPC_PERF_GRAPH must be a snapshot path or <rmat|er>:<vertices>:<edges>[:<seed>], got " +
+                             std::string(spec));
+  }
+  return options;
+}
+
+}  // namespace
+
+MappedFile::~MappedFile() {
+  Release();
+}
+
+MappedFile::MappedFile(MappedFile &&other) noexcept {
+  *this = std::move(other);
+}
+
+MappedFile &MappedFile::operator=(MappedFile &&other) noexcept {
+  if (this != &other) {
+    Release();
+    data_ = std::exchange(other.data_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+#ifdef _WIN32
+    file_ = std::exchange(other.file_, nullptr);
+    mapping_ = std::exchange(other.mapping_, nullptr);
+#endif
+  }
+  return *this;
+}
+
+#ifdef _WIN32
+
+namespace {
+
+/// @return The mapping handle and the view; the file handle is closed on failure.
+std::pair<HANDLE, void *> MapHandle(HANDLE file, std::size_t bytes, bool writable, const std::filesystem::path &path) {
+  const auto size = static_cast<std::uint64_t>(bytes);
+  HANDLE mapping = CreateFileMappingW(file, nullptr, writable ? PAGE_READWRITE : PAGE_READONLY,
+                                      static_cast<DWORD>(size >> 32), static_cast<DWORD>(size), nullptr);
+  void *view = mapping != nullptr ? MapViewOfFile(mapping, writable ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, bytes)
+                                  : nullptr;
+  if (view == nullptr) {
+    if (mapping != nullptr) {
+      CloseHandle(mapping);
+    }
+    CloseHandle(file);
+    throw std::runtime_error("Cannot map " + path.string());
+  }
+  return {mapping, view};
+}
+
+}  // namespace
+
+MappedFile MappedFile::OpenReadOnly(const std::filesystem::path &path) {
+  HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    throw std::runtime_error("Cannot open " + path.string());
+  }
+  LARGE_INTEGER size{};
+  if (GetFileSizeEx(file, &size) == 0 || size.QuadPart == 0) {
+    CloseHandle(file);
+    throw std::runtime_error("Cannot map empty file " + path.string());
+  }
+  MappedFile mapped;
+  mapped.size_ = static_cast<std::size_t>(size.QuadPart);
+  const auto [mapping, view] = MapHandle(file, mapped.size_, false, path);
+  mapped.data_ = static_cast<std::byte *>(view);
+  mapped.file_ = file;
+  mapped.mapping_ = mapping;
+  return mapped;
+}
+
+MappedFile MappedFile::Create(const std::filesystem::path &path, std::size_t bytes) {
+  HANDLE file = CreateFileW(path.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS,
+                            FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    throw std::runtime_error("Cannot create " + path.string());
+  }
+  MappedFile mapped;
+  mapped.size_ = bytes;
+  const auto [mapping, view] = MapHandle(file, bytes, true, path);
+  mapped.data_ = static_cast<std::byte *>(view);
+  mapped.file_ = file;
+  mapped.mapping_ = mapping;
+  return mapped;
+}
+
+void MappedFile::Release() {
+  if (data_ != nullptr) {
+    UnmapViewOfFile(data_);
+    CloseHandle(mapping_);
+    CloseHandle(file_);
+  }
+  data_ = nullptr;
+  size_ = 0;
+  file_ = nullptr;
+  mapping_ = nullptr;
+}
+
+#else
+
+namespace {
+
+std::byte *MapDescriptor(int fd, std::size_t bytes, bool writable, const std::filesystem::path &path) {
+  void *data = mmap(nullptr, bytes, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+  // The mapping keeps the file referenced on its own
+  close(fd);
+  if (data == MAP_FAILED) {
+    throw std::runtime_error("Cannot map " + path.string());
+  }
+  return static_cast<std::byte *>(data);
+}
+
+}  // namespace
+
+MappedFile MappedFile::OpenReadOnly(const std::filesystem::path &path) {
+  const int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("Cannot open " + path.string());
+  }
+  struct stat info{};
+  if (fstat(fd, &info) != 0 || info.st_size == 0) {
+    close(fd);
+    throw std::runtime_error("Cannot map empty file " + path.string());
+  }
+  MappedFile mapped;
+  mapped.size_ = static_cast<std::size_t>(info.st_size);
+  mapped.data_ = MapDescriptor(fd, mapped.size_, false, path);
+  return mapped;
+}
+
+MappedFile MappedFile::Create(const std::filesystem::path &path, std::size_t bytes) {
+  const int fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    throw std::runtime_error("Cannot create " + path.string());
+  }
+  if (ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+    close(fd);
+    throw std::runtime_error("Cannot resize " + path.string() + " to " + std::to_string(bytes) + " bytes");
+  }
+  MappedFile mapped;
+  mapped.size_ = bytes;
+  mapped.data_ = MapDescriptor(fd, bytes, true, path);
+  return mapped;
+}
+
+void MappedFile::Release() {
+  if (data_ != nullptr) {
+    munmap(data_, size_);
+  }
+  data_ = nullptr;
+  size_ = 0;
+}
+
+#endif
+
+CsrSnapshot CsrSnapshot::Open(const std::filesystem::path &path) {
+  CsrSnapshot snapshot;
+  snapshot.file_ = MappedFile::OpenReadOnly(path);
+  auto &header = snapshot.header_;
+  const auto fail = [&](const std::string &reason) {
+    throw std::runtime_error(path.string() + " is not a CSR snapshot: " + reason);
+  };
+  if (snapshot.file_.Size() < sizeof(header)) {
+    fail("shorter than the header");
+  }
+  std::memcpy(&header, snapshot.file_.Data(), sizeof(header));
+  if (header.magic != CsrSnapshotHeader::kMagic) {
+    fail("bad magic");
+  }
+  if (header.version != CsrSnapshotHeader::kVersion) {
+    fail("unsupported version " + std::to_string(header.version));
+  }
+  if (WeightSize(header.weight_type) == 0) {
+    fail("unknown weight type");
+  }
+  if (header.vertices < 0 || header.vertices >= INT_MAX || header.edges < 0 || header.edges > INT_MAX) {
+    fail("bad graph size");
+  }
+  const auto expected = MakeHeader(header.vertices, header.edges, header.source, header.weight_type);
+  if (header.row_ptr_offset != expected.row_ptr_offset || header.col_idx_offset != expected.col_idx_offset ||
+      header.weights_offset != expected.weights_offset || snapshot.file_.Size() < FileSize(header)) {
+    fail("sections out of place or truncated");
+  }
+  // One pass over the offsets and one over the columns, so a corrupt file fails here rather than inside a task
+  const auto row_ptr = snapshot.RowPtr();
+  if (row_ptr.front() != 0 || row_ptr.back() != header.edges || !std::ranges::is_sorted(row_ptr)) {
+    fail("row_ptr is not a CSR offset array of the edges");
+  }
+  if (std::ranges::any_of(snapshot.ColIdx(), [&](int column) { return column < 0 || column >= header.vertices; })) {
+    fail("column index out of range");
+  }
+  if (header.source < 0 || (header.vertices > 0 && header.source >= header.vertices)) {
+    fail("source vertex out of range");
+  }
+  return snapshot;
+}
+
+void detail::WriteCsrSnapshot(const std::filesystem::path &path, std::span<const int> row_ptr,
+                              std::span<const int> col_idx, const void *weights, CsrWeightType weight_type,
+                              int source) {
+  if (row_ptr.empty() || row_ptr.front() != 0 || static_cast<std::size_t>(row_ptr.back()) != col_idx.size() ||
+      !std::ranges::is_sorted(row_ptr)) {
+    throw std::runtime_error("WriteCsrSnapshot: row_ptr is not a CSR offset array of col_idx");
+  }
+  const auto vertices = static_cast<std::int64_t>(row_ptr.size()) - 1;
+  CheckGraphSize(vertices, static_cast<std::int64_t>(col_idx.size()));
+  CheckSource(source, vertices);
+  if (std::ranges::any_of(col_idx, [&](int column) { return column < 0 || column >= vertices; })) {
+    throw std::runtime_error("WriteCsrSnapshot: column index out of range");
+  }
+
+  const auto header = MakeHeader(vertices, static_cast<std::int64_t>(col_idx.size()), source, weight_type);
+  auto file = CreateSnapshotFile(path, header);
+  std::memcpy(file.Data() + header.row_ptr_offset, row_ptr.data(), row_ptr.size_bytes());
+  if (!col_idx.empty()) {
+    std::memcpy(file.Data() + header.col_idx_offset, col_idx.data(), col_idx.size_bytes());
+    std::memcpy(file.Data() + header.weights_offset, weights, WeightSize(weight_type) * col_idx.size());
+  }
+}
+
+void GenerateCsrSnapshot(const std::filesystem::path &path, const GraphGeneratorOptions &options,
+                         CsrWeightType weight_type) {
+  CheckGeneratorOptions(options, weight_type);
+  VisitWeightType(weight_type, [&]<typename W>(std::type_identity<W>) { GenerateSnapshot<W>(path, options); });
+}
+
+void ConvertEdgeListToCsrSnapshot(const std::filesystem::path &text_path, const std::filesystem::path &snapshot_path,
+                                  CsrWeightType weight_type) {
+  const auto text = ReadTextFile(text_path);
+  VisitWeightType(weight_type, [&]<typename W>(std::type_identity<W>) { ConvertEdgeList<W>(text, snapshot_path); });
+}
+
+std::filesystem::path CachedEdgeListSnapshot(const std::filesystem::path &text_path, CsrWeightType weight_type) {
+  const auto absolute = std::filesystem::absolute(text_path);
+  const auto key = std::hash<std::string>{}(absolute.string());
+  auto snapshot = CacheDirectory() / (absolute.stem().string() + "_" + std::to_string(key) + "_" +
+                                      WeightTypeSuffix(weight_type) + ".csr");
+  std::error_code error;
+  if (std::filesystem::exists(snapshot, error) &&
+      std::filesystem::last_write_time(snapshot, error) >= std::filesystem::last_write_time(absolute)) {
+    return snapshot;
+  }
+  WriteAtomically(snapshot, [&](const std::filesystem::path &temp) {
+    ConvertEdgeListToCsrSnapshot(absolute, temp, weight_type);
+  });
+  return snapshot;
+}
+
+std::filesystem::path CachedGeneratedSnapshot(const GraphGeneratorOptions &options, CsrWeightType weight_type) {
+  // The name spells out the options a PPC_PERF_GRAPH spec sets, the others enter through a hash
+  std::ostringstream others;
+  others << options.min_weight << ' ' << options.max_weight << ' ' << options.source << ' ' << options.a << ' '
+         << options.b << ' ' << options.c;
+  const std::string name = std::string(options.model == GraphModel::kRmat ? "rmat_" : "er_") +
+                           std::to_string(options.vertices) + "_" + std::to_string(options.edges) + "_" +
+                           std::to_string(options.seed) + "_" + std::to_string(std::hash<std::string>{}(others.str())) +
+                           "_" + WeightTypeSuffix(weight_type) + ".csr";
+  auto snapshot = CacheDirectory() / name;
+  std::error_code error;
+  if (!std::filesystem::exists(snapshot, error)) {
+    WriteAtomically(snapshot,
+                    [&](const std::filesystem::path &temp) { GenerateCsrSnapshot(temp, options, weight_type); });
+  }
+  return snapshot;
+}
+
+std::optional<std::filesystem::path> GetPerfGraphSnapshot(CsrWeightType weight_type) {
+  const auto value = env::get<std::string>("PPC_PERF_GRAPH");
+  if (!value.has_value() || value->empty()) {
+    return std::nullopt;
+  }
+  const auto options = ParseGraphSpec(*value);
+  if (!options.has_value()) {
+    if (!std::filesystem::exists(*value)) {
+      throw std::runtime_error("PPC_PERF_GRAPH names a missing snapshot " + *value);
+    }
+    return std::filesystem::path(*value);
+  }
+  return CachedGeneratedSnapshot(*options, weight_type);
+}
+
+std::optional<std::filesystem::path> PrepareSnapshotPerNode(
+    MPI_Comm comm, const std::function<std::optional<std::filesystem::path>()> &make) {
+  MPI_Comm node_comm = MPI_COMM_NULL;
+  MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &node_comm);
+  int node_rank = 0;
+  MPI_Comm_rank(node_comm, &node_rank);
+
+  // The leader sends {state, length} and then the path or the error message; state 0 is nullopt, 1 a path, 2 an error
+  std::array<int, 2> header = {0, 0};
+  std::string text;
+  if (node_rank == 0) {
+    try {
+      const auto path = make();
+      if (path.has_value()) {
+        text = path->string();
+        header[0] = 1;
+      }
+    } catch (const std::exception &e) {
+      text = e.what();
+      header[0] = 2;
+    }
+    header[1] = static_cast<int>(text.size());
+  }
+  MPI_Bcast(header.data(), static_cast<int>(header.size()), MPI_INT, 0, node_comm);
+  text.resize(static_cast<std::size_t>(header[1]));
+  MPI_Bcast(text.data(), header[1], MPI_CHAR, 0, node_comm);
+  MPI_Comm_free(&node_comm);
+
+  if (header[0] == 2) {
+    throw std::runtime_error(text);
+  }
+  if (header[0] == 0) {
+    return std::nullopt;
+  }
+  return std::filesystem::path(text);
+}
+
+}  // namespace ppc::util
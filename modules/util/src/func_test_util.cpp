@@ -1,5 +1,13 @@
 #include <mpi.h>
 
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "performance/include/performance.hpp"
+#include "util/include/alloc_tracker.hpp"
 #include "util/include/perf_test_util.hpp"
 
 double ppc::util::GetTimeMPI() {
@@ -11,3 +19,76 @@ int ppc::util::GetMPIRank() {
   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
   return rank;
 }
+
+int ppc::util::GetMPIWorldSize() {
+  int size = 1;
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  return size;
+}
+
+std::string ppc::util::GetHostName() {
+  int initialized = 0;
+  MPI_Initialized(&initialized);
+  if (initialized == 0) {
+    return "unknown";
+  }
+  std::string name(MPI_MAX_PROCESSOR_NAME, '\0');
+  int length = 0;
+  MPI_Get_processor_name(name.data(), &length);
+  name.resize(static_cast<std::size_t>(length));
+  return name;
+}
+
+// Harness-side collectives call the PMPI_ entry points directly so that the optional
+// PMPI profiler (USE_MPI_PROFILER) attributes only the task's own communication.
+void ppc::util::BarrierMPI() {
+  PMPI_Barrier(MPI_COMM_WORLD);
+}
+
+void ppc::util::ReduceRankTimesMPI(ppc::performance::PerfResults &perf_results) {
+  int world_size = 1;
+  MPI_Comm_size(MPI_COMM_WORLD, &world_size);
+
+  auto &samples = perf_results.samples;
+  std::vector<double> critical_path(samples.size());
+  PMPI_Allreduce(samples.data(), critical_path.data(), static_cast<int>(samples.size()), MPI_DOUBLE, MPI_MAX,
+                 MPI_COMM_WORLD);
+
+  const double local_time = perf_results.time_sec;
+  double min_time = 0.0;
+  double max_time = 0.0;
+  double sum_time = 0.0;
+  PMPI_Allreduce(&local_time, &min_time, 1, MPI_DOUBLE, MPI_MIN, MPI_COMM_WORLD);
+  PMPI_Allreduce(&local_time, &max_time, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+  PMPI_Allreduce(&local_time, &sum_time, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+
+  // Every stage is reported for its slowest rank
+  auto &stage_seconds = perf_results.stage_times.seconds;
+  PMPI_Allreduce(MPI_IN_PLACE, stage_seconds.data(), static_cast<int>(stage_seconds.size()), MPI_DOUBLE, MPI_MAX,
+                 MPI_COMM_WORLD);
+  if (ppc::util::AllocTracker::IsEnabled()) {
+    std::vector<uint64_t> alloc_values;
+    for (const auto &stage_alloc : perf_results.stage_allocations) {
+      alloc_values.insert(alloc_values.end(), {stage_alloc.bytes, stage_alloc.allocations, stage_alloc.peak_heap_bytes,
+                                               stage_alloc.process_peak_rss_kb});
+    }
+    PMPI_Allreduce(MPI_IN_PLACE, alloc_values.data(), static_cast<int>(alloc_values.size()), MPI_UINT64_T, MPI_MAX,
+                   MPI_COMM_WORLD);
+    for (std::size_t i = 0; i < perf_results.stage_allocations.size(); i++) {
+      auto &stage_alloc = perf_results.stage_allocations[i];
+      stage_alloc.bytes = alloc_values[(i * 4) + 0];
+      stage_alloc.allocations = alloc_values[(i * 4) + 1];
+      stage_alloc.peak_heap_bytes = alloc_values[(i * 4) + 2];
+      stage_alloc.process_peak_rss_kb = alloc_values[(i * 4) + 3];
+    }
+  }
+
+  samples = std::move(critical_path);
+  ppc::performance::CalculateStatistics(perf_results);
+
+  perf_results.num_ranks = world_size;
+  perf_results.rank_time_min = min_time;
+  perf_results.rank_time_max = max_time;
+  perf_results.rank_time_mean = sum_time / static_cast<double>(world_size);
+  perf_results.load_imbalance = perf_results.rank_time_mean > 0.0 ? max_time / perf_results.rank_time_mean : 1.0;
+}
@@ -0,0 +1,98 @@
+#include "util/include/node_shared.hpp"
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+namespace {
+
+constexpr auto kMaxBcastChunk = static_cast<std::size_t>(std::numeric_limits<int>::max());
+
+}  // namespace
+
+ppc::util::NodeSharedBuffer::NodeSharedBuffer(const void *root_data, std::size_t bytes, MPI_Comm comm, int root) {
+  int rank = 0;
+  MPI_Comm_rank(comm, &rank);
+  auto size = static_cast<uint64_t>(bytes);
+  MPI_Bcast(&size, 1, MPI_UINT64_T, root, comm);
+  size_ = static_cast<std::size_t>(size);
+
+  // The root sorts first, so it leads its node and is rank 0 among the leaders
+  const int key = rank == root ? 0 : rank + 1;
+  MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, key, MPI_INFO_NULL, &node_comm_);
+  int node_rank = 0;
+  MPI_Comm_rank(node_comm_, &node_rank);
+  node_leader_ = node_rank == 0;
+
+  MPI_Comm leader_comm = MPI_COMM_NULL;
+  MPI_Comm_split(comm, node_leader_ ? 0 : MPI_UNDEFINED, key, &leader_comm);
+
+  void *base = nullptr;
+  MPI_Win_allocate_shared(static_cast<MPI_Aint>(node_leader_ ? size_ : 0), 1, MPI_INFO_NULL, node_comm_, &base,
+                          &win_);
+  if (!node_leader_) {
+    MPI_Aint segment_size = 0;
+    int disp_unit = 0;
+    MPI_Win_shared_query(win_, 0, &segment_size, &disp_unit, &base);
+  }
+  MPI_Win_lock_all(MPI_MODE_NOCHECK, win_);
+
+  if (node_leader_) {
+    auto *segment = static_cast<std::byte *>(base);
+    if (rank == root && size_ > 0) {
+      std::memcpy(segment, root_data, size_);
+    }
+    for (std::size_t offset = 0; offset < size_; offset += kMaxBcastChunk) {
+      const auto chunk = static_cast<int>(std::min(kMaxBcastChunk, size_ - offset));
+      MPI_Bcast(segment + offset, chunk, MPI_BYTE, 0, leader_comm);
+    }
+    MPI_Comm_free(&leader_comm);
+  }
+
+  // Publish the leader's writes to the other ranks of the node
+  MPI_Win_sync(win_);
+  MPI_Barrier(node_comm_);
+  MPI_Win_sync(win_);
+  data_ = static_cast<const std::byte *>(base);
+}
+
+ppc::util::NodeSharedBuffer::~NodeSharedBuffer() {
+  Release();
+}
+
+ppc::util::NodeSharedBuffer::NodeSharedBuffer(NodeSharedBuffer &&other) noexcept
+    : data_(std::exchange(other.data_, nullptr)),
+      size_(std::exchange(other.size_, 0)),
+      node_leader_(std::exchange(other.node_leader_, false)),
+      win_(std::exchange(other.win_, MPI_WIN_NULL)),
+      node_comm_(std::exchange(other.node_comm_, MPI_COMM_NULL)) {}
+
+ppc::util::NodeSharedBuffer &ppc::util::NodeSharedBuffer::operator=(NodeSharedBuffer &&other) noexcept {
+  if (this != &other) {
+    Release();
+    data_ = std::exchange(other.data_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+    node_leader_ = std::exchange(other.node_leader_, false);
+    win_ = std::exchange(other.win_, MPI_WIN_NULL);
+    node_comm_ = std::exchange(other.node_comm_, MPI_COMM_NULL);
+  }
+  return *this;
+}
+
+void ppc::util::NodeSharedBuffer::Release() {
+  if (win_ != MPI_WIN_NULL) {
+    MPI_Win_unlock_all(win_);
+    MPI_Win_free(&win_);
+  }
+  if (node_comm_ != MPI_COMM_NULL) {
+    MPI_Comm_free(&node_comm_);
+  }
+  data_ = nullptr;
+  size_ = 0;
+  node_leader_ = false;
+}
@@ -0,0 +1,135 @@
+#include "util/include/partition.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace {
+
+void CheckShape(int total, int parts) {
+  if (total < 0 || parts <= 0) {
+    throw std::runtime_error("Partition: total must be non-negative and parts positive");
+  }
+}
+
+}  // namespace
+
+ppc::util::Partition::Partition(int total, std::vector<int> counts, std::vector<int> displs, int block_size)
+    : total_(total), block_size_(block_size), counts_(std::move(counts)), displs_(std::move(displs)) {}
+
+std::vector<int> ppc::util::Partition::PrefixSums(const std::vector<int> &counts) {
+  std::vector<int> displs(counts.size(), 0);
+  std::exclusive_scan(counts.begin(), counts.end(), displs.begin(), 0);
+  return displs;
+}
+
+ppc::util::Partition ppc::util::Partition::Block(int total, int parts) {
+  CheckShape(total, parts);
+  std::vector<int> counts(static_cast<std::size_t>(parts));
+  for (int part = 0; part < parts; part++) {
+    counts[static_cast<std::size_t>(part)] = (total / parts) + (part < total % parts ? 1 : 0);
+  }
+  auto displs = PrefixSums(counts);
+  return {total, std::move(counts), std::move(displs), 0};
+}
+
+ppc::util::Partition ppc::util::Partition::Cyclic(int total, int parts) {
+  return BlockCyclic(total, parts, 1);
+}
+
+ppc::util::Partition ppc::util::Partition::BlockCyclic(int total, int parts, int block_size) {
+  CheckShape(total, parts);
+  if (block_size <= 0) {
+    throw std::runtime_error("Partition: block size must be positive");
+  }
+  const int blocks = (total + block_size - 1) / block_size;
+  std::vector<int> counts(static_cast<std::size_t>(parts));
+  for (int part = 0; part < parts; part++) {
+    counts[static_cast<std::size_t>(part)] = ((blocks / parts) + (part < blocks % parts ? 1 : 0)) * block_size;
+  }
+  if (blocks > 0) {
+    // The last block may be short
+    counts[static_cast<std::size_t>((blocks - 1) % parts)] -= (blocks * block_size) - total;
+  }
+  auto displs = PrefixSums(counts);
+  return {total, std::move(counts), std::move(displs), block_size};
+}
+
+ppc::util::Partition ppc::util::Partition::Weighted(int total, std::span<const double> weights) {
+  CheckShape(total, static_cast<int>(weights.size()));
+  const double weight_sum = std::accumulate(weights.begin(), weights.end(), 0.0);
+  if (std::ranges::any_of(weights, [](double weight) { return !(weight >= 0.0) || std::isinf(weight); }) ||
+      weight_sum <= 0.0) {
+    throw std::runtime_error("Partition: weights must be finite, non-negative and not all zero");
+  }
+
+  std::vector<int> counts(weights.size());
+  std::vector<std::pair<double, std::size_t>> remainders(weights.size());
+  int assigned = 0;
+  for (std::size_t part = 0; part < weights.size(); part++) {
+    const double exact = static_cast<double>(total) * weights[part] / weight_sum;
+    counts[part] = static_cast<int>(std::floor(exact));
+    remainders[part] = {exact - counts[part], part};
+    assigned += counts[part];
+  }
+  // Hand the indices lost to rounding down to the parts with the largest remainders, lower parts first on ties
+  std::ranges::stable_sort(remainders, [](const auto &a, const auto &b) { return a.first > b.first; });
+  for (std::size_t i = 0; assigned < total; i = (i + 1) % remainders.size(), assigned++) {
+    counts[remainders[i].second]++;
+  }
+  auto displs = PrefixSums(counts);
+  return {total, std::move(counts), std::move(displs), 0};
+}
+
+int ppc::util::Partition::Owner(int index) const {
+  if (index < 0 || index >= total_) {
+    throw std::runtime_error("Partition: index out of range");
+  }
+  if (!IsContiguous()) {
+    return (index / block_size_) % Parts();
+  }
+  // The last part starting at or before index; empty parts share the offset of the next one
+  const auto it = std::ranges::upper_bound(displs_, index);
+  return static_cast<int>(it - displs_.begin()) - 1;
+}
+
+int ppc::util::Partition::LocalIndex(int index) const {
+  if (!IsContiguous()) {
+    if (index < 0 || index >= total_) {
+      throw std::runtime_error("Partition: index out of range");
+    }
+    return ((index / block_size_ / Parts()) * block_size_) + (index % block_size_);
+  }
+  return index - displs_[static_cast<std::size_t>(Owner(index))];
+}
+
+int ppc::util::Partition::GlobalIndex(int part, int local) const {
+  if (IsContiguous()) {
+    return displs_[static_cast<std::size_t>(part)] + local;
+  }
+  return ((((local / block_size_) * Parts()) + part) * block_size_) + (local % block_size_);
+}
+
+ppc::util::Partition ppc::util::Partition::WithHalo(int halo) const {
+  if (!IsContiguous() || halo < 0) {
+    throw std::runtime_error("Partition: halos need a contiguous partition and a non-negative width");
+  }
+  std::vector<int> counts(counts_.size());
+  std::vector<int> displs(displs_.size());
+  for (std::size_t part = 0; part < counts_.size(); part++) {
+    if (counts_[part] == 0) {
+      displs[part] = displs_[part];
+      continue;
+    }
+    const int begin = std::max(0, displs_[part] - halo);
+    const int end = std::min(total_, displs_[part] + counts_[part] + halo);
+    displs[part] = begin;
+    counts[part] = end - begin;
+  }
+  return {total_, std::move(counts), std::move(displs), 0};
+}
@@ -0,0 +1,343 @@
+#include "util/include/perf_report.hpp"
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <libenvpp/detail/get.hpp>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "performance/include/hw_counters.hpp"
+#include "performance/include/performance.hpp"
+#include "task/include/task.hpp"
+#include "util/include/alloc_tracker.hpp"
+#include "util/include/util.hpp"
+
+namespace {
+
+using ppc::performance::GetHwCounterName;
+using ppc::performance::HwCounterType;
+using ppc::performance::kNumHwCounters;
+
+std::vector<std::string> GetCsvHeader() {
+  std::vector<std::string> header = {"task",          "implementation", "mode",          "num_proc",
+                                     "num_threads",   "input_size",     "time_sec",      "time_min",
+                                     "time_median",   "time_p90",       "time_p99",      "time_max",
+                                     "time_stddev",   "time_ci95",      "num_samples",   "num_ranks",
+                                     "rank_time_min", "rank_time_max",  "rank_time_mean", "load_imbalance"};
+  for (std::size_t i = 0; i < kNumHwCounters; i++) {
+    header.push_back(GetHwCounterName(static_cast<HwCounterType>(i)));
+  }
+  for (std::size_t i = 0; i < ppc::task::kNumTaskStages; i++) {
+    header.push_back("stage_" + ppc::task::GetTaskStageName(static_cast<ppc::task::TaskStage>(i)));
+  }
+  for (const char *column : {"scaling", "base_size", "workers", "seq_time_sec", "speedup", "efficiency"}) {
+    header.emplace_back(column);
+  }
+  header.emplace_back("batch_size");
+  header.emplace_back("throughput");
+  header.emplace_back("in_flight");
+  header.emplace_back("bind");
+  header.emplace_back("core_map");
+  header.emplace_back("host");
+  header.emplace_back("revision");
+  return header;
+}
+
+std::string EscapeCsv(const std::string &value) {
+  if (value.find_first_of(",\"\n") == std::string::npos) {
+    return value;
+  }
+  std::string escaped = "\"";
+  for (char ch : value) {
+    if (ch == '"') {
+      escaped += '"';
+    }
+    escaped += ch;
+  }
+  return escaped + "\"";
+}
+
+std::string ToCsvRow(const ppc::util::PerfRecord &record) {
+  const auto &res = record.results;
+  std::stringstream row;
+  row << std::setprecision(10);
+  row << EscapeCsv(record.task) << ',' << record.implementation << ',' << record.mode << ',' << record.num_proc << ','
+      << record.num_threads << ',' << record.input_size << ',' << res.time_sec << ',' << res.time_min << ','
+      << res.time_median << ',' << res.time_p90 << ',' << res.time_p99 << ',' << res.time_max << ','
+      << res.time_stddev << ',' << res.time_ci95 << ',' << res.samples.size() << ',' << res.num_ranks << ','
+      << res.rank_time_min << ',' << res.rank_time_max << ',' << res.rank_time_mean << ',' << res.load_imbalance;
+  for (double value : res.hw_counters.values) {
+    row << ',';
+    if (value >= 0.0) {
+      row << value;
+    }
+  }
+  for (std::size_t i = 0; i < ppc::task::kNumTaskStages; i++) {
+    row << ',';
+    if (res.stage_times.calls[i] > 0) {
+      row << res.stage_times.seconds[i];
+    }
+  }
+  const auto &scaling = record.scaling;
+  row << ',' << ppc::util::PerfScalingModeToString(scaling.mode);
+  if (scaling.mode == ppc::util::PerfScalingMode::kNone) {
+    row << ",,,,,";
+  } else {
+    row << ',' << scaling.base_size << ',' << scaling.workers << ',' << scaling.seq_time_sec << ','
+        << scaling.speedup << ',' << scaling.efficiency;
+  }
+  row << ',';
+  if (record.batch_size > 0) {
+    row << record.batch_size;
+  }
+  row << ',';
+  if (record.batch_size > 0 || record.in_flight > 0) {
+    row << record.throughput;
+  }
+  row << ',';
+  if (record.in_flight > 0) {
+    row << record.in_flight;
+  }
+  row << ',' << record.bind << ',' << EscapeCsv(record.core_map);
+  row << ',' << EscapeCsv(record.host) << ',' << EscapeCsv(record.revision);
+  return row.str();
+}
+
+}  // namespace
+
+std::string ppc::util::GetPerfOutputPath() {
+  const auto path = env::get<std::string>("PPC_PERF_OUTPUT");
+  if (path.has_value()) {
+    return path.value();
+  }
+  return {};
+}
+
+std::string ppc::util::GetGitRevision() {
+#ifdef PPC_GIT_REVISION
+  return PPC_GIT_REVISION;
+#else
+  return "unknown";
+#endif
+}
+
+namespace {
+
+ppc::util::ProcessBinding &ProcessBindingStorage() {
+  static ppc::util::ProcessBinding binding;
+  return binding;
+}
+
+}  // namespace
+
+void ppc::util::SetProcessBinding(ProcessBinding binding) {
+  ProcessBindingStorage() = std::move(binding);
+}
+
+const ppc::util::ProcessBinding &ppc::util::GetProcessBinding() {
+  return ProcessBindingStorage();
+}
+
+ppc::util::PerfRecordKey ppc::util::GetPerfRecordKey(const PerfRecord &record) {
+  return {.task = record.task,
+          .implementation = record.implementation,
+          .mode = record.mode,
+          .num_proc = record.num_proc,
+          .num_threads = record.num_threads};
+}
+
+ppc::util::PerfBaselineStore ppc::util::PerfBaselineStore::Load(const std::string &path) {
+  std::ifstream file(path);
+  if (!file.is_open()) {
+    throw std::runtime_error("Failed to open perf baseline " + path);
+  }
+  PerfBaselineStore store;
+  std::string line;
+  while (std::getline(file, line)) {
+    if (line.empty()) {
+      continue;
+    }
+    const auto json = nlohmann::json::parse(line);
+    if (json.contains("scaling")) {
+      continue;
+    }
+    auto record = PerfRecordFromJson(json);
+    store.records_.insert_or_assign(GetPerfRecordKey(record), std::move(record));
+  }
+  return store;
+}
+
+const ppc::util::PerfRecord *ppc::util::PerfBaselineStore::Find(const PerfRecordKey &key) const {
+  const auto it = records_.find(key);
+  return it == records_.end() ? nullptr : &it->second;
+}
+
+const ppc::util::PerfBaselineStore &ppc::util::GetPerfBaseline() {
+  static const PerfBaselineStore kBaseline = [] {
+    const auto path = env::get<std::string>("PPC_PERF_BASELINE");
+    return path.has_value() && !path.value().empty() ? PerfBaselineStore::Load(path.value()) : PerfBaselineStore{};
+  }();
+  return kBaseline;
+}
+
+double ppc::util::GetPerfRegressionThreshold() {
+  const auto val = env::get<double>("PPC_PERF_REGRESSION_THRESHOLD");
+  if (val.has_value()) {
+    return val.value();
+  }
+  return 0.1;
+}
+
+bool ppc::util::IsPerfRegressionFatal() {
+  const auto val = env::get<int>("PPC_PERF_FAIL_ON_REGRESSION");
+  return val.has_value() && val.value() != 0;
+}
+
+ppc::util::PerfRecord ppc::util::PerfRecordFromJson(const nlohmann::json &json) {
+  PerfRecord record;
+  record.task = json.at("task").get<std::string>();
+  record.implementation = json.at("implementation").get<std::string>();
+  record.mode = json.at("mode").get<std::string>();
+  record.num_proc = json.at("num_proc").get<int>();
+  record.num_threads = json.at("num_threads").get<int>();
+  record.input_size = json.value("input_size", std::size_t{0});
+  record.host = json.value("host", std::string{});
+  record.revision = json.value("revision", std::string{});
+  record.bind = json.value("bind", std::string{"none"});
+  record.core_map = json.value("core_map", std::string{});
+  if (json.contains("batch")) {
+    record.batch_size = json.at("batch").value("size", std::size_t{0});
+    record.throughput = json.at("batch").value("throughput", 0.0);
+  }
+  if (json.contains("in_flight")) {
+    record.in_flight = json.at("in_flight").value("tasks", 0);
+    record.throughput = json.at("in_flight").value("throughput", 0.0);
+  }
+  auto &res = record.results;
+  res.time_sec = json.at("time_sec").get<double>();
+  res.samples = json.value("samples", std::vector<double>{});
+  ppc::performance::CalculateStatistics(res);
+  res.num_ranks = json.value("num_ranks", 1);
+  res.rank_time_min = json.value("rank_time_min", 0.0);
+  res.rank_time_max = json.value("rank_time_max", 0.0);
+  res.rank_time_mean = json.value("rank_time_mean", 0.0);
+  res.load_imbalance = json.value("load_imbalance", 1.0);
+  return record;
+}
+
+nlohmann::json ppc::util::PerfRecordToJson(const PerfRecord &record) {
+  const auto &res = record.results;
+  nlohmann::json json;
+  json["task"] = record.task;
+  json["implementation"] = record.implementation;
+  json["mode"] = record.mode;
+  json["num_proc"] = record.num_proc;
+  json["num_threads"] = record.num_threads;
+  json["input_size"] = record.input_size;
+  json["time_sec"] = res.time_sec;
+  json["time_min"] = res.time_min;
+  json["time_median"] = res.time_median;
+  json["time_p90"] = res.time_p90;
+  json["time_p99"] = res.time_p99;
+  json["time_max"] = res.time_max;
+  json["time_stddev"] = res.time_stddev;
+  json["time_ci95"] = res.time_ci95;
+  json["samples"] = res.samples;
+  json["num_ranks"] = res.num_ranks;
+  json["rank_time_min"] = res.rank_time_min;
+  json["rank_time_max"] = res.rank_time_max;
+  json["rank_time_mean"] = res.rank_time_mean;
+  json["load_imbalance"] = res.load_imbalance;
+  json["hw_counters"] = nlohmann::json::object();
+  for (std::size_t i = 0; i < kNumHwCounters; i++) {
+    if (res.hw_counters.values[i] >= 0.0) {
+      json["hw_counters"][GetHwCounterName(static_cast<HwCounterType>(i))] = res.hw_counters.values[i];
+    }
+  }
+  json["stages"] = nlohmann::json::object();
+  for (std::size_t i = 0; i < ppc::task::kNumTaskStages; i++) {
+    if (res.stage_times.calls[i] > 0) {
+      json["stages"][ppc::task::GetTaskStageName(static_cast<ppc::task::TaskStage>(i))] = res.stage_times.seconds[i];
+    }
+  }
+  if (AllocTracker::IsEnabled()) {
+    json["stage_allocations"] = nlohmann::json::object();
+    for (std::size_t i = 0; i < ppc::task::kNumTaskStages; i++) {
+      if (res.stage_times.calls[i] == 0) {
+        continue;
+      }
+      const auto &stage_alloc = res.stage_allocations[i];
+      json["stage_allocations"][ppc::task::GetTaskStageName(static_cast<ppc::task::TaskStage>(i))] = {
+          {"bytes", stage_alloc.bytes},
+          {"allocations", stage_alloc.allocations},
+          {"peak_heap_bytes", stage_alloc.peak_heap_bytes},
+          {"process_peak_rss_kb", stage_alloc.process_peak_rss_kb}};
+    }
+  }
+  if (record.scaling.mode != PerfScalingMode::kNone) {
+    const auto &scaling = record.scaling;
+    json["scaling"] = {{"mode", PerfScalingModeToString(scaling.mode)},
+                       {"base_size", scaling.base_size},
+                       {"workers", scaling.workers},
+                       {"seq_time_sec", scaling.seq_time_sec},
+                       {"speedup", scaling.speedup},
+                       {"efficiency", scaling.efficiency}};
+  }
+  if (record.batch_size > 0) {
+    json["batch"] = {{"size", record.batch_size}, {"throughput", record.throughput}};
+  }
+  if (record.in_flight > 0) {
+    json["in_flight"] = {{"tasks", record.in_flight}, {"throughput", record.throughput}};
+  }
+  json["bind"] = record.bind;
+  json["core_map"] = record.core_map;
+  json["host"] = record.host;
+  json["revision"] = record.revision;
+  return json;
+}
+
+ppc::util::ScalingPoint ppc::util::MakeScalingPoint(PerfScalingMode mode, std::size_t base_size, int workers,
+                                                    double seq_time_sec, double par_time_sec) {
+  ScalingPoint point;
+  point.mode = mode;
+  point.base_size = base_size;
+  point.workers = workers;
+  point.seq_time_sec = seq_time_sec;
+  if (seq_time_sec <= 0.0 || par_time_sec <= 0.0 || workers <= 0) {
+    return point;
+  }
+  point.speedup = seq_time_sec / par_time_sec;
+  if (mode == PerfScalingMode::kWeak) {
+    point.speedup *= static_cast<double>(workers);
+  }
+  point.efficiency = point.speedup / static_cast<double>(workers);
+  return point;
+}
+
+void ppc::util::AppendPerfRecord(const std::string &path, const PerfRecord &record) {
+  const bool is_csv = std::filesystem::path(path).extension() == ".csv";
+  std::error_code ec;
+  const bool is_new = !std::filesystem::exists(path, ec) || std::filesystem::file_size(path, ec) == 0;
+
+  std::ofstream file(path, std::ios::app);
+  if (!file.is_open()) {
+    throw std::runtime_error("Failed to open " + path);
+  }
+  if (!is_csv) {
+    file << PerfRecordToJson(record).dump() << '\n';
+    return;
+  }
+  if (is_new) {
+    const auto header = GetCsvHeader();
+    for (std::size_t i = 0; i < header.size(); i++) {
+      file << (i == 0 ? "" : ",") << header[i];
+    }
+    file << '\n';
+  }
+  file << ToCsvRow(record) << '\n';
+}
@@ -0,0 +1,129 @@
+#include "util/include/runtime.hpp"
+
+#include <omp.h>
+
+#include <libenvpp/detail/get.hpp>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+
+#include "oneapi/tbb/task_arena.h"
+#include "util/include/thread_pool.hpp"
+#include "util/include/util.hpp"
+
+namespace {
+
+struct RuntimeState {
+  std::mutex mutex;
+  std::unique_ptr<ppc::util::ThreadPool> pool;
+  std::unique_ptr<tbb::task_arena> arena;
+};
+
+// Separate from RuntimeState::mutex: GetThreadPool() joins the old workers under it, and a worker may destroy a task
+struct OmpReleaseState {
+  std::mutex mutex;
+  ppc::util::OmpPoolPolicy policy = ppc::util::OmpPoolPolicy::kPersistent;
+  int async_stages = 0;
+  bool release_pending = false;
+};
+
+RuntimeState &GetRuntimeState() {
+  static RuntimeState state;
+  return state;
+}
+
+OmpReleaseState &GetOmpReleaseState() {
+  static OmpReleaseState state;
+  return state;
+}
+
+void PauseOmpThreads() {
+#if _OPENMP >= 201811
+  omp_pause_resource_all(omp_pause_soft);
+#endif
+}
+
+}  // namespace
+
+ppc::util::OmpPoolPolicy ppc::util::GetOmpPoolPolicy() {
+  const auto val = env::get<std::string>("PPC_OMP_POOL");
+  if (!val.has_value() || val.value().empty() || val.value() == "persistent") {
+    return OmpPoolPolicy::kPersistent;
+  }
+  if (val.value() == "pause") {
+    return OmpPoolPolicy::kPause;
+  }
+  throw std::runtime_error("Unknown PPC_OMP_POOL value: " + val.value());
+}
+
+std::string ppc::util::GetOmpPoolPolicyName(OmpPoolPolicy policy) {
+  if (policy == OmpPoolPolicy::kPause) {
+    return "pause";
+  }
+  return "persistent";
+}
+
+ppc::util::ThreadPool &ppc::util::Runtime::GetThreadPool() {
+  auto &state = GetRuntimeState();
+  const int budget = GetRankThreadBudget();
+  std::lock_guard lock(state.mutex);
+  if (!state.pool || state.pool->Size() != budget) {
+    state.pool.reset();
+    state.pool = std::make_unique<ThreadPool>(budget);
+  }
+  return *state.pool;
+}
+
+tbb::task_arena &ppc::util::Runtime::GetTaskArena() {
+  auto &state = GetRuntimeState();
+  const int budget = GetRankThreadBudget();
+  std::lock_guard lock(state.mutex);
+  if (!state.arena || state.arena->max_concurrency() != budget) {
+    state.arena = std::make_unique<tbb::task_arena>(budget);
+    state.arena->initialize();
+  }
+  return *state.arena;
+}
+
+void ppc::util::Runtime::SetOmpPoolPolicy(OmpPoolPolicy policy) {
+  auto &state = GetOmpReleaseState();
+  std::lock_guard lock(state.mutex);
+  state.policy = policy;
+}
+
+void ppc::util::Runtime::ReleaseTaskResources() noexcept {
+  auto &state = GetOmpReleaseState();
+  std::lock_guard lock(state.mutex);
+  if (state.policy != OmpPoolPolicy::kPause) {
+    return;
+  }
+  if (state.async_stages > 0) {
+    state.release_pending = true;
+    return;
+  }
+  PauseOmpThreads();
+}
+
+void ppc::util::Runtime::BeginAsyncStage() noexcept {
+  auto &state = GetOmpReleaseState();
+  std::lock_guard lock(state.mutex);
+  state.async_stages++;
+}
+
+void ppc::util::Runtime::EndAsyncStage() noexcept {
+  auto &state = GetOmpReleaseState();
+  std::lock_guard lock(state.mutex);
+  state.async_stages--;
+  if (state.async_stages == 0 && state.release_pending) {
+    state.release_pending = false;
+    PauseOmpThreads();
+  }
+}
+
+void ppc::util::Runtime::Shutdown() {
+  auto &state = GetRuntimeState();
+  std::lock_guard lock(state.mutex);
+  state.pool.reset();
+  state.arena.reset();
+}
@@ -0,0 +1,138 @@
+#include "util/include/scatter_gather.hpp"
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "util/include/partition.hpp"
+
+ppc::util::MpiDatatype::~MpiDatatype() {
+  if (type_ != MPI_DATATYPE_NULL) {
+    MPI_Type_free(&type_);
+  }
+}
+
+ppc::util::MpiDatatype::MpiDatatype(MpiDatatype &&other) noexcept
+    : type_(std::exchange(other.type_, MPI_DATATYPE_NULL)) {}
+
+ppc::util::MpiDatatype &ppc::util::MpiDatatype::operator=(MpiDatatype &&other) noexcept {
+  if (this != &other) {
+    if (type_ != MPI_DATATYPE_NULL) {
+      MPI_Type_free(&type_);
+    }
+    type_ = std::exchange(other.type_, MPI_DATATYPE_NULL);
+  }
+  return *this;
+}
+
+ppc::util::MpiDatatype ppc::util::StridedType(MPI_Datatype base, int count, int block_length, int stride,
+                                              int extent) {
+  MPI_Aint lower_bound = 0;
+  MPI_Aint base_extent = 0;
+  MPI_Type_get_extent(base, &lower_bound, &base_extent);
+
+  MPI_Datatype vector = MPI_DATATYPE_NULL;
+  MPI_Type_vector(count, block_length, stride, base, &vector);
+  MPI_Datatype resized = MPI_DATATYPE_NULL;
+  MPI_Type_create_resized(vector, 0, static_cast<MPI_Aint>(extent) * base_extent, &resized);
+  MPI_Type_free(&vector);
+  MPI_Type_commit(&resized);
+  return MpiDatatype(resized);
+}
+
+ppc::util::MpiDatatype ppc::util::BytesType(std::size_t bytes) {
+  MPI_Datatype type = MPI_DATATYPE_NULL;
+  MPI_Type_contiguous(static_cast<int>(bytes), MPI_BYTE, &type);
+  MPI_Type_commit(&type);
+  return MpiDatatype(type);
+}
+
+void ppc::util::detail::CheckPartitionMatchesComm(const Partition &partition, MPI_Comm comm) {
+  int size = 0;
+  MPI_Comm_size(comm, &size);
+  if (partition.Parts() != size) {
+    throw std::runtime_error("The partition has " + std::to_string(partition.Parts()) + " parts for " +
+                             std::to_string(size) + " ranks");
+  }
+}
+
+void ppc::util::detail::ThrowIfAnyRankFailed(const std::string &error, const char *caller, MPI_Comm comm) {
+  int failed = error.empty() ? 0 : 1;
+  MPI_Allreduce(MPI_IN_PLACE, &failed, 1, MPI_INT, MPI_MAX, comm);
+  if (failed == 0) {
+    return;
+  }
+  throw std::runtime_error(error.empty() ? std::string(caller) + ": invalid input on another rank" : error);
+}
+
+void ppc::util::detail::CheckDisjointColumns(const Partition &columns, const char *caller) {
+  // Contiguous parts cover every index once exactly when their counts add up to the total
+  const auto &counts = columns.Counts();
+  if (!columns.IsContiguous() || std::reduce(counts.begin(), counts.end()) != columns.Total()) {
+    throw std::runtime_error(std::string(caller) + ": the column partition must be contiguous without overlaps");
+  }
+}
+
+void ppc::util::detail::CheckHaloNeighbours(const Partition &columns, int halo) {
+  for (int part = 0; part < columns.Parts(); part++) {
+    const int first = columns.Offset(part);
+    const int last = first + columns.Count(part);
+    if (columns.Count(part) == 0) {
+      continue;
+    }
+    const int left = std::min(halo, first);
+    const int right = std::min(halo, columns.Total() - last);
+    if ((left > 0 && columns.Count(columns.Owner(first - 1)) < left) ||
+        (right > 0 && columns.Count(columns.Owner(last)) < right)) {
+      throw std::runtime_error("ExchangeColumnHalos: a halo of " + std::to_string(halo) +
+                               " columns reaches past a neighbouring part");
+    }
+  }
+}
+
+void ppc::util::detail::SendrecvColumnHalos(const void *local, void *extended, MPI_Datatype base, int rows,
+                                            int element_size, const Partition &columns, int halo, MPI_Comm comm) {
+  int rank = 0;
+  MPI_Comm_rank(comm, &rank);
+  const int count = columns.Count(rank);
+  const int first = columns.Offset(rank);
+  const int last = first + count;
+  const bool owns_columns = count > 0;
+  // Ghost columns this rank receives, and the outer columns its neighbours expect in return
+  const int recv_left = owns_columns ? std::min(halo, first) : 0;
+  const int recv_right = owns_columns ? std::min(halo, columns.Total() - last) : 0;
+  const int left_peer = recv_left > 0 ? columns.Owner(first - 1) : MPI_PROC_NULL;
+  const int right_peer = recv_right > 0 ? columns.Owner(last) : MPI_PROC_NULL;
+  const int send_left = left_peer != MPI_PROC_NULL ? std::min(halo, columns.Total() - first) : 0;
+  const int send_right = right_peer != MPI_PROC_NULL ? std::min(halo, last) : 0;
+  const int extended_cols = recv_left + count + recv_right;
+
+  MPI_Aint lower_bound = 0;
+  MPI_Aint base_extent = 0;
+  MPI_Type_get_extent(base, &lower_bound, &base_extent);
+  const auto cell_bytes = static_cast<MPI_Aint>(element_size) * base_extent;
+  const auto *local_bytes = static_cast<const std::byte *>(local);
+  auto *extended_bytes = static_cast<std::byte *>(extended);
+  // width columns of every row of a row_cols-wide block; a zero width is sent as zero items of a one-column type
+  const auto block = [&](int width, int row_cols) {
+    return StridedType(base, rows, std::max(width, 1) * element_size, row_cols * element_size, 1);
+  };
+
+  // Rightwards: the last columns go to the right neighbour while the left ghosts arrive
+  const auto send_right_type = block(send_right, count);
+  const auto recv_left_type = block(recv_left, extended_cols);
+  MPI_Sendrecv(local_bytes + ((count - send_right) * cell_bytes), send_right > 0 ? 1 : 0, send_right_type.Get(),
+               right_peer, 0, extended_bytes, recv_left > 0 ? 1 : 0, recv_left_type.Get(), left_peer, 0, comm,
+               MPI_STATUS_IGNORE);
+  // Leftwards: the first columns go to the left neighbour while the right ghosts arrive
+  const auto send_left_type = block(send_left, count);
+  const auto recv_right_type = block(recv_right, extended_cols);
+  MPI_Sendrecv(local_bytes, send_left > 0 ? 1 : 0, send_left_type.Get(), left_peer, 1,
+               extended_bytes + ((recv_left + count) * cell_bytes), recv_right > 0 ? 1 : 0, recv_right_type.Get(),
+               right_peer, 1, comm, MPI_STATUS_IGNORE);
+}
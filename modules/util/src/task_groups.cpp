@@ -0,0 +1,68 @@
+#include "util/include/task_groups.hpp"
+
+#include <mpi.h>
+
+#include <libenvpp/detail/get.hpp>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+struct TaskGroupState {
+  MPI_Comm comm = MPI_COMM_NULL;
+  int index = 0;
+};
+
+TaskGroupState &GetTaskGroupState() {
+  static TaskGroupState state;
+  return state;
+}
+
+}  // namespace
+
+int ppc::util::GetTaskGroupCount() {
+  const auto val = env::get<int>("PPC_TASK_GROUPS");
+  if (!val.has_value()) {
+    return 1;
+  }
+  if (val.value() < 1) {
+    throw std::runtime_error("PPC_TASK_GROUPS must be positive, got " + std::to_string(val.value()));
+  }
+  return val.value();
+}
+
+void ppc::util::InitTaskGroups() {
+  const int groups = GetTaskGroupCount();
+  if (groups == 1) {
+    return;
+  }
+  int rank = 0;
+  int world_size = 1;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &world_size);
+  if (groups > world_size) {
+    throw std::runtime_error("PPC_TASK_GROUPS=" + std::to_string(groups) + " exceeds the number of processes " +
+                             std::to_string(world_size));
+  }
+
+  auto &state = GetTaskGroupState();
+  state.index = static_cast<int>(static_cast<long long>(rank) * groups / world_size);
+  MPI_Comm_split(MPI_COMM_WORLD, state.index, rank, &state.comm);
+}
+
+void ppc::util::FreeTaskGroups() {
+  auto &state = GetTaskGroupState();
+  if (state.comm != MPI_COMM_NULL) {
+    MPI_Comm_free(&state.comm);
+  }
+  state = {};
+}
+
+MPI_Comm ppc::util::GetTaskGroupComm() {
+  const auto &state = GetTaskGroupState();
+  return state.comm == MPI_COMM_NULL ? MPI_COMM_WORLD : state.comm;
+}
+
+int ppc::util::GetTaskGroupIndex() {
+  return GetTaskGroupState().index;
+}
@@ -0,0 +1,120 @@
+#include "util/include/thread_pool.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace {
+
+// Pool and queue index of the calling worker thread
+struct WorkerIdentity {
+  const ppc::util::ThreadPool *pool = nullptr;
+  std::size_t index = 0;
+};
+
+thread_local WorkerIdentity current_worker;
+
+}  // namespace
+
+ppc::util::ThreadPool::ThreadPool(int num_threads) {
+  const auto count = static_cast<std::size_t>(std::max(num_threads, 1));
+  queues_.reserve(count);
+  for (std::size_t i = 0; i < count; i++) {
+    queues_.push_back(std::make_unique<WorkerQueue>());
+  }
+  threads_.reserve(count);
+  for (std::size_t i = 0; i < count; i++) {
+    threads_.emplace_back([this, i] { WorkerLoop(i); });
+  }
+}
+
+ppc::util::ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard lock(wake_mutex_);
+    stop_ = true;
+  }
+  wake_.notify_all();
+  for (auto &thread : threads_) {
+    thread.join();
+  }
+}
+
+void ppc::util::ThreadPool::Push(std::function<void()> job) {
+  const bool from_worker = current_worker.pool == this;
+  const std::size_t index =
+      from_worker ? current_worker.index : next_queue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+  // Count the job first so that a concurrent TakeJob never drives the counter below zero
+  {
+    std::lock_guard lock(wake_mutex_);
+    pending_.fetch_add(1);
+  }
+  {
+    auto &queue = *queues_[index];
+    std::lock_guard lock(queue.mutex);
+    if (from_worker) {
+      queue.jobs.push_front(std::move(job));
+    } else {
+      queue.jobs.push_back(std::move(job));
+    }
+  }
+  wake_.notify_one();
+  progress_.fetch_add(1);
+  progress_.notify_all();
+}
+
+void ppc::util::ThreadPool::RunJob(std::function<void()> &job) {
+  job();
+  // Bumped after the job has fulfilled its future: a waiter that read the old value sees the future ready or is woken
+  progress_.fetch_add(1);
+  progress_.notify_all();
+}
+
+bool ppc::util::ThreadPool::TakeJob(std::size_t preferred, std::function<void()> &job) {
+  for (std::size_t offset = 0; offset < queues_.size(); offset++) {
+    auto &queue = *queues_[(preferred + offset) % queues_.size()];
+    std::lock_guard lock(queue.mutex);
+    if (queue.jobs.empty()) {
+      continue;
+    }
+    // The owner works from the front, thieves take the oldest job from the back
+    if (offset == 0) {
+      job = std::move(queue.jobs.front());
+      queue.jobs.pop_front();
+    } else {
+      job = std::move(queue.jobs.back());
+      queue.jobs.pop_back();
+    }
+    pending_.fetch_sub(1);
+    return true;
+  }
+  return false;
+}
+
+bool ppc::util::ThreadPool::RunPendingJob() {
+  const std::size_t preferred = current_worker.pool == this ? current_worker.index : 0;
+  std::function<void()> job;
+  if (!TakeJob(preferred, job)) {
+    return false;
+  }
+  RunJob(job);
+  return true;
+}
+
+void ppc::util::ThreadPool::WorkerLoop(std::size_t index) {
+  current_worker = {.pool = this, .index = index};
+  while (true) {
+    std::function<void()> job;
+    if (TakeJob(index, job)) {
+      RunJob(job);
+      continue;
+    }
+    std::unique_lock lock(wake_mutex_);
+    wake_.wait(lock, [this] { return stop_ || pending_.load() > 0; });
+    if (stop_ && pending_.load() == 0) {
+      return;
+    }
+  }
+}
@@ -4,6 +4,7 @@
 #include <array>
 #include <filesystem>
 #include <libenvpp/detail/get.hpp>
+#include <stdexcept>
 #include <string>
 
 namespace {
@@ -52,6 +53,108 @@ double ppc::util::GetPerfMaxTime() {
   return 10.0;
 }
 
+bool ppc::util::IsPerfHwCountersEnabled() {
+  const auto val = env::get<int>("PPC_PERF_HW_COUNTERS");
+  return val.has_value() && val.value() != 0;
+}
+
+bool ppc::util::IsPerfColdCacheEnabled() {
+  const auto val = env::get<int>("PPC_PERF_COLD_CACHE");
+  return val.has_value() && val.value() != 0;
+}
+
+int ppc::util::GetPerfInFlight() {
+  const auto val = env::get<int>("PPC_PERF_IN_FLIGHT");
+  if (!val.has_value()) {
+    return 0;
+  }
+  if (val.value() < 0) {
+    throw std::runtime_error("PPC_PERF_IN_FLIGHT must not be negative, got " + std::to_string(val.value()));
+  }
+  return val.value();
+}
+
+ppc::util::PerfScalingMode ppc::util::GetPerfScalingMode() {
+  const auto val = env::get<std::string>("PPC_PERF_SCALING");
+  if (!val.has_value() || val.value().empty() || val.value() == "none") {
+    return PerfScalingMode::kNone;
+  }
+  if (val.value() == "strong") {
+    return PerfScalingMode::kStrong;
+  }
+  if (val.value() == "weak") {
+    return PerfScalingMode::kWeak;
+  }
+  throw std::runtime_error("Unknown PPC_PERF_SCALING value: " + val.value());
+}
+
+std::string ppc::util::PerfScalingModeToString(PerfScalingMode mode) {
+  if (mode == PerfScalingMode::kStrong) {
+    return "strong";
+  }
+  if (mode == PerfScalingMode::kWeak) {
+    return "weak";
+  }
+  return "none";
+}
+
+ppc::util::MpiThreadLevel ppc::util::GetMpiThreadLevel() {
+  const auto val = env::get<std::string>("PPC_MPI_THREAD_LEVEL");
+  if (!val.has_value() || val.value().empty()) {
+    return MpiThreadLevel::kFunneled;
+  }
+  for (auto level : {MpiThreadLevel::kSingle, MpiThreadLevel::kFunneled, MpiThreadLevel::kSerialized,
+                     MpiThreadLevel::kMultiple}) {
+    if (val.value() == GetMpiThreadLevelName(level)) {
+      return level;
+    }
+  }
+  throw std::runtime_error("Unknown PPC_MPI_THREAD_LEVEL value: " + val.value());
+}
+
+std::string ppc::util::GetMpiThreadLevelName(MpiThreadLevel level) {
+  if (level == MpiThreadLevel::kFunneled) {
+    return "funneled";
+  }
+  if (level == MpiThreadLevel::kSerialized) {
+    return "serialized";
+  }
+  if (level == MpiThreadLevel::kMultiple) {
+    return "multiple";
+  }
+  return "single";
+}
+
+namespace {
+
+ppc::util::RankThreading &RankThreadingStorage() {
+  static ppc::util::RankThreading threading;
+  return threading;
+}
+
+}  // namespace
+
+void ppc::util::SetRankThreading(RankThreading threading) {
+  RankThreadingStorage() = threading;
+}
+
+const ppc::util::RankThreading &ppc::util::GetRankThreading() {
+  return RankThreadingStorage();
+}
+
+int ppc::util::ComputeRankThreadBudget(int num_threads, int node_cpus, int local_ranks) {
+  const int requested = std::max(num_threads, 1);
+  if (node_cpus <= 0 || local_ranks <= 0) {
+    return requested;
+  }
+  return std::clamp(node_cpus / local_ranks, 1, requested);
+}
+
+int ppc::util::GetRankThreadBudget() {
+  const int budget = GetRankThreading().thread_budget;
+  return budget > 0 ? budget : GetNumThreads();
+}
+
 // List of environment variables that signal the application is running under
 // an MPI launcher. The array size must match the number of entries to avoid
 // looking up empty environment variable names.
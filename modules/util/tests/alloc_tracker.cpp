@@ -0,0 +1,69 @@
+#include "util/include/alloc_tracker.hpp"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+TEST(AllocTracker, ScopeCountsAllocations) {
+  ppc::util::AllocScope scope;
+  auto data = std::make_unique<std::vector<int>>(1000);
+  const auto stats = scope.Stop();
+  if constexpr (ppc::util::AllocTracker::IsEnabled()) {
+    EXPECT_GE(stats.bytes, 1000 * sizeof(int));
+    EXPECT_GE(stats.allocations, 2U);
+    EXPECT_GE(stats.peak_heap_bytes, 1000 * sizeof(int));
+  } else {
+    EXPECT_EQ(stats.bytes, 0U);
+    EXPECT_EQ(stats.allocations, 0U);
+  }
+}
+
+TEST(AllocTracker, PeakHeapIgnoresReleasedMemory) {
+  {
+    std::vector<char> warm(1 << 20);
+  }
+  ppc::util::AllocScope scope;
+  {
+    std::vector<char> temporary(1 << 16);
+  }
+  const auto stats = scope.Stop();
+  if constexpr (ppc::util::AllocTracker::IsEnabled()) {
+    EXPECT_GE(stats.peak_heap_bytes, 1U << 16);
+    EXPECT_LT(stats.peak_heap_bytes, 1U << 20);
+  }
+}
+
+TEST(AllocTracker, OuterScopeIncludesInnerPeak) {
+  ppc::util::AllocScope outer;
+  {
+    ppc::util::AllocScope inner;
+    std::vector<char> temporary(1 << 16);
+    inner.Stop();
+  }
+  const auto stats = outer.Stop();
+  if constexpr (ppc::util::AllocTracker::IsEnabled()) {
+    EXPECT_GE(stats.peak_heap_bytes, 1U << 16);
+  }
+}
+
+TEST(AllocTracker, OverlappingScopesKeepTheirOwnPeaks) {
+  auto first = std::make_unique<ppc::util::AllocScope>();
+  {
+    std::vector<char> temporary(1 << 20);
+  }
+  // Opened after the peak of the first scope and stopped after it, as with two asynchronous stages
+  auto second = std::make_unique<ppc::util::AllocScope>();
+  const auto first_stats = first->Stop();
+  const auto second_stats = second->Stop();
+  if constexpr (ppc::util::AllocTracker::IsEnabled()) {
+    EXPECT_GE(first_stats.peak_heap_bytes, 1U << 20);
+    EXPECT_LT(second_stats.peak_heap_bytes, 1U << 20);
+  }
+}
+
+#ifdef __linux__
+TEST(AllocTracker, GetProcessPeakRssKbIsPositive) {
+  EXPECT_GT(ppc::util::AllocTracker::GetProcessPeakRssKb(), 0U);
+}
+#endif
@@ -0,0 +1,145 @@
+#include "util/include/bellman_ford.hpp"
+
+#include <gtest/gtest.h>
+#include <mpi.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "util/include/local_csr.hpp"
+#include "util/include/partition.hpp"
+#include "util/include/scatter_gather.hpp"
+#include "util/tests/mpi_environment.hpp"
+
+namespace {
+
+constexpr std::int64_t kUnreachable = std::numeric_limits<std::int64_t>::max();
+
+struct Graph {
+  std::vector<int> offsets;
+  std::vector<int> columns;
+  std::vector<int> weights;
+};
+
+/// @brief Random graph with negative edges but no negative cycle: every cycle takes an edge to a lower vertex, which
+///        outweighs any run of negative edges to higher vertices.
+Graph MakeRandomGraph(int vertices, int degree) {
+  std::mt19937 gen(11);
+  std::uniform_int_distribution<> vertex(0, vertices - 1);
+  std::uniform_int_distribution<> weight(-5, 20);
+  Graph graph;
+  graph.offsets.push_back(0);
+  for (int v = 0; v < vertices; v++) {
+    for (int e = 0; e < degree; e++) {
+      const int target = vertex(gen);
+      const int w = weight(gen);
+      graph.columns.push_back(target);
+      graph.weights.push_back(target > v ? w : w + (5 * vertices));
+    }
+    graph.offsets.push_back(static_cast<int>(graph.columns.size()));
+  }
+  return graph;
+}
+
+std::vector<std::int64_t> SequentialBellmanFord(const Graph &graph, int source) {
+  const auto vertices = graph.offsets.size() - 1;
+  std::vector<std::int64_t> dist(vertices, kUnreachable);
+  dist[static_cast<std::size_t>(source)] = 0;
+  for (std::size_t iter = 1; iter < vertices; iter++) {
+    for (std::size_t u = 0; u < vertices; u++) {
+      if (dist[u] == kUnreachable) {
+        continue;
+      }
+      for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; e++) {
+        auto &target = dist[static_cast<std::size_t>(graph.columns[e])];
+        target = std::min(target, dist[u] + graph.weights[e]);
+      }
+    }
+  }
+  return dist;
+}
+
+ppc::util::FrontierBellmanFord<int, std::int64_t>::Result RunFrontierBellmanFord(const Graph &graph, int source,
+                                                                                 std::vector<std::int64_t> &dist) {
+  const int rank = ppc::util::test::GetWorldRank();
+  int size = 0;
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  const auto vertices = ppc::util::Partition::Block(static_cast<int>(graph.offsets.size()) - 1, size);
+  const ppc::util::LocalCsr<int> local{
+      .offsets = std::span<const int>(graph.offsets).subspan(vertices.Offset(rank), vertices.Count(rank) + 1),
+      .columns = graph.columns,
+      .weights = graph.weights};
+  ppc::util::FrontierBellmanFord<int, std::int64_t> bellman_ford(local, vertices, MPI_COMM_WORLD);
+  auto result = bellman_ford.Run(source, kUnreachable);
+  dist = ppc::util::Allgatherv(result.local_dist, vertices, MPI_COMM_WORLD);
+  return result;
+}
+
+}  // namespace
+
+TEST(FrontierBellmanFordMpi, MatchesSequentialBellmanFordWithNegativeEdgesDisabledValgrind) {
+  const auto graph = MakeRandomGraph(250, 3);
+  std::vector<std::int64_t> dist;
+  const auto result = RunFrontierBellmanFord(graph, 0, dist);
+  EXPECT_FALSE(result.has_negative_cycle);
+  EXPECT_EQ(dist, SequentialBellmanFord(graph, 0));
+}
+
+TEST(FrontierBellmanFordMpi, LeavesUnreachableVerticesAtTheGivenValueDisabledValgrind) {
+  Graph graph;
+  graph.offsets = {0, 1, 1, 1};
+  graph.columns = {1};
+  graph.weights = {-3};
+  std::vector<std::int64_t> dist;
+  const auto result = RunFrontierBellmanFord(graph, 0, dist);
+  EXPECT_FALSE(result.has_negative_cycle);
+  EXPECT_EQ(dist, (std::vector<std::int64_t>{0, -3, kUnreachable}));
+}
+
+TEST(FrontierBellmanFordMpi, DetectsAReachableNegativeCycleDisabledValgrind) {
+  // 0 -> 1 -> 2 -> 3 -> 1 with cycle weight 1 + 1 - 3 = -1
+  Graph graph;
+  graph.offsets = {0, 1, 2, 3, 4};
+  graph.columns = {1, 2, 3, 1};
+  graph.weights = {4, 1, 1, -3};
+  std::vector<std::int64_t> dist;
+  EXPECT_TRUE(RunFrontierBellmanFord(graph, 0, dist).has_negative_cycle);
+}
+
+TEST(FrontierBellmanFordMpi, IgnoresANegativeCycleTheSourceCannotReachDisabledValgrind) {
+  // The cycle 2 <-> 3 has weight -2 but nothing leads into it from 0
+  Graph graph;
+  graph.offsets = {0, 1, 1, 2, 3};
+  graph.columns = {1, 3, 2};
+  graph.weights = {5, -1, -1};
+  std::vector<std::int64_t> dist;
+  const auto result = RunFrontierBellmanFord(graph, 0, dist);
+  EXPECT_FALSE(result.has_negative_cycle);
+  EXPECT_EQ(dist, (std::vector<std::int64_t>{0, 5, kUnreachable, kUnreachable}));
+}
+
+TEST(FrontierBellmanFordMpi, FindsANegativeCycleLongBeforeVRoundsDisabledValgrind) {
+  // 1 <-> 2 has weight -1 right next to the source, followed by a long tail 2 -> 3 -> ... -> 299
+  constexpr int kVertices = 300;
+  Graph graph;
+  graph.offsets = {0, 1, 2};
+  graph.columns = {1, 2};
+  graph.weights = {1, 1};
+  graph.columns.push_back(1);
+  graph.weights.push_back(-2);
+  for (int v = 2; v + 1 < kVertices; v++) {
+    graph.columns.push_back(v + 1);
+    graph.weights.push_back(1);
+    graph.offsets.push_back(static_cast<int>(graph.columns.size()));
+  }
+  graph.offsets.push_back(static_cast<int>(graph.columns.size()));
+  std::vector<std::int64_t> dist;
+  const auto result = RunFrontierBellmanFord(graph, 0, dist);
+  EXPECT_TRUE(result.has_negative_cycle);
+  EXPECT_LT(result.rounds, kVertices / 4);
+}
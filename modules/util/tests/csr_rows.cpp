@@ -0,0 +1,179 @@
+#include "util/include/csr_rows.hpp"
+
+#include <gtest/gtest.h>
+#include <mpi.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <map>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "util/include/partition.hpp"
+#include "util/include/spgemm.hpp"
+#include "util/tests/mpi_environment.hpp"
+
+namespace {
+
+using ppc::util::CsrMatrix;
+using ppc::util::CsrView;
+using ppc::util::Partition;
+
+/// @brief Matrix with a row of every length from 0 on, so packed blocks are ragged.
+CsrMatrix<double> MakeRaggedMatrix(int rows, int cols, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<> col(0, cols - 1);
+  CsrMatrix<double> matrix{.rows = rows, .cols = cols, .row_ptr = {0}, .col_idx = {}, .values = {}};
+  for (int row = 0; row < rows; row++) {
+    std::map<int, double> entries;
+    for (int e = 0; e < row % 5; e++) {
+      entries[col(gen)] = row + (0.25 * e);
+    }
+    for (const auto &[c, v] : entries) {
+      matrix.col_idx.push_back(c);
+      matrix.values.push_back(v);
+    }
+    matrix.row_ptr.push_back(static_cast<int>(matrix.col_idx.size()));
+  }
+  return matrix;
+}
+
+CsrView<double> View(const CsrMatrix<double> &matrix) {
+  return {.cols = matrix.cols, .row_ptr = matrix.row_ptr, .col_idx = matrix.col_idx, .values = matrix.values};
+}
+
+/// @brief The matrix on root; the other ranks pass its shape alone.
+CsrView<double> RootView(const CsrMatrix<double> &matrix, int rank) {
+  if (rank == 0) {
+    return View(matrix);
+  }
+  return {.cols = matrix.cols, .row_ptr = {}, .col_idx = {}, .values = {}};
+}
+
+/// @brief Row `row` of matrix as a column -> value map.
+std::map<int, double> Row(const CsrMatrix<double> &matrix, int row) {
+  std::map<int, double> entries;
+  for (int e = matrix.row_ptr[row]; e < matrix.row_ptr[row + 1]; e++) {
+    entries[matrix.col_idx[e]] = matrix.values[e];
+  }
+  return entries;
+}
+
+int WorldSize() {
+  int size = 0;
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  return size;
+}
+
+}  // namespace
+
+TEST(CsrRowsMpi, ScatterAndGatherRestoreTheMatrixDisabledValgrind) {
+  const int rank = ppc::util::test::GetWorldRank();
+  const int size = WorldSize();
+  const auto matrix = MakeRaggedMatrix(23, 9, 1);
+  const auto root_view = RootView(matrix, rank);
+
+  for (const auto &rows : {Partition::Block(23, size), Partition::Cyclic(23, size)}) {
+    const auto local = ppc::util::ScatterCsrRows(root_view, rows, MPI_COMM_WORLD);
+    ASSERT_EQ(local.rows, rows.Count(rank));
+    EXPECT_EQ(local.cols, 9);
+    ASSERT_EQ(local.row_ptr.size(), static_cast<std::size_t>(local.rows) + 1);
+    EXPECT_EQ(local.row_ptr.front(), 0);
+    for (int row = 0; row < local.rows; row++) {
+      EXPECT_EQ(Row(local, row), Row(matrix, rows.GlobalIndex(rank, row)));
+    }
+
+    const auto gathered = ppc::util::GatherCsrRows(local, rows, MPI_COMM_WORLD);
+    if (rank == 0) {
+      EXPECT_EQ(gathered.rows, matrix.rows);
+      EXPECT_EQ(gathered.cols, matrix.cols);
+      EXPECT_EQ(gathered.row_ptr, matrix.row_ptr);
+      EXPECT_EQ(gathered.col_idx, matrix.col_idx);
+      EXPECT_EQ(gathered.values, matrix.values);
+    } else {
+      EXPECT_TRUE(gathered.row_ptr.empty());
+    }
+  }
+}
+
+TEST(CsrRowsMpi, FetchReturnsTheRequestedRowsInRequestOrderDisabledValgrind) {
+  const int rank = ppc::util::test::GetWorldRank();
+  const auto matrix = MakeRaggedMatrix(17, 6, 2);
+  const auto root_view = RootView(matrix, rank);
+  // Rank r asks for r + 1 rows, the last rank for none
+  std::vector<int> wanted;
+  if (rank + 1 < WorldSize() || rank == 0) {
+    for (int i = 0; i <= rank; i++) {
+      wanted.push_back(((7 * (rank + 1)) + (11 * i)) % 17);
+    }
+  }
+
+  const auto fetched = ppc::util::FetchCsrRows(root_view, wanted, MPI_COMM_WORLD);
+  ASSERT_EQ(fetched.rows, static_cast<int>(wanted.size()));
+  EXPECT_EQ(fetched.cols, 6);
+  for (std::size_t i = 0; i < wanted.size(); i++) {
+    EXPECT_EQ(Row(fetched, static_cast<int>(i)), Row(matrix, wanted[i]));
+  }
+}
+
+TEST(CsrRowsMpi, ReferencedRowsOfBGiveTheDistributedProductDisabledValgrind) {
+  const int rank = ppc::util::test::GetWorldRank();
+  const auto a = MakeRaggedMatrix(31, 40, 3);
+  const auto b = MakeRaggedMatrix(40, 12, 4);
+  const auto rows = Partition::Cyclic(a.rows, WorldSize());
+  auto local_a = ppc::util::ScatterCsrRows(RootView(a, rank), rows, MPI_COMM_WORLD);
+
+  // Renumber the columns of the local rows of A to the positions of the fetched rows of B
+  std::vector<int> needed = local_a.col_idx;
+  std::ranges::sort(needed);
+  needed.erase(std::ranges::unique(needed).begin(), needed.end());
+  const auto local_b = ppc::util::FetchCsrRows(RootView(b, rank), std::span<const int>(needed), MPI_COMM_WORLD);
+  EXPECT_LE(local_b.rows, b.rows);
+  for (int &col : local_a.col_idx) {
+    col = static_cast<int>(std::ranges::lower_bound(needed, col) - needed.begin());
+  }
+  local_a.cols = local_b.rows;
+
+  const auto local_c = ppc::util::SpGemm<double>().Multiply(View(local_a), View(local_b));
+  const auto c = ppc::util::GatherCsrRows(local_c, rows, MPI_COMM_WORLD);
+  if (rank == 0) {
+    const auto expected = ppc::util::SpGemm<double>().Multiply(View(a), View(b));
+    EXPECT_EQ(c.row_ptr, expected.row_ptr);
+    EXPECT_EQ(c.col_idx, expected.col_idx);
+    EXPECT_EQ(c.values, expected.values);
+  }
+}
+
+TEST(CsrRowsMpi, ABadBlockOnOneRankThrowsOnEveryRankDisabledValgrind) {
+  const int rank = ppc::util::test::GetWorldRank();
+  const auto rows = Partition::Block(WorldSize() + 1, WorldSize());
+  // Only rank 0 passes a block of the wrong size
+  const int local_rows = rank == 0 ? 0 : rows.Count(rank);
+  const CsrMatrix<double> local{.rows = local_rows,
+                                .cols = 1,
+                                .row_ptr = std::vector<int>(static_cast<std::size_t>(local_rows) + 1, 0),
+                                .col_idx = {},
+                                .values = {}};
+  EXPECT_THROW((void)ppc::util::GatherCsrRows(local, rows, MPI_COMM_WORLD), std::runtime_error);
+}
+
+TEST(CsrRowsMpi, BadInputOnRootThrowsOnEveryRankDisabledValgrind) {
+  const int rank = ppc::util::test::GetWorldRank();
+  const auto matrix = MakeRaggedMatrix(5, 3, 5);
+  const auto root_view = RootView(matrix, rank);
+  EXPECT_THROW((void)ppc::util::ScatterCsrRows(root_view, Partition::Block(6, WorldSize()), MPI_COMM_WORLD),
+               std::runtime_error);
+
+  // The last rank asks for a row past the end
+  std::vector<int> wanted = {0};
+  if (rank + 1 == WorldSize()) {
+    wanted.push_back(matrix.rows);
+  }
+  EXPECT_THROW((void)ppc::util::FetchCsrRows(root_view, std::span<const int>(wanted), MPI_COMM_WORLD),
+               std::runtime_error);
+  // Every rank left the failed calls at the same point, so the next collective still matches up
+  const auto local = ppc::util::ScatterCsrRows(root_view, Partition::Block(5, WorldSize()), MPI_COMM_WORLD);
+  EXPECT_EQ(local.rows, Partition::Block(5, WorldSize()).Count(rank));
+}
@@ -0,0 +1,254 @@
+#include "util/include/csr_snapshot.hpp"
+
+#include <gtest/gtest.h>
+#include <mpi.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <ios>
+#include <libenvpp/detail/environment.hpp>
+#include <optional>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "util/tests/mpi_environment.hpp"
+
+namespace {
+
+class CsrSnapshotTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    const auto *info = ::testing::UnitTest::GetInstance()->current_test_info();
+    directory_ = std::filesystem::temp_directory_path() /
+                 ("ppc_csr_snapshot_test_" + std::string(info->name()) + "_" + std::to_string(std::random_device{}()));
+    std::filesystem::create_directories(directory_);
+  }
+
+  void TearDown() override {
+    std::error_code ignored;
+    std::filesystem::remove_all(directory_, ignored);
+  }
+
+  [[nodiscard]] std::filesystem::path Path(const std::string &name) const {
+    return directory_ / name;
+  }
+
+ private:
+  std::filesystem::path directory_;
+};
+
+std::vector<int> ToVector(std::span<const int> values) {
+  return {values.begin(), values.end()};
+}
+
+}  // namespace
+
+TEST_F(CsrSnapshotTest, RoundTripsAGraphThroughTheMappedFile) {
+  const std::vector<int> row_ptr = {0, 2, 2, 3};
+  const std::vector<int> col_idx = {1, 2, 0};
+  const std::vector<double> weights = {0.5, -1.25, 3.0};
+  ppc::util::WriteCsrSnapshot<double>(Path("graph.csr"), row_ptr, col_idx, weights, 2);
+
+  const auto snapshot = ppc::util::CsrSnapshot::Open(Path("graph.csr"));
+  EXPECT_EQ(snapshot.Vertices(), 3);
+  EXPECT_EQ(snapshot.Edges(), 3);
+  EXPECT_EQ(snapshot.Source(), 2);
+  EXPECT_EQ(ToVector(snapshot.RowPtr()), row_ptr);
+  EXPECT_EQ(ToVector(snapshot.ColIdx()), col_idx);
+  const auto mapped = snapshot.Weights<double>();
+  EXPECT_EQ(std::vector<double>(mapped.begin(), mapped.end()), weights);
+  EXPECT_EQ(snapshot.CopyWeights<int>(), (std::vector<int>{0, -1, 3}));
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(snapshot.ColIdx().data()) % 64, 0U);
+  EXPECT_THROW((void)snapshot.Weights<float>(), std::runtime_error);
+}
+
+TEST_F(CsrSnapshotTest, RejectsFilesThatAreNotSnapshots) {
+  {
+    std::ofstream file(Path("text.csr"), std::ios::binary);
+    file << std::string(200, 'x');
+  }
+  EXPECT_THROW((void)ppc::util::CsrSnapshot::Open(Path("text.csr")), std::runtime_error);
+  EXPECT_THROW((void)ppc::util::CsrSnapshot::Open(Path("missing.csr")), std::runtime_error);
+
+  const std::vector<int> row_ptr = {0, 1, 2};
+  const std::vector<int> col_idx = {1, 0};
+  const std::vector<int> weights = {4, 5};
+  ppc::util::WriteCsrSnapshot<int>(Path("graph.csr"), row_ptr, col_idx, weights);
+  std::filesystem::resize_file(Path("graph.csr"), std::filesystem::file_size(Path("graph.csr")) - 4);
+  EXPECT_THROW((void)ppc::util::CsrSnapshot::Open(Path("graph.csr")), std::runtime_error);
+}
+
+TEST_F(CsrSnapshotTest, OpenRejectsCorruptRowOffsetsAndColumns) {
+  const std::vector<int> row_ptr = {0, 1, 2, 3};
+  const std::vector<int> col_idx = {1, 2, 0};
+  const std::vector<int> weights = {1, 2, 3};
+  ppc::util::WriteCsrSnapshot<int>(Path("graph.csr"), row_ptr, col_idx, weights);
+  const auto header = ppc::util::CsrSnapshot::Open(Path("graph.csr")).Header();
+  const auto corrupt = [&](const std::string &name, std::uint64_t offset, int value) {
+    std::filesystem::copy_file(Path("graph.csr"), Path(name));
+    std::fstream file(Path(name), std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(static_cast<std::streamoff>(offset));
+    file.write(reinterpret_cast<const char *>(&value), sizeof(value));
+  };
+  corrupt("rows.csr", header.row_ptr_offset + (2 * sizeof(int)), 0);
+  corrupt("columns.csr", header.col_idx_offset + sizeof(int), 3);
+  EXPECT_THROW((void)ppc::util::CsrSnapshot::Open(Path("rows.csr")), std::runtime_error);
+  EXPECT_THROW((void)ppc::util::CsrSnapshot::Open(Path("columns.csr")), std::runtime_error);
+}
+
+TEST_F(CsrSnapshotTest, WriteRejectsMalformedCsrArrays) {
+  const std::vector<int> col_idx = {1, 3};
+  const std::vector<int> weights = {1, 1};
+  EXPECT_THROW(ppc::util::WriteCsrSnapshot<int>(Path("a.csr"), std::vector<int>{0, 1, 2}, col_idx, weights),
+               std::runtime_error);
+  EXPECT_THROW(ppc::util::WriteCsrSnapshot<int>(Path("b.csr"), std::vector<int>{0, 2, 1, 2}, col_idx, weights),
+               std::runtime_error);
+}
+
+TEST_F(CsrSnapshotTest, ConvertsATextEdgeListKeepingFileOrderWithinRows) {
+  {
+    std::ofstream file(Path("graph.txt"));
+    file << "4 5\n2 3 7\n0 1 -2\n2 0 4\n0 3 1\n3 2 9\n1\n";
+  }
+  ppc::util::ConvertEdgeListToCsrSnapshot(Path("graph.txt"), Path("graph.csr"));
+
+  const auto snapshot = ppc::util::CsrSnapshot::Open(Path("graph.csr"));
+  EXPECT_EQ(snapshot.Source(), 1);
+  EXPECT_EQ(ToVector(snapshot.RowPtr()), (std::vector<int>{0, 2, 2, 4, 5}));
+  EXPECT_EQ(ToVector(snapshot.ColIdx()), (std::vector<int>{1, 3, 3, 0, 2}));
+  EXPECT_EQ(ToVector(snapshot.Weights<int>()), (std::vector<int>{-2, 1, 7, 4, 9}));
+
+  const auto cached = ppc::util::CachedEdgeListSnapshot(Path("graph.txt"));
+  EXPECT_EQ(ToVector(ppc::util::CsrSnapshot::Open(cached).ColIdx()), ToVector(snapshot.ColIdx()));
+  std::filesystem::remove(cached);
+}
+
+TEST_F(CsrSnapshotTest, ConverterRejectsTruncatedEdgeLists) {
+  {
+    std::ofstream file(Path("graph.txt"));
+    file << "3 2\n0 1 5\n";
+  }
+  EXPECT_THROW(ppc::util::ConvertEdgeListToCsrSnapshot(Path("graph.txt"), Path("graph.csr")), std::runtime_error);
+}
+
+TEST_F(CsrSnapshotTest, GeneratesTheSameValidGraphForTheSameSeed) {
+  for (const auto model : {ppc::util::GraphModel::kRmat, ppc::util::GraphModel::kErdosRenyi}) {
+    ppc::util::GraphGeneratorOptions options;
+    options.model = model;
+    options.vertices = 1000;
+    options.edges = 8000;
+    options.min_weight = 1;
+    options.max_weight = 10;
+    options.seed = 5;
+    ppc::util::GenerateCsrSnapshot(Path("a.csr"), options);
+    ppc::util::GenerateCsrSnapshot(Path("b.csr"), options);
+    options.seed = 6;
+    ppc::util::GenerateCsrSnapshot(Path("c.csr"), options);
+
+    const auto a = ppc::util::CsrSnapshot::Open(Path("a.csr"));
+    const auto b = ppc::util::CsrSnapshot::Open(Path("b.csr"));
+    const auto c = ppc::util::CsrSnapshot::Open(Path("c.csr"));
+    ASSERT_EQ(a.Vertices(), 1000);
+    ASSERT_EQ(a.Edges(), 8000);
+    EXPECT_EQ(ToVector(a.RowPtr()), ToVector(b.RowPtr()));
+    EXPECT_EQ(ToVector(a.ColIdx()), ToVector(b.ColIdx()));
+    EXPECT_EQ(ToVector(a.Weights<int>()), ToVector(b.Weights<int>()));
+    EXPECT_NE(ToVector(a.ColIdx()), ToVector(c.ColIdx()));
+
+    for (std::size_t v = 0; v + 1 < a.RowPtr().size(); v++) {
+      ASSERT_LE(a.RowPtr()[v], a.RowPtr()[v + 1]);
+    }
+    for (std::size_t e = 0; e < a.ColIdx().size(); e++) {
+      ASSERT_GE(a.ColIdx()[e], 0);
+      ASSERT_LT(a.ColIdx()[e], 1000);
+      ASSERT_GE(a.Weights<int>()[e], 1);
+      ASSERT_LE(a.Weights<int>()[e], 10);
+    }
+  }
+}
+
+TEST_F(CsrSnapshotTest, RmatConcentratesEdgesOnFewVertices) {
+  ppc::util::GraphGeneratorOptions options;
+  options.vertices = 1 << 12;
+  options.edges = 1 << 16;
+  ppc::util::GenerateCsrSnapshot(Path("rmat.csr"), options);
+  options.model = ppc::util::GraphModel::kErdosRenyi;
+  ppc::util::GenerateCsrSnapshot(Path("er.csr"), options);
+
+  const auto max_degree = [](const ppc::util::CsrSnapshot &snapshot) {
+    int degree = 0;
+    for (std::size_t v = 0; v + 1 < snapshot.RowPtr().size(); v++) {
+      degree = std::max(degree, snapshot.RowPtr()[v + 1] - snapshot.RowPtr()[v]);
+    }
+    return degree;
+  };
+  // Average degree 16: Erdos-Renyi stays within a few dozen, R-MAT hubs get hundreds
+  EXPECT_GT(max_degree(ppc::util::CsrSnapshot::Open(Path("rmat.csr"))),
+            4 * max_degree(ppc::util::CsrSnapshot::Open(Path("er.csr"))));
+}
+
+TEST_F(CsrSnapshotTest, GeneratorRejectsInvalidOptions) {
+  ppc::util::GraphGeneratorOptions options;
+  options.vertices = 10;
+  options.edges = 10;
+  options.a = 0.9;
+  EXPECT_THROW(ppc::util::GenerateCsrSnapshot(Path("graph.csr"), options), std::runtime_error);
+  options.a = 0.57;
+  options.source = 10;
+  EXPECT_THROW(ppc::util::GenerateCsrSnapshot(Path("graph.csr"), options), std::runtime_error);
+}
+
+TEST_F(CsrSnapshotTest, PerfGraphAcceptsAPathOrAGeneratorSpec) {
+  {
+    env::detail::set_scoped_environment_variable scoped("PPC_PERF_GRAPH", "er:300:1200:7");
+    const auto generated = ppc::util::GetPerfGraphSnapshot();
+    ASSERT_TRUE(generated.has_value());
+    const auto snapshot = ppc::util::CsrSnapshot::Open(*generated);
+    EXPECT_EQ(snapshot.Vertices(), 300);
+    EXPECT_EQ(snapshot.Edges(), 1200);
+  }
+  {
+    const std::vector<int> row_ptr = {0, 0};
+    ppc::util::WriteCsrSnapshot<int>(Path("graph.csr"), row_ptr, {}, {});
+    env::detail::set_scoped_environment_variable scoped("PPC_PERF_GRAPH", Path("graph.csr").string());
+    EXPECT_EQ(ppc::util::GetPerfGraphSnapshot(), Path("graph.csr"));
+  }
+  {
+    env::detail::set_scoped_environment_variable scoped("PPC_PERF_GRAPH", "rmat:100");
+    EXPECT_THROW((void)ppc::util::GetPerfGraphSnapshot(), std::runtime_error);
+  }
+}
+
+TEST(CsrSnapshotMpi, NodeLeaderPreparesTheSnapshotForItsNode) {
+  ppc::util::test::MpiEnvironment::EnsureInitialized();
+  int calls = 0;
+  const auto path = ppc::util::PrepareSnapshotPerNode(MPI_COMM_WORLD, [&] {
+    ++calls;
+    return std::optional<std::filesystem::path>("node_graph.csr");
+  });
+  EXPECT_EQ(path, std::filesystem::path("node_graph.csr"));
+
+  MPI_Comm node_comm = MPI_COMM_NULL;
+  MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &node_comm);
+  int node_rank = 0;
+  MPI_Comm_rank(node_comm, &node_rank);
+  MPI_Comm_free(&node_comm);
+  EXPECT_EQ(calls, node_rank == 0 ? 1 : 0);
+
+  EXPECT_EQ(ppc::util::PrepareSnapshotPerNode(MPI_COMM_WORLD, [] { return std::nullopt; }), std::nullopt);
+}
+
+TEST(CsrSnapshotMpi, LeaderErrorsReachEveryRankOfTheNode) {
+  ppc::util::test::MpiEnvironment::EnsureInitialized();
+  EXPECT_THROW((void)ppc::util::PrepareSnapshotPerNode(
+                   MPI_COMM_WORLD,
+                   []() -> std::optional<std::filesystem::path> { throw std::runtime_error("no space left"); }),
+               std::runtime_error);
+}
@@ -0,0 +1,109 @@
+#include "util/include/delta_stepping.hpp"
+
+#include <gtest/gtest.h>
+#include <mpi.h>
+
+#include <cstddef>
+#include <functional>
+#include <queue>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "util/include/partition.hpp"
+#include "util/tests/mpi_environment.hpp"
+
+namespace {
+
+struct Graph {
+  std::vector<int> offsets;
+  std::vector<int> columns;
+  std::vector<double> weights;
+};
+
+Graph MakeRandomGraph(int vertices, int degree, double max_weight) {
+  std::mt19937 gen(7);
+  std::uniform_int_distribution<> vertex(0, vertices - 1);
+  std::uniform_real_distribution<> weight(0.0, max_weight);
+  Graph graph;
+  graph.offsets.push_back(0);
+  for (int v = 0; v < vertices; v++) {
+    for (int e = 0; e < degree; e++) {
+      graph.columns.push_back(vertex(gen));
+      graph.weights.push_back(weight(gen));
+    }
+    graph.offsets.push_back(static_cast<int>(graph.columns.size()));
+  }
+  return graph;
+}
+
+std::vector<double> Dijkstra(const Graph &graph, int source) {
+  std::vector<double> dist(graph.offsets.size() - 1, ppc::util::DeltaSteppingSssp<double>::Unreachable());
+  std::priority_queue<std::pair<double, int>, std::vector<std::pair<double, int>>, std::greater<>> queue;
+  dist[source] = 0.0;
+  queue.emplace(0.0, source);
+  while (!queue.empty()) {
+    const auto [d, u] = queue.top();
+    queue.pop();
+    if (d > dist[u]) {
+      continue;
+    }
+    for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; e++) {
+      if (d + graph.weights[e] < dist[graph.columns[e]]) {
+        dist[graph.columns[e]] = d + graph.weights[e];
+        queue.emplace(dist[graph.columns[e]], graph.columns[e]);
+      }
+    }
+  }
+  return dist;
+}
+
+std::vector<double> RunDeltaStepping(const Graph &graph, int source, double delta) {
+  const int rank = ppc::util::test::GetWorldRank();
+  int size = 0;
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  const auto vertices = ppc::util::Partition::Block(static_cast<int>(graph.offsets.size()) - 1, size);
+  const ppc::util::LocalCsr<double> local{
+      .offsets = std::span<const int>(graph.offsets).subspan(vertices.Offset(rank), vertices.Count(rank) + 1),
+      .columns = graph.columns,
+      .weights = graph.weights};
+  ppc::util::DeltaSteppingSssp<double> sssp(local, vertices, MPI_COMM_WORLD, delta);
+  const auto local_dist = sssp.Run(source);
+  std::vector<double> dist(static_cast<std::size_t>(vertices.Total()));
+  MPI_Allgatherv(local_dist.data(), vertices.Count(rank), MPI_DOUBLE, dist.data(), vertices.Counts().data(),
+                 vertices.Displs().data(), MPI_DOUBLE, MPI_COMM_WORLD);
+  return dist;
+}
+
+}  // namespace
+
+TEST(DeltaSteppingMpi, MatchesDijkstraForAnyDeltaDisabledValgrind) {
+  const auto graph = MakeRandomGraph(300, 4, 10.0);
+  const auto expected = Dijkstra(graph, 5);
+  for (const double delta : {0.0, 0.5, 3.0, 100.0}) {
+    const auto dist = RunDeltaStepping(graph, 5, delta);
+    ASSERT_EQ(dist.size(), expected.size());
+    for (std::size_t v = 0; v < dist.size(); v++) {
+      EXPECT_DOUBLE_EQ(dist[v], expected[v]) << "vertex " << v << ", delta " << delta;
+    }
+  }
+}
+
+TEST(DeltaSteppingMpi, LeavesUnreachableVerticesAtInfinityDisabledValgrind) {
+  Graph graph;
+  graph.offsets = {0, 1, 1, 1};
+  graph.columns = {1};
+  graph.weights = {0.0};
+  const auto dist = RunDeltaStepping(graph, 0, 0.0);
+  EXPECT_EQ(dist, (std::vector<double>{0.0, 0.0, ppc::util::DeltaSteppingSssp<double>::Unreachable()}));
+}
+
+TEST(DeltaSteppingMpi, RejectsNegativeWeightsDisabledValgrind) {
+  Graph graph;
+  graph.offsets = {0, 1, 1};
+  graph.columns = {1};
+  graph.weights = {-1.0};
+  EXPECT_THROW(RunDeltaStepping(graph, 0, 0.0), std::runtime_error);
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <gtest/gtest.h>
+#include <mpi.h>
+
+namespace ppc::util::test {
+
+/// @brief Starts MPI for the core tests that need it; core_func_tests itself runs without mpirun and MPI_Init.
+/// @details MPI is started on first use and finalized after the last test.
+class MpiEnvironment : public ::testing::Environment {
+ public:
+  static void EnsureInitialized() {
+    int initialized = 0;
+    MPI_Initialized(&initialized);
+    if (initialized == 0) {
+      MPI_Init(nullptr, nullptr);
+      started_here_ = true;
+    }
+  }
+
+  void TearDown() override {
+    int finalized = 0;
+    MPI_Finalized(&finalized);
+    if (started_here_ && finalized == 0) {
+      MPI_Finalize();
+    }
+  }
+
+ private:
+  static inline bool started_here_ = false;
+};
+
+[[maybe_unused]] inline const auto *const kMpiEnvironment =
+    ::testing::AddGlobalTestEnvironment(new MpiEnvironment());
+
+/// @brief Rank in MPI_COMM_WORLD, starting MPI if needed.
+inline int GetWorldRank() {
+  MpiEnvironment::EnsureInitialized();
+  int rank = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  return rank;
+}
+
+}  // namespace ppc::util::test
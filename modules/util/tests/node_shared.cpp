@@ -0,0 +1,52 @@
+#include "util/include/node_shared.hpp"
+
+#include <gtest/gtest.h>
+#include <mpi.h>
+
+#include <cstddef>
+#include <numeric>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "util/tests/mpi_environment.hpp"
+
+using ppc::util::test::GetWorldRank;
+using ppc::util::test::MpiEnvironment;
+
+TEST(NodeSharedMpi, ArraySharesRootDataWithEveryRankDisabledValgrind) {
+  std::vector<int> data;
+  if (GetWorldRank() == 0) {
+    data.resize(1000);
+    std::iota(data.begin(), data.end(), 0);
+  }
+  const ppc::util::NodeSharedArray<int> shared(data, MPI_COMM_WORLD);
+  ASSERT_EQ(shared.Size(), 1000U);
+  for (std::size_t i = 0; i < shared.Size(); i++) {
+    EXPECT_EQ(shared[i], static_cast<int>(i));
+  }
+}
+
+TEST(NodeSharedMpi, RootLeadsItsNodeDisabledValgrind) {
+  MpiEnvironment::EnsureInitialized();
+  const ppc::util::NodeSharedArray<double> shared(std::span<const double>{}, MPI_COMM_WORLD);
+  if (GetWorldRank() == 0) {
+    EXPECT_TRUE(shared.View().empty());
+  }
+  ppc::util::NodeSharedBuffer buffer(nullptr, 0, MPI_COMM_WORLD);
+  if (GetWorldRank() == 0) {
+    EXPECT_TRUE(buffer.IsNodeLeader());
+  }
+  EXPECT_EQ(buffer.Size(), 0U);
+}
+
+TEST(NodeSharedMpi, MoveKeepsTheMappingDisabledValgrind) {
+  MpiEnvironment::EnsureInitialized();
+  const std::vector<double> data = {1.5, 2.5};
+  ppc::util::NodeSharedArray<double> shared(data, MPI_COMM_WORLD);
+  const auto *mapping = shared.Data();
+  ppc::util::NodeSharedArray<double> moved(std::move(shared));
+  EXPECT_EQ(moved.Data(), mapping);
+  ASSERT_EQ(moved.Size(), 2U);
+  EXPECT_DOUBLE_EQ(moved[1], 2.5);
+}
@@ -0,0 +1,154 @@
+#include "util/include/partition.hpp"
+
+#include <gtest/gtest.h>
+#include <mpi.h>
+
+#include <array>
+#include <cstdint>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "util/include/scatter_gather.hpp"
+#include "util/tests/mpi_environment.hpp"
+
+using ppc::util::Partition;
+
+TEST(PartitionMpi, BlockGivesTheRemainderToTheFirstParts) {
+  const auto partition = Partition::Block(10, 4);
+  EXPECT_EQ(partition.Counts(), (std::vector<int>{3, 3, 2, 2}));
+  EXPECT_EQ(partition.Displs(), (std::vector<int>{0, 3, 6, 8}));
+  EXPECT_TRUE(partition.IsContiguous());
+  EXPECT_EQ(partition.Owner(5), 1);
+  EXPECT_EQ(partition.LocalIndex(5), 2);
+  EXPECT_EQ(partition.GlobalIndex(3, 1), 9);
+}
+
+TEST(PartitionMpi, BlockWithMorePartsThanIndicesLeavesEmptyParts) {
+  const auto partition = Partition::Block(2, 4);
+  EXPECT_EQ(partition.Counts(), (std::vector<int>{1, 1, 0, 0}));
+  EXPECT_EQ(partition.Owner(1), 1);
+}
+
+TEST(PartitionMpi, BlockCyclicDealsBlocksRoundRobin) {
+  const auto partition = Partition::BlockCyclic(11, 3, 2);
+  // Blocks [0,1] [2,3] [4,5] [6,7] [8,9] [10] go to parts 0 1 2 0 1 2
+  EXPECT_EQ(partition.Counts(), (std::vector<int>{4, 4, 3}));
+  EXPECT_FALSE(partition.IsContiguous());
+  EXPECT_EQ(partition.Owner(7), 0);
+  EXPECT_EQ(partition.LocalIndex(7), 3);
+  EXPECT_EQ(partition.Owner(10), 2);
+  for (int i = 0; i < partition.Total(); i++) {
+    EXPECT_EQ(partition.GlobalIndex(partition.Owner(i), partition.LocalIndex(i)), i);
+  }
+}
+
+TEST(PartitionMpi, CyclicPackAndUnpackRoundTrip) {
+  const auto partition = Partition::Cyclic(7, 3);
+  std::vector<int> data(7);
+  std::iota(data.begin(), data.end(), 0);
+  const auto packed = partition.Pack(std::span<const int>(data));
+  EXPECT_EQ(packed, (std::vector<int>{0, 3, 6, 1, 4, 2, 5}));
+  std::vector<int> unpacked(7);
+  partition.Unpack(std::span<const int>(packed), std::span<int>(unpacked));
+  EXPECT_EQ(unpacked, data);
+}
+
+TEST(PartitionMpi, WeightedFollowsTheWeights) {
+  const std::array<double, 3> weights = {1.0, 2.0, 1.0};
+  const auto partition = Partition::Weighted(10, weights);
+  EXPECT_EQ(partition.Counts(), (std::vector<int>{3, 5, 2}));
+  EXPECT_EQ(partition.Displs(), (std::vector<int>{0, 3, 8}));
+}
+
+TEST(PartitionMpi, WeightedRejectsZeroWeights) {
+  const std::array<double, 2> weights = {0.0, 0.0};
+  EXPECT_THROW(Partition::Weighted(4, weights), std::runtime_error);
+}
+
+TEST(PartitionMpi, WithHaloOverlapsNeighbours) {
+  const auto halo = Partition::Block(9, 3).WithHalo(1);
+  EXPECT_EQ(halo.Counts(), (std::vector<int>{4, 5, 4}));
+  EXPECT_EQ(halo.Displs(), (std::vector<int>{0, 2, 5}));
+  EXPECT_THROW((void)Partition::Cyclic(9, 3).WithHalo(1), std::runtime_error);
+}
+
+TEST(PartitionMpi, ScattervAndGathervRestoreTheDataDisabledValgrind) {
+  const int rank = ppc::util::test::GetWorldRank();
+  int size = 0;
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  std::vector<double> data(13);
+  std::iota(data.begin(), data.end(), 0.5);
+
+  for (const auto &partition : {Partition::Block(13, size), Partition::BlockCyclic(13, size, 2)}) {
+    const auto local = ppc::util::Scatterv(data, partition, MPI_COMM_WORLD);
+    ASSERT_EQ(static_cast<int>(local.size()), partition.Count(rank));
+    for (int i = 0; i < partition.Count(rank); i++) {
+      EXPECT_EQ(local[i], data[partition.GlobalIndex(rank, i)]);
+    }
+    EXPECT_EQ(ppc::util::Allgatherv(local, partition, MPI_COMM_WORLD), data);
+    const auto gathered = ppc::util::Gatherv(local, partition, MPI_COMM_WORLD);
+    if (rank == 0) {
+      EXPECT_EQ(gathered, data);
+    }
+  }
+}
+
+TEST(PartitionMpi, ScatterColumnsAndHaloExchangeGiveColumnBlocksWithHalosDisabledValgrind) {
+  const int rank = ppc::util::test::GetWorldRank();
+  int size = 0;
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  // 3 rows x 5 columns of two-channel cells
+  constexpr int kRows = 3;
+  constexpr int kCols = 5;
+  constexpr int kChannels = 2;
+  std::vector<uint8_t> matrix(kRows * kCols * kChannels);
+  std::iota(matrix.begin(), matrix.end(), 0);
+
+  const auto columns = Partition::Block(kCols, size);
+  const auto own = ppc::util::ScatterColumns(matrix, kRows, kChannels, columns, MPI_COMM_WORLD);
+  const auto halo = columns.WithHalo(1);
+  const auto local = ppc::util::ExchangeColumnHalos(own, kRows, kChannels, columns, 1, MPI_COMM_WORLD);
+  ASSERT_EQ(static_cast<int>(local.size()), kRows * halo.Count(rank) * kChannels);
+  for (int row = 0; row < kRows; row++) {
+    for (int col = 0; col < halo.Count(rank); col++) {
+      for (int ch = 0; ch < kChannels; ch++) {
+        EXPECT_EQ(local[(((row * halo.Count(rank)) + col) * kChannels) + ch],
+                  matrix[(((row * kCols) + halo.Offset(rank) + col) * kChannels) + ch]);
+      }
+    }
+  }
+
+  std::vector<uint8_t> gathered(matrix.size());
+  ppc::util::GatherColumns(own, gathered, kRows, kChannels, columns, MPI_COMM_WORLD);
+  if (rank == 0) {
+    EXPECT_EQ(gathered, matrix);
+  }
+}
+
+TEST(PartitionMpi, ColumnCollectivesRejectOverlappingPartsDisabledValgrind) {
+  ppc::util::test::MpiEnvironment::EnsureInitialized();
+  int size = 0;
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  const std::vector<uint8_t> matrix(2 * 4 * size);
+  // MPI forbids a scatter from reading a root cell twice, so halos must come from ExchangeColumnHalos()
+  const auto halo = Partition::Block(4 * size, size).WithHalo(1);
+  if (size > 1) {
+    EXPECT_THROW((void)ppc::util::ScatterColumns(matrix, 2, 1, halo, MPI_COMM_WORLD), std::runtime_error);
+  }
+  // With one column per rank, the two-column halo of rank 2 would reach past rank 1
+  if (size > 2) {
+    EXPECT_THROW((void)ppc::util::ExchangeColumnHalos(std::vector<uint8_t>(2), 2, 1, Partition::Block(size, size), 2,
+                                                       MPI_COMM_WORLD),
+                 std::runtime_error);
+  }
+}
+
+TEST(PartitionMpi, CollectivesRejectAPartitionForAnotherCommSizeDisabledValgrind) {
+  ppc::util::test::MpiEnvironment::EnsureInitialized();
+  int size = 0;
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  const std::vector<int> data(4);
+  EXPECT_THROW((void)ppc::util::Scatterv(data, Partition::Block(4, size + 1), MPI_COMM_WORLD), std::runtime_error);
+}
@@ -0,0 +1,164 @@
+#include "util/include/perf_report.hpp"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <libenvpp/detail/environment.hpp>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "util/include/util.hpp"
+
+namespace {
+
+ppc::util::PerfRecord MakeRecord() {
+  ppc::util::PerfRecord record;
+  record.task = "example_task";
+  record.implementation = "mpi";
+  record.mode = "pipeline";
+  record.num_proc = 4;
+  record.num_threads = 2;
+  record.input_size = 1000;
+  record.host = "node01";
+  record.revision = "abc1234";
+  record.results.samples = {0.1, 0.2, 0.3};
+  ppc::performance::CalculateStatistics(record.results);
+  return record;
+}
+
+std::vector<std::string> ReadLines(const std::string &path) {
+  std::ifstream file(path);
+  std::vector<std::string> lines;
+  std::string line;
+  while (std::getline(file, line)) {
+    lines.push_back(line);
+  }
+  return lines;
+}
+
+}  // namespace
+
+TEST(PerfReport, GetPerfOutputPathReadsFromEnvironment) {
+  env::detail::set_scoped_environment_variable scoped("PPC_PERF_OUTPUT", "/tmp/perf.jsonl");
+  EXPECT_EQ(ppc::util::GetPerfOutputPath(), "/tmp/perf.jsonl");
+}
+
+TEST(PerfReport, GetInputSizeUsesSizeWhenAvailable) {
+  EXPECT_EQ(ppc::util::GetInputSize(std::vector<int>(7)), 7U);
+  EXPECT_EQ(ppc::util::GetInputSize(42), 0U);
+  EXPECT_EQ(ppc::util::GetInputSize(std::make_shared<const std::vector<int>>(5)), 5U);
+  EXPECT_EQ(ppc::util::GetInputSize(std::shared_ptr<const std::vector<int>>{}), 0U);
+}
+
+TEST(PerfReport, PerfRecordToJsonContainsStatistics) {
+  const auto json = ppc::util::PerfRecordToJson(MakeRecord());
+  EXPECT_EQ(json["task"], "example_task");
+  EXPECT_EQ(json["implementation"], "mpi");
+  EXPECT_EQ(json["num_proc"], 4);
+  EXPECT_EQ(json["samples"].size(), 3U);
+  EXPECT_DOUBLE_EQ(json["time_median"].get<double>(), 0.2);
+  EXPECT_TRUE(json["hw_counters"].empty());
+  EXPECT_TRUE(json["stages"].empty());
+}
+
+TEST(PerfReport, PerfRecordToJsonOmitsScalingByDefault) {
+  EXPECT_FALSE(ppc::util::PerfRecordToJson(MakeRecord()).contains("scaling"));
+}
+
+TEST(PerfReport, PerfRecordToJsonContainsInFlightThroughput) {
+  auto record = MakeRecord();
+  record.in_flight = 4;
+  record.throughput = 12.5;
+  const auto json = ppc::util::PerfRecordToJson(record);
+  EXPECT_FALSE(json.contains("batch"));
+  EXPECT_EQ(json["in_flight"]["tasks"], 4);
+  EXPECT_DOUBLE_EQ(json["in_flight"]["throughput"].get<double>(), 12.5);
+}
+
+TEST(PerfReport, MakeScalingPointComputesStrongSpeedup) {
+  const auto point = ppc::util::MakeScalingPoint(ppc::util::PerfScalingMode::kStrong, 1000, 4, 2.0, 1.0);
+  EXPECT_DOUBLE_EQ(point.speedup, 2.0);
+  EXPECT_DOUBLE_EQ(point.efficiency, 0.5);
+
+  auto record = MakeRecord();
+  record.scaling = point;
+  const auto json = ppc::util::PerfRecordToJson(record);
+  EXPECT_EQ(json["scaling"]["mode"], "strong");
+  EXPECT_EQ(json["scaling"]["workers"], 4);
+}
+
+TEST(PerfReport, MakeScalingPointComputesWeakEfficiency) {
+  const auto point = ppc::util::MakeScalingPoint(ppc::util::PerfScalingMode::kWeak, 1000, 4, 1.0, 1.25);
+  EXPECT_DOUBLE_EQ(point.efficiency, 0.8);
+  EXPECT_DOUBLE_EQ(point.speedup, 3.2);
+}
+
+TEST(PerfReport, MakeScalingPointWithoutReferenceIsUndefined) {
+  const auto point = ppc::util::MakeScalingPoint(ppc::util::PerfScalingMode::kStrong, 1000, 4, -1.0, 1.0);
+  EXPECT_LT(point.speedup, 0.0);
+  EXPECT_LT(point.efficiency, 0.0);
+}
+
+TEST(PerfReport, AppendPerfRecordWritesJsonLines) {
+  const auto path = (std::filesystem::temp_directory_path() / "ppc_perf_report_test.jsonl").string();
+  std::filesystem::remove(path);
+  ppc::util::AppendPerfRecord(path, MakeRecord());
+  ppc::util::AppendPerfRecord(path, MakeRecord());
+
+  const auto lines = ReadLines(path);
+  ASSERT_EQ(lines.size(), 2U);
+  auto json = ppc::util::InitJSONPtr();
+  *json = nlohmann::json::parse(lines[1]);
+  EXPECT_EQ((*json)["revision"], "abc1234");
+  std::filesystem::remove(path);
+}
+
+TEST(PerfReport, AppendPerfRecordWritesCsvHeaderOnce) {
+  const auto path = (std::filesystem::temp_directory_path() / "ppc_perf_report_test.csv").string();
+  std::filesystem::remove(path);
+  ppc::util::AppendPerfRecord(path, MakeRecord());
+  ppc::util::AppendPerfRecord(path, MakeRecord());
+
+  const auto lines = ReadLines(path);
+  ASSERT_EQ(lines.size(), 3U);
+  EXPECT_TRUE(lines[0].starts_with("task,implementation,mode"));
+  EXPECT_TRUE(lines[1].starts_with("example_task,mpi,pipeline,4,2,1000,"));
+  std::filesystem::remove(path);
+}
+
+TEST(PerfReport, PerfBaselineStoreKeepsLatestRecordPerKey) {
+  const auto path = (std::filesystem::temp_directory_path() / "ppc_perf_baseline_test.jsonl").string();
+  std::filesystem::remove(path);
+  auto old_record = MakeRecord();
+  old_record.revision = "old";
+  ppc::util::AppendPerfRecord(path, old_record);
+  ppc::util::AppendPerfRecord(path, MakeRecord());
+  auto scaling_record = MakeRecord();
+  scaling_record.scaling = ppc::util::MakeScalingPoint(ppc::util::PerfScalingMode::kStrong, 1000, 4, 2.0, 1.0);
+  ppc::util::AppendPerfRecord(path, scaling_record);
+
+  const auto store = ppc::util::PerfBaselineStore::Load(path);
+  EXPECT_EQ(store.Size(), 1U);
+  const auto *baseline = store.Find(ppc::util::GetPerfRecordKey(MakeRecord()));
+  ASSERT_NE(baseline, nullptr);
+  EXPECT_EQ(baseline->revision, "abc1234");
+  EXPECT_EQ(baseline->results.samples.size(), 3U);
+  EXPECT_EQ(baseline->scaling.mode, ppc::util::PerfScalingMode::kNone);
+
+  auto other_key = ppc::util::GetPerfRecordKey(MakeRecord());
+  other_key.num_proc = 8;
+  EXPECT_EQ(store.Find(other_key), nullptr);
+  std::filesystem::remove(path);
+}
+
+TEST(PerfReport, PerfBaselineStoreThrowsOnMissingFile) {
+  EXPECT_THROW(ppc::util::PerfBaselineStore::Load("/nonexistent/ppc_baseline.jsonl"), std::runtime_error);
+}
+
+TEST(PerfReport, GetPerfRegressionThresholdReadsFromEnvironment) {
+  env::detail::set_scoped_environment_variable scoped("PPC_PERF_REGRESSION_THRESHOLD", "0.25");
+  EXPECT_DOUBLE_EQ(ppc::util::GetPerfRegressionThreshold(), 0.25);
+}
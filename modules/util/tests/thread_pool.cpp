@@ -0,0 +1,120 @@
+#include "util/include/thread_pool.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <libenvpp/detail/environment.hpp>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "oneapi/tbb/parallel_for.h"
+#include "util/include/runtime.hpp"
+#include "util/include/util.hpp"
+
+TEST(ThreadPool, SubmitReturnsResult) {
+  ppc::util::ThreadPool pool(2);
+  auto future = pool.Submit([] { return 42; });
+  EXPECT_EQ(future.get(), 42);
+}
+
+TEST(ThreadPool, StartsAtLeastOneWorker) {
+  ppc::util::ThreadPool pool(0);
+  EXPECT_EQ(pool.Size(), 1);
+  EXPECT_EQ(pool.Submit([] { return 1; }).get(), 1);
+}
+
+TEST(ThreadPool, SubmitPropagatesExceptions) {
+  ppc::util::ThreadPool pool(2);
+  auto future = pool.Submit([] { throw std::runtime_error("job failed"); });
+  EXPECT_THROW(future.get(), std::runtime_error);
+}
+
+TEST(ThreadPool, ParallelForVisitsEveryIndexOnce) {
+  ppc::util::ThreadPool pool(3);
+  std::vector<std::atomic<int>> visits(100);
+  pool.ParallelFor(0, 100, [&](int i) { visits[i]++; });
+  for (const auto &count : visits) {
+    EXPECT_EQ(count.load(), 1);
+  }
+}
+
+TEST(ThreadPool, NestedParallelForDoesNotDeadlock) {
+  ppc::util::ThreadPool pool(2);
+  std::atomic<int> total(0);
+  pool.ParallelFor(0, 4, [&](int /*i*/) { pool.ParallelFor(0, 10, [&](int /*j*/) { total++; }); });
+  EXPECT_EQ(total.load(), 40);
+}
+
+TEST(ThreadPool, ReusesWorkerThreads) {
+  ppc::util::ThreadPool pool(2);
+  const auto first = pool.Submit([] { return std::this_thread::get_id(); }).get();
+  bool reused = false;
+  for (int i = 0; i < 16 && !reused; i++) {
+    reused = pool.Submit([] { return std::this_thread::get_id(); }).get() == first;
+  }
+  EXPECT_TRUE(reused);
+}
+
+TEST(ThreadPool, WaitReturnsOnceABlockedJobFinishes) {
+  ppc::util::ThreadPool pool(1);
+  std::promise<void> release;
+  auto job = pool.Submit([gate = release.get_future()] { gate.wait(); });
+  std::thread releaser([&release] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    release.set_value();
+  });
+  // The only worker is blocked and the queue is empty, so Wait() has to sleep until the job ends
+  pool.Wait(job);
+  EXPECT_EQ(job.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+  releaser.join();
+}
+
+TEST(Runtime, ThreadPoolFollowsThreadBudget) {
+  env::detail::set_scoped_environment_variable scoped("PPC_NUM_THREADS", "3");
+  auto &pool = ppc::util::Runtime::GetThreadPool();
+  EXPECT_EQ(pool.Size(), ppc::util::GetRankThreadBudget());
+  EXPECT_EQ(&pool, &ppc::util::Runtime::GetThreadPool());
+  ppc::util::Runtime::Shutdown();
+}
+
+TEST(Runtime, TaskArenaRunsParallelAlgorithms) {
+  std::atomic<int> counter(0);
+  ppc::util::Runtime::GetTaskArena().execute([&] { tbb::parallel_for(0, 16, [&](int /*i*/) { counter++; }); });
+  EXPECT_EQ(counter.load(), 16);
+  ppc::util::Runtime::Shutdown();
+}
+
+TEST(Runtime, GetOmpPoolPolicyReadsFromEnvironment) {
+  env::detail::set_scoped_environment_variable scoped("PPC_OMP_POOL", "pause");
+  EXPECT_EQ(ppc::util::GetOmpPoolPolicy(), ppc::util::OmpPoolPolicy::kPause);
+}
+
+TEST(Runtime, GetOmpPoolPolicyThrowsOnUnknownValue) {
+  env::detail::set_scoped_environment_variable scoped("PPC_OMP_POOL", "sometimes");
+  EXPECT_THROW(ppc::util::GetOmpPoolPolicy(), std::runtime_error);
+}
+
+TEST(Runtime, OmpPauseWaitsForTheLastAsyncStage) {
+  ppc::util::Runtime::SetOmpPoolPolicy(ppc::util::OmpPoolPolicy::kPause);
+  ppc::util::ThreadPool pool(1);
+  auto job = pool.Submit([] {
+    const ppc::util::AsyncStageScope in_flight;
+    long long sum = 0;
+    for (int round = 0; round < 50; round++) {
+#pragma omp parallel for reduction(+ : sum)
+      for (int i = 0; i < 1000; i++) {
+        sum += i;
+      }
+    }
+    return sum;
+  });
+  // Destroyed tasks on this thread must not pause the OpenMP threads under the running regions
+  for (int i = 0; i < 50; i++) {
+    ppc::util::Runtime::ReleaseTaskResources();
+  }
+  EXPECT_EQ(job.get(), 50LL * 999 * 1000 / 2);
+  ppc::util::Runtime::SetOmpPoolPolicy(ppc::util::OmpPoolPolicy::kPersistent);
+}
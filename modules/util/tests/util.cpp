@@ -4,9 +4,11 @@
 
 #include <libenvpp/detail/environment.hpp>
 #include <libenvpp/detail/get.hpp>
+#include <stdexcept>
 #include <string>
 
 #include "omp.h"
+#include "util/include/task_groups.hpp"
 
 namespace my::nested {
 struct Type {};
@@ -124,3 +126,55 @@ TEST(GetNumProc, ReadsFromEnvironment) {
   env::detail::set_scoped_environment_variable scoped("PPC_NUM_PROC", "4");
   EXPECT_EQ(ppc::util::GetNumProc(), 4);
 }
+
+TEST(GetPerfScalingMode, ReadsFromEnvironment) {
+  env::detail::set_scoped_environment_variable scoped("PPC_PERF_SCALING", "weak");
+  EXPECT_EQ(ppc::util::GetPerfScalingMode(), ppc::util::PerfScalingMode::kWeak);
+}
+
+TEST(GetPerfScalingMode, ThrowsOnUnknownValue) {
+  env::detail::set_scoped_environment_variable scoped("PPC_PERF_SCALING", "linear");
+  EXPECT_THROW(ppc::util::GetPerfScalingMode(), std::runtime_error);
+}
+
+TEST(GetPerfInFlight, ReadsFromEnvironment) {
+  env::detail::set_scoped_environment_variable scoped("PPC_PERF_IN_FLIGHT", "3");
+  EXPECT_EQ(ppc::util::GetPerfInFlight(), 3);
+}
+
+TEST(GetPerfInFlight, ThrowsOnNegativeValue) {
+  env::detail::set_scoped_environment_variable scoped("PPC_PERF_IN_FLIGHT", "-1");
+  EXPECT_THROW(ppc::util::GetPerfInFlight(), std::runtime_error);
+}
+
+TEST(GetMpiThreadLevel, ReadsFromEnvironment) {
+  env::detail::set_scoped_environment_variable scoped("PPC_MPI_THREAD_LEVEL", "multiple");
+  EXPECT_EQ(ppc::util::GetMpiThreadLevel(), ppc::util::MpiThreadLevel::kMultiple);
+}
+
+TEST(GetMpiThreadLevel, ThrowsOnUnknownValue) {
+  env::detail::set_scoped_environment_variable scoped("PPC_MPI_THREAD_LEVEL", "parallel");
+  EXPECT_THROW(ppc::util::GetMpiThreadLevel(), std::runtime_error);
+}
+
+TEST(ComputeRankThreadBudget, CapsThreadsByCpusPerRank) {
+  EXPECT_EQ(ppc::util::ComputeRankThreadBudget(8, 16, 4), 4);
+  EXPECT_EQ(ppc::util::ComputeRankThreadBudget(2, 16, 4), 2);
+  EXPECT_EQ(ppc::util::ComputeRankThreadBudget(4, 2, 4), 1);
+  EXPECT_EQ(ppc::util::ComputeRankThreadBudget(4, 0, 4), 4);
+}
+
+TEST(TaskGroups, CountReadsFromEnvironment) {
+  env::detail::set_scoped_environment_variable scoped("PPC_TASK_GROUPS", "4");
+  EXPECT_EQ(ppc::util::GetTaskGroupCount(), 4);
+}
+
+TEST(TaskGroups, CountThrowsOnNonPositiveValue) {
+  env::detail::set_scoped_environment_variable scoped("PPC_TASK_GROUPS", "0");
+  EXPECT_THROW(ppc::util::GetTaskGroupCount(), std::runtime_error);
+}
+
+TEST(TaskGroups, CommIsWorldWithoutGroups) {
+  EXPECT_EQ(ppc::util::GetTaskGroupComm(), MPI_COMM_WORLD);
+  EXPECT_EQ(ppc::util::GetTaskGroupIndex(), 0);
+}
@@ -1,4 +1,5 @@
 import argparse
+import json
 import os
 import re
 import xlsxwriter
@@ -128,9 +129,40 @@ def _write_csv(path: str, header: list[str], tasks_list: list[str], table: dict)
             writer.writerow(row)
 
 
+def _is_structured_input(path: str) -> bool:
+    return path.endswith(".jsonl") or path.endswith(".json")
+
+
+def _load_structured_records(
+    path: str, result_tables: dict, task_categories: dict, tasks_by_category: dict
+) -> None:
+    """Fill tables from JSON Lines records written by the C++ harness (PPC_PERF_OUTPUT)."""
+    with open(path, "r") as records_file:
+        for line in records_file:
+            line = line.strip()
+            if not line:
+                continue
+            record = json.loads(line)
+            if "scaling" in record:
+                # Scaling sweep points are not part of the regular comparison table
+                continue
+            task_name = record["task"]
+            perf_type = record["mode"]
+            task_type = record["implementation"]
+            task_category = _infer_category(task_name)
+
+            _ensure_task_tables(result_tables, perf_type, task_name)
+            result_tables[perf_type][task_name][task_type] = float(record["time_sec"])
+            task_categories[task_name] = task_category
+            tasks_by_category[task_category].add(task_name)
+
+
 parser = argparse.ArgumentParser()
 parser.add_argument(
-    "-i", "--input", help="Input file path (logs of perf tests, .txt)", required=True
+    "-i",
+    "--input",
+    help="Input file path (logs of perf tests, .txt, or PPC_PERF_OUTPUT records, .jsonl)",
+    required=True,
 )
 parser.add_argument(
     "-o", "--output", help="Output file path (path to .xlsx table)", required=True
@@ -146,8 +178,14 @@ task_categories = {}
 # Track tasks per category to split output
 tasks_by_category = {"threads": set(), "processes": set()}
 
-with open(logs_path, "r") as logs_file:
-    logs_lines = logs_file.readlines()
+if _is_structured_input(logs_path):
+    _load_structured_records(
+        logs_path, result_tables, task_categories, tasks_by_category
+    )
+    logs_lines = []
+else:
+    with open(logs_path, "r") as logs_file:
+        logs_lines = logs_file.readlines()
 for line in logs_lines:
     # Handle both old format: tasks/task_type/task_name:perf_type:time
     # and new format: namespace_task_type_enabled:perf_type:time
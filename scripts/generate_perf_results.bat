@@ -1,4 +1,6 @@
 @echo off
 mkdir build\perf_stat_dir
+if exist build\perf_stat_dir\perf_records.jsonl del build\perf_stat_dir\perf_records.jsonl
+set PPC_PERF_OUTPUT=%cd%\build\perf_stat_dir\perf_records.jsonl
 scripts/run_tests.py --running-type="performance" > build\perf_stat_dir\perf_log.txt
-python scripts\create_perf_table.py --input build\perf_stat_dir\perf_log.txt --output build\perf_stat_dir
+python scripts\create_perf_table.py --input build\perf_stat_dir\perf_records.jsonl --output build\perf_stat_dir
@@ -2,5 +2,7 @@
 set -euo pipefail
 
 mkdir -p build/perf_stat_dir
+rm -f build/perf_stat_dir/perf_records.jsonl
+export PPC_PERF_OUTPUT="$(pwd)/build/perf_stat_dir/perf_records.jsonl"
 scripts/run_tests.py --running-type="performance" | tee build/perf_stat_dir/perf_log.txt
-python3 scripts/create_perf_table.py --input build/perf_stat_dir/perf_log.txt --output build/perf_stat_dir
+python3 scripts/create_perf_table.py --input build/perf_stat_dir/perf_records.jsonl --output build/perf_stat_dir
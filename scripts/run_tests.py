@@ -131,6 +131,25 @@ class PPCRunner:
             return "mpich", "-n"
         return "unknown", "-np"
 
+    def __get_optional_env_vars(self):
+        """Optional PPC_* settings that must reach every rank when they are set."""
+        optional_vars = [
+            "PPC_PERF_OUTPUT",
+            "PPC_PERF_HW_COUNTERS",
+            "PPC_PERF_COLD_CACHE",
+            "PPC_BIND",
+            "PPC_MPI_THREAD_LEVEL",
+            "PPC_OMP_POOL",
+            "PPC_TASK_GROUPS",
+            "PPC_PERF_IN_FLIGHT",
+            "PPC_PERF_GRAPH",
+            "PPC_PERF_SCALING",
+            "PPC_PERF_BASELINE",
+            "PPC_PERF_REGRESSION_THRESHOLD",
+            "PPC_PERF_FAIL_ON_REGRESSION",
+        ]
+        return [var for var in optional_vars if var in self.__ppc_env]
+
     def __build_mpi_cmd(self, ppc_num_proc, additional_mpi_args):
         base = [self.mpi_exec] + shlex.split(additional_mpi_args)
 
@@ -144,6 +163,8 @@ class PPCRunner:
                 "OMP_NUM_THREADS",
                 self.__ppc_env["OMP_NUM_THREADS"],
             ]
+            for var in self.__get_optional_env_vars():
+                env_args += ["-env", var, self.__ppc_env[var]]
             np_args = ["-n", ppc_num_proc]
             return base + env_args + np_args
 
@@ -155,6 +176,8 @@ class PPCRunner:
                 "-x",
                 "OMP_NUM_THREADS",
             ]
+            for var in self.__get_optional_env_vars():
+                env_args += ["-x", var]
             np_flag = "-np"
         elif self.mpi_env_mode == "mpich":
             # Explicitly set env variables for all ranks
@@ -166,13 +189,23 @@ class PPCRunner:
                 "OMP_NUM_THREADS",
                 self.__ppc_env["OMP_NUM_THREADS"],
             ]
+            for var in self.__get_optional_env_vars():
+                env_args += ["-env", var, self.__ppc_env[var]]
             np_flag = "-n"
         else:
             # Unknown MPI flavor: rely on environment inheritance and default to -np
             env_args = []
             np_flag = "-np"
 
-        return base + env_args + [np_flag, ppc_num_proc]
+        # PPC_BIND places ranks itself, so the launcher must not pin them first
+        bind_args = []
+        if self.__ppc_env.get("PPC_BIND", "none") != "none" and self.mpi_env_mode in (
+            "openmpi",
+            "mpich",
+        ):
+            bind_args = ["--bind-to", "none"] if self.mpi_env_mode == "openmpi" else ["-bind-to", "none"]
+
+        return base + env_args + bind_args + [np_flag, ppc_num_proc]
 
     @staticmethod
     def __get_gtest_settings(repeats_count, type_task):
@@ -227,6 +260,12 @@ class PPCRunner:
                     + [str(self.work_dir / "ppc_func_tests")]
                     + self.__get_gtest_settings(1, "_" + task_type + "_")
                 )
+            # Core suites named *Mpi run collectives; no shuffle, every rank must run the tests in the same order
+            self.__run_exec(
+                mpi_running
+                + [str(self.work_dir / "core_func_tests")]
+                + ["--gtest_color=0", "--gtest_filter=*Mpi.*"]
+            )
 
     def run_performance(self):
         if not self.__ppc_env.get("PPC_ASAN_RUN"):
@@ -1,9 +1,8 @@
 #pragma once
 
-#include <vector>
-
 #include "baranov_a_dijkstra_crs/common/include/common.hpp"
 #include "task/include/task.hpp"
+#include "util/include/partition.hpp"
 
 namespace baranov_a_dijkstra_crs {
 
@@ -12,7 +11,11 @@ class BaranovADijkstraCRSMPI : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kMPI;
   }
-  explicit BaranovADijkstraCRSMPI(const InType &in);
+  explicit BaranovADijkstraCRSMPI(InType in);
+
+  [[nodiscard]] bool SupportsCommunicator() const override {
+    return true;
+  }
 
  private:
   bool ValidationImpl() override;
@@ -20,14 +23,7 @@ class BaranovADijkstraCRSMPI : public BaseTask {
   bool RunImpl() override;
   bool PostProcessingImpl() override;
 
-  void DistributeGraphData();
-  void GatherResults();
-
-  std::vector<int> local_offsets_;
-  std::vector<int> local_columns_;
-  std::vector<double> local_values_;
-  std::vector<int> vertex_ownership_;
-  int local_num_vertices_ = 0;
+  ppc::util::Partition vertices_;
   int world_size_ = 0;
   int world_rank_ = 0;
 };
@@ -2,214 +2,22 @@
 
 #include <mpi.h>
 
-#include <cmath>
 #include <cstddef>
-#include <limits>
+#include <span>
+#include <utility>
 #include <vector>
 
 #include "baranov_a_dijkstra_crs/common/include/common.hpp"
+#include "util/include/delta_stepping.hpp"
+#include "util/include/local_csr.hpp"
+#include "util/include/partition.hpp"
+#include "util/include/scatter_gather.hpp"
 
 namespace baranov_a_dijkstra_crs {
 
-namespace {
-void CalculateVertexDistribution(int world_rank, int world_size, int total_vertices, int &local_start, int &local_end,
-                                 int &local_count) {
-  int vertices_per_process = total_vertices / world_size;
-  int remainder = total_vertices % world_size;
-
-  if (world_rank < remainder) {
-    local_start = world_rank * (vertices_per_process + 1);
-    local_end = local_start + vertices_per_process + 1;
-  } else {
-    local_start = (remainder * (vertices_per_process + 1)) + ((world_rank - remainder) * vertices_per_process);
-    local_end = local_start + vertices_per_process;
-  }
-  local_count = local_end - local_start;
-}
-
-void InitializeVertexOwnership(std::vector<int> &vertex_ownership, int total_vertices, int world_size) {
-  vertex_ownership.resize(total_vertices);
-  for (int i = 0; i < total_vertices; ++i) {
-    vertex_ownership[i] = i % world_size;
-  }
-}
-
-void CopyLocalEdges(const GraphData &graph, int local_start, int local_end, int total_vertices,
-                    std::vector<int> &local_columns, std::vector<double> &local_values) {
-  int start_edge = graph.offsets[local_start];
-  int end_edge = (local_end <= total_vertices) ? graph.offsets[local_end] : graph.offsets[total_vertices];
-  int total_edges = end_edge - start_edge;
-
-  if (total_edges > 0) {
-    local_columns.resize(total_edges);
-    local_values.resize(total_edges);
-
-    for (int i = 0; i < total_edges; ++i) {
-      if (start_edge + i < static_cast<int>(graph.columns.size())) {
-        local_columns[i] = graph.columns[start_edge + i];
-        local_values[i] = graph.values[start_edge + i];
-      }
-    }
-  } else {
-    local_columns.clear();
-    local_values.clear();
-  }
-}
-
-void InitializeGlobalDist(std::vector<double> &global_dist, int total_vertices, int source, bool i_own_source) {
-  if (total_vertices > 0) {
-    global_dist.resize(total_vertices, std::numeric_limits<double>::infinity());
-    if (i_own_source && !global_dist.empty() && source >= 0 && static_cast<std::size_t>(source) < global_dist.size()) {
-      global_dist[source] = 0.0;
-    }
-  }
-}
-
-bool ProcessNeighbors(const std::vector<double> &local_dist, int global_v, const std::vector<int> &local_offsets, int i,
-                      const std::vector<int> &local_columns, const std::vector<double> &local_values,
-                      int total_vertices, std::vector<double> &new_dist) {
-  bool changed = false;
-  int start = local_offsets[i];
-  int end = local_offsets[i + 1];
-
-  for (int idx = start; idx < end; ++idx) {
-    if (static_cast<std::size_t>(idx) >= local_columns.size()) {
-      continue;
-    }
-
-    int neighbor = local_columns[idx];
-    double weight = local_values[idx];
-
-    if (neighbor < 0 || neighbor >= total_vertices) {
-      continue;
-    }
-
-    double new_distance = local_dist[global_v] + weight;
-    if (new_distance < new_dist[neighbor]) {
-      new_dist[neighbor] = new_distance;
-      changed = true;
-    }
-  }
-  return changed;
-}
-
-bool ProcessLocalVertices(const std::vector<double> &local_dist, const std::vector<int> &local_offsets,
-                          const std::vector<int> &local_columns, const std::vector<double> &local_values,
-                          int local_start, int local_num_vertices, int total_vertices, std::vector<double> &new_dist) {
-  bool changed = false;
-
-  if (local_num_vertices <= 0 || local_start >= total_vertices || local_dist.empty()) {
-    return changed;
-  }
-
-  for (int i = 0; i < local_num_vertices; ++i) {
-    int global_v = local_start + i;
-    if (global_v >= total_vertices) {
-      continue;
-    }
-
-    if (local_dist[global_v] >= std::numeric_limits<double>::infinity()) {
-      continue;
-    }
-
-    if (i >= static_cast<int>(local_offsets.size()) - 1) {
-      continue;
-    }
-
-    changed = ProcessNeighbors(local_dist, global_v, local_offsets, i, local_columns, local_values, total_vertices,
-                               new_dist) ||
-              changed;
-  }
-
-  return changed;
-}
-
-bool UpdateDistances(std::vector<double> &global_dist, std::vector<double> &local_dist, std::vector<double> &new_dist,
-                     int total_vertices) {
-  MPI_Allreduce(new_dist.data(), global_dist.data(), total_vertices, MPI_DOUBLE, MPI_MIN, MPI_COMM_WORLD);
-
-  if (!global_dist.empty() && !local_dist.empty() && global_dist.size() == local_dist.size()) {
-    local_dist.assign(global_dist.begin(), global_dist.end());
-  }
-
-  if (!global_dist.empty() && !new_dist.empty() && global_dist.size() == new_dist.size()) {
-    new_dist.assign(global_dist.begin(), global_dist.end());
-  }
-
-  return true;
-}
-
-bool InitializeDistances(const GraphData &graph, int world_rank, int world_size, std::vector<double> &global_dist,
-                         std::vector<double> &local_dist, std::vector<double> &new_dist, int &source_owner) {
-  const int total_vertices = graph.num_vertices;
-  const int source = graph.source_vertex;
-
-  int local_start = 0;
-  int local_end = 0;
-  int local_num_vertices = 0;
-  CalculateVertexDistribution(world_rank, world_size, total_vertices, local_start, local_end, local_num_vertices);
-
-  if (local_end > total_vertices) {
-    local_end = total_vertices;
-    local_num_vertices = local_end - local_start;
-  }
-
-  bool i_own_source = (total_vertices > 0 && local_num_vertices > 0 && source >= local_start && source < local_end);
-  InitializeGlobalDist(global_dist, total_vertices, source, i_own_source);
-
-  int my_has_source = i_own_source ? world_rank : -1;
-  MPI_Allreduce(&my_has_source, &source_owner, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
-
-  if (source_owner >= 0 && !global_dist.empty()) {
-    MPI_Bcast(global_dist.data(), total_vertices, MPI_DOUBLE, source_owner, MPI_COMM_WORLD);
-  }
-
-  if (global_dist.empty()) {
-    return false;
-  }
-
-  if (!global_dist.empty()) {
-    local_dist = global_dist;
-    new_dist = global_dist;
-  } else {
-    local_dist.clear();
-    new_dist.clear();
-  }
-
-  return true;
-}
-
-bool PerformDijkstraIterations(const std::vector<double> &local_dist, const std::vector<int> &local_offsets,
-                               const std::vector<int> &local_columns, const std::vector<double> &local_values,
-                               int local_start, int local_num_vertices, int total_vertices,
-                               std::vector<double> &global_dist, std::vector<double> &new_dist) {
-  std::vector<double> current_local_dist = local_dist;
-  std::vector<double> current_new_dist = new_dist;
-
-  for (int iter = 0; iter < total_vertices; ++iter) {
-    bool changed = ProcessLocalVertices(current_local_dist, local_offsets, local_columns, local_values, local_start,
-                                        local_num_vertices, total_vertices, current_new_dist);
-
-    int global_changed = 0;
-    int local_changed_int = changed ? 1 : 0;
-    MPI_Allreduce(&local_changed_int, &global_changed, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
-
-    if (global_changed == 0) {
-      break;
-    }
-
-    if (!current_new_dist.empty() && !global_dist.empty()) {
-      UpdateDistances(global_dist, current_local_dist, current_new_dist, total_vertices);
-    }
-  }
-
-  return true;
-}
-}  // namespace
-
-BaranovADijkstraCRSMPI::BaranovADijkstraCRSMPI(const InType &in) {
+BaranovADijkstraCRSMPI::BaranovADijkstraCRSMPI(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
   GetOutput() = std::vector<double>();
 }
 
@@ -228,86 +36,28 @@ bool BaranovADijkstraCRSMPI::ValidationImpl() {
 }
 
 bool BaranovADijkstraCRSMPI::PreProcessingImpl() {
-  MPI_Comm_size(MPI_COMM_WORLD, &world_size_);
-  MPI_Comm_rank(MPI_COMM_WORLD, &world_rank_);
+  MPI_Comm_size(GetCommunicator(), &world_size_);
+  MPI_Comm_rank(GetCommunicator(), &world_rank_);
   return true;
 }
 
-void BaranovADijkstraCRSMPI::DistributeGraphData() {
-  const auto &graph = GetInput();
-  const int total_vertices = graph.num_vertices;
-
-  int local_start = 0;
-  int local_end = 0;
-  CalculateVertexDistribution(world_rank_, world_size_, total_vertices, local_start, local_end, local_num_vertices_);
-
-  if (local_end > total_vertices) {
-    local_end = total_vertices;
-    local_num_vertices_ = local_end - local_start;
-  }
-
-  if (local_num_vertices_ <= 0 || local_start >= total_vertices) {
-    local_offsets_.clear();
-    local_columns_.clear();
-    local_values_.clear();
-    InitializeVertexOwnership(vertex_ownership_, total_vertices, world_size_);
-    return;
-  }
-
-  InitializeVertexOwnership(vertex_ownership_, total_vertices, world_size_);
-  local_offsets_.resize(static_cast<std::size_t>(local_num_vertices_) + 1);
-
-  for (int i = 0; i <= local_num_vertices_; ++i) {
-    int global_idx = local_start + i;
-    if (global_idx <= total_vertices) {
-      local_offsets_[static_cast<std::size_t>(i)] =
-          graph.offsets[static_cast<std::size_t>(global_idx)] - graph.offsets[static_cast<std::size_t>(local_start)];
-    } else {
-      local_offsets_[static_cast<std::size_t>(i)] = graph.offsets[static_cast<std::size_t>(total_vertices)] -
-                                                    graph.offsets[static_cast<std::size_t>(local_start)];
-    }
-  }
-
-  CopyLocalEdges(graph, local_start, local_end, total_vertices, local_columns_, local_values_);
-}
-
 bool BaranovADijkstraCRSMPI::RunImpl() {
   const auto &graph = GetInput();
-  const int total_vertices = graph.num_vertices;
-
-  if (total_vertices <= 0) {
-    GetOutput() = std::vector<double>();
-    MPI_Barrier(MPI_COMM_WORLD);
-    return true;
-  }
-
-  DistributeGraphData();
+  vertices_ = ppc::util::Partition::Block(graph.num_vertices, world_size_);
 
-  std::vector<double> global_dist;
-  std::vector<double> local_dist;
-  std::vector<double> new_dist;
-  int source_owner = -1;
-
-  if (!InitializeDistances(graph, world_rank_, world_size_, global_dist, local_dist, new_dist, source_owner)) {
-    GetOutput() = std::vector<double>();
-    MPI_Barrier(MPI_COMM_WORLD);
-    return true;
-  }
-
-  int local_start = 0;
-  int local_end = 0;
-  CalculateVertexDistribution(world_rank_, world_size_, total_vertices, local_start, local_end, local_num_vertices_);
-
-  if (local_end > total_vertices) {
-    local_end = total_vertices;
-    local_num_vertices_ = local_end - local_start;
-  }
+  // The local rows are views into the whole graph every rank holds: the offsets are not rebased, so the edge
+  // arrays need no copy
+  const auto local_offsets = std::span<const int>(graph.offsets)
+                                 .subspan(static_cast<std::size_t>(vertices_.Offset(world_rank_)),
+                                          static_cast<std::size_t>(vertices_.Count(world_rank_)) + 1);
+  const ppc::util::LocalCsr<double> local_graph{
+      .offsets = local_offsets, .columns = graph.columns, .weights = graph.values};
 
-  PerformDijkstraIterations(local_dist, local_offsets_, local_columns_, local_values_, local_start, local_num_vertices_,
-                            total_vertices, global_dist, new_dist);
+  // Delta-stepping only exchanges relaxations of remote vertices instead of reducing all distances every round
+  ppc::util::DeltaSteppingSssp<double> sssp(local_graph, vertices_, GetCommunicator());
+  const auto local_dist = sssp.Run(graph.source_vertex);
 
-  GetOutput() = global_dist;
-  MPI_Barrier(MPI_COMM_WORLD);
+  GetOutput() = ppc::util::Allgatherv(local_dist, vertices_, GetCommunicator());
   return true;
 }
 
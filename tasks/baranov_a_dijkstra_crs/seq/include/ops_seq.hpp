@@ -10,7 +10,7 @@ class BaranovADijkstraCRSSEQ : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kSEQ;
   }
-  explicit BaranovADijkstraCRSSEQ(const InType &in);
+  explicit BaranovADijkstraCRSSEQ(InType in);
 
  private:
   bool ValidationImpl() override;
@@ -11,9 +11,9 @@
 
 namespace baranov_a_dijkstra_crs {
 
-BaranovADijkstraCRSSEQ::BaranovADijkstraCRSSEQ(const InType &in) {
+BaranovADijkstraCRSSEQ::BaranovADijkstraCRSSEQ(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
   GetOutput() = std::vector<double>();
 }
 
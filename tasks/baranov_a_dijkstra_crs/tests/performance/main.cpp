@@ -1,12 +1,15 @@
 #include <gtest/gtest.h>
+#include <mpi.h>
 
-#include <cmath>
-#include <random>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
 #include <vector>
 
 #include "baranov_a_dijkstra_crs/common/include/common.hpp"
 #include "baranov_a_dijkstra_crs/mpi/include/ops_mpi.hpp"
 #include "baranov_a_dijkstra_crs/seq/include/ops_seq.hpp"
+#include "util/include/csr_snapshot.hpp"
 #include "util/include/perf_test_util.hpp"
 
 namespace baranov_a_dijkstra_crs {
@@ -14,35 +17,7 @@ namespace baranov_a_dijkstra_crs {
 class BaranovADijkstraCRSPerfTests : public ppc::util::BaseRunPerfTests<InType, OutType> {
  protected:
   void SetUp() override {
-    int num_vertices = 1000;
-    int edges_per_vertex = 10;
-
-    GraphData graph;
-    graph.num_vertices = num_vertices;
-    graph.source_vertex = 0;
-
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> vertex_dis(0, num_vertices - 1);
-    std::uniform_real_distribution<> weight_dis(0.1, 10.0);
-
-    graph.offsets.resize(num_vertices + 1);
-    graph.offsets[0] = 0;
-
-    for (int i = 0; i < num_vertices; ++i) {
-      int num_edges = edges_per_vertex;
-      graph.offsets[i + 1] = graph.offsets[i] + num_edges;
-
-      for (int j = 0; j < num_edges; ++j) {
-        int target = vertex_dis(gen);
-        double weight = weight_dis(gen);
-
-        graph.columns.push_back(target);
-        graph.values.push_back(weight);
-      }
-    }
-
-    input_data_ = graph;
+    input_data_ = LoadGraph(1000, true);
   }
 
   bool CheckTestOutputData(OutType &output_data) final {
@@ -53,7 +28,48 @@ class BaranovADijkstraCRSPerfTests : public ppc::util::BaseRunPerfTests<InType,
     return input_data_;
   }
 
+  std::vector<std::size_t> GetScalingSizes() final {
+    return {1000, 2000, 4000};
+  }
+
+  InType GetScaledInputData(std::size_t size) final {
+    return LoadGraph(static_cast<int>(size), false);
+  }
+
  private:
+  /// @brief Random graph with 10 edges per vertex, seeded by the size, so every rank, run and scaling point of that
+  ///        size gets the same graph; PPC_PERF_GRAPH replaces the graph of the main measurement.
+  static GraphData LoadGraph(int num_vertices, bool allow_perf_graph) {
+    const ppc::util::GraphGeneratorOptions options = {.model = ppc::util::GraphModel::kErdosRenyi,
+                                                      .vertices = num_vertices,
+                                                      .edges = 10LL * num_vertices,
+                                                      .min_weight = 0.1,
+                                                      .max_weight = 10.0,
+                                                      .seed = static_cast<std::uint64_t>(num_vertices),
+                                                      .source = 0,
+                                                      .a = 0.57,
+                                                      .b = 0.19,
+                                                      .c = 0.19};
+    // One rank per node writes the cached snapshot, the others open it once it is there
+    const auto path = ppc::util::PrepareSnapshotPerNode(MPI_COMM_WORLD, [&] {
+      auto perf_graph = allow_perf_graph ? ppc::util::GetPerfGraphSnapshot(ppc::util::CsrWeightType::kFloat64)
+                                         : std::nullopt;
+      if (!perf_graph.has_value()) {
+        perf_graph = ppc::util::CachedGeneratedSnapshot(options, ppc::util::CsrWeightType::kFloat64);
+      }
+      return perf_graph;
+    });
+    const auto snapshot = ppc::util::CsrSnapshot::Open(*path);
+
+    GraphData graph;
+    graph.num_vertices = snapshot.Vertices();
+    graph.source_vertex = snapshot.Source();
+    graph.offsets.assign(snapshot.RowPtr().begin(), snapshot.RowPtr().end());
+    graph.columns.assign(snapshot.ColIdx().begin(), snapshot.ColIdx().end());
+    graph.values = snapshot.CopyWeights<double>();
+    return graph;
+  }
+
   InType input_data_;
 };
 
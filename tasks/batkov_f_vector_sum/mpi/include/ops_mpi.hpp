@@ -7,8 +7,12 @@
 
 namespace batkov_f_vector_sum {
 
+class BatkovFVectorSumBatchMPI;
+
 class BatkovFVectorSumMPI : public BaseTask {
  public:
+  using BatchTask = BatkovFVectorSumBatchMPI;
+
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kMPI;
   }
@@ -24,4 +28,14 @@ class BatkovFVectorSumMPI : public BaseTask {
   size_t m_mpi_size_{0};
 };
 
+/// @brief Sums many vectors with one scatter and one reduction for the whole batch.
+class BatkovFVectorSumBatchMPI : public ppc::task::BatchTask<BatkovFVectorSumMPI, InType, OutType> {
+ public:
+  using Base = ppc::task::BatchTask<BatkovFVectorSumMPI, InType, OutType>;
+  using Base::Base;
+
+ private:
+  bool RunImpl() override;
+};
+
 }  // namespace batkov_f_vector_sum
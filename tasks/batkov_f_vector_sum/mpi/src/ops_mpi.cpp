@@ -2,8 +2,10 @@
 
 #include <mpi.h>
 
+#include <algorithm>
 #include <cstddef>
 #include <limits>
+#include <utility>
 #include <vector>
 
 #include "batkov_f_vector_sum/common/include/common.hpp"
@@ -101,4 +103,61 @@ bool BatkovFVectorSumMPI::PostProcessingImpl() {
   return true;
 }
 
+bool BatkovFVectorSumBatchMPI::RunImpl() {
+  int rank = 0;
+  int mpi_size = 0;
+  MPI_Comm_rank(GetCommunicator(), &rank);
+  MPI_Comm_size(GetCommunicator(), &mpi_size);
+
+  // The vectors are packed back to back and split evenly over the ranks, every rank sums its slice per vector
+  std::vector<int> offsets;
+  std::vector<int> packed;
+  int batch_size = 0;
+  if (rank == 0) {
+    const auto &vectors = GetInput();
+    batch_size = static_cast<int>(vectors.size());
+    offsets.reserve(vectors.size() + 1);
+    for (const auto &vec : vectors) {
+      offsets.push_back(static_cast<int>(packed.size()));
+      packed.insert(packed.end(), vec.begin(), vec.end());
+    }
+    offsets.push_back(static_cast<int>(packed.size()));
+  }
+
+  MPI_Bcast(&batch_size, 1, MPI_INT, 0, GetCommunicator());
+  offsets.resize(static_cast<size_t>(batch_size) + 1);
+  MPI_Bcast(offsets.data(), batch_size + 1, MPI_INT, 0, GetCommunicator());
+
+  const int total = offsets.back();
+  std::vector<int> send_counts(static_cast<size_t>(mpi_size), total / mpi_size);
+  std::vector<int> displs(static_cast<size_t>(mpi_size), 0);
+  for (int i = 0; i < mpi_size; ++i) {
+    if (i < total % mpi_size) {
+      send_counts[i]++;
+    }
+    if (i > 0) {
+      displs[i] = displs[i - 1] + send_counts[i - 1];
+    }
+  }
+
+  const int local_count = send_counts[rank];
+  std::vector<int> local_data(static_cast<size_t>(local_count));
+  MPI_Scatterv(packed.data(), send_counts.data(), displs.data(), MPI_INT, local_data.data(), local_count, MPI_INT, 0,
+               GetCommunicator());
+
+  std::vector<int> sums(static_cast<size_t>(batch_size), 0);
+  const int local_start = displs[rank];
+  auto vec = static_cast<size_t>(std::upper_bound(offsets.begin(), offsets.end(), local_start) - offsets.begin());
+  for (int i = 0; i < local_count; ++i) {
+    while (local_start + i >= offsets[vec]) {
+      vec++;
+    }
+    sums[vec - 1] += local_data[i];
+  }
+  MPI_Allreduce(MPI_IN_PLACE, sums.data(), batch_size, MPI_INT, MPI_SUM, GetCommunicator());
+
+  GetOutput() = std::move(sums);
+  return true;
+}
+
 }  // namespace batkov_f_vector_sum
@@ -4,6 +4,7 @@
 #include <fstream>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 #include "batkov_f_vector_sum/common/include/common.hpp"
 #include "batkov_f_vector_sum/mpi/include/ops_mpi.hpp"
@@ -16,6 +17,8 @@ namespace batkov_f_vector_sum {
 class BatkovFRunPerfTestProcesses : public ppc::util::BaseRunPerfTests<InType, OutType> {
   InType input_data_;
   OutType expected_sum_{0};
+  std::vector<InType> batch_input_;
+  std::vector<OutType> batch_expected_;
 
   void SetUp() override {
     std::string filename = "one_million_vec.txt";
@@ -39,6 +42,19 @@ class BatkovFRunPerfTestProcesses : public ppc::util::BaseRunPerfTests<InType, O
     expected_sum_ *= 128;
 
     file.close();
+
+    // Many short vectors for the batch measurement
+    const size_t k_num_vectors = 20000;
+    for (size_t i = 0; i < k_num_vectors; ++i) {
+      InType vec(1 + (i % 64));
+      OutType sum = 0;
+      for (size_t j = 0; j < vec.size(); ++j) {
+        vec[j] = (static_cast<int>((i * 31) + j) % 201) - 100;
+        sum += vec[j];
+      }
+      batch_input_.push_back(vec);
+      batch_expected_.push_back(sum);
+    }
   }
 
   bool CheckTestOutputData(OutType &output_data) final {
@@ -48,6 +64,14 @@ class BatkovFRunPerfTestProcesses : public ppc::util::BaseRunPerfTests<InType, O
   InType GetTestInputData() final {
     return input_data_;
   }
+
+  std::vector<InType> GetBatchInputData() final {
+    return batch_input_;
+  }
+
+  bool CheckBatchOutputData(std::vector<OutType> &outputs) final {
+    return outputs == batch_expected_;
+  }
 };
 
 namespace {
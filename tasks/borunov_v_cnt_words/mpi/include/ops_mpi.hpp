@@ -8,8 +8,12 @@
 
 namespace borunov_v_cnt_words {
 
+class BorunovVCntWordsBatchMPI;
+
 class BorunovVCntWordsMPI : public BaseTask {
  public:
+  using BatchTask = BorunovVCntWordsBatchMPI;
+
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kMPI;
   }
@@ -22,6 +26,18 @@ class BorunovVCntWordsMPI : public BaseTask {
   bool PostProcessingImpl() override;
   static void CalculateDistribution(int text_len, int world_size, std::vector<int> &counts, std::vector<int> &displs);
   static uint64_t CountWordsLocal(const char *data, int count, char prev_char);
+
+  friend class BorunovVCntWordsBatchMPI;
+};
+
+/// @brief Counts the words of many texts with one scatter and one reduction for the whole batch.
+class BorunovVCntWordsBatchMPI : public ppc::task::BatchTask<BorunovVCntWordsMPI, InType, OutType> {
+ public:
+  using Base = ppc::task::BatchTask<BorunovVCntWordsMPI, InType, OutType>;
+  using Base::Base;
+
+ private:
+  bool RunImpl() override;
 };
 
 }  // namespace borunov_v_cnt_words
@@ -2,7 +2,9 @@
 
 #include <mpi.h>
 
+#include <algorithm>
 #include <cctype>
+#include <cstddef>
 #include <cstdint>
 #include <string>
 #include <vector>
@@ -137,4 +139,66 @@ bool BorunovVCntWordsMPI::PostProcessingImpl() {
   return true;
 }
 
+bool BorunovVCntWordsBatchMPI::RunImpl() {
+  int rank = 0;
+  int world_size = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &world_size);
+
+  // Texts are packed into one buffer, each followed by a space, so no word spans two texts
+  std::vector<int> offsets;
+  std::string packed;
+  int batch_size = 0;
+  if (rank == 0) {
+    const auto &texts = GetInput();
+    batch_size = static_cast<int>(texts.size());
+    offsets.reserve(texts.size() + 1);
+    for (const auto &text : texts) {
+      offsets.push_back(static_cast<int>(packed.size()));
+      packed += text;
+      packed += ' ';
+    }
+    offsets.push_back(static_cast<int>(packed.size()));
+  }
+
+  MPI_Bcast(&batch_size, 1, MPI_INT, 0, MPI_COMM_WORLD);
+  offsets.resize(static_cast<std::size_t>(batch_size) + 1);
+  MPI_Bcast(offsets.data(), batch_size + 1, MPI_INT, 0, MPI_COMM_WORLD);
+
+  std::vector<int> send_counts;
+  std::vector<int> displs;
+  BorunovVCntWordsMPI::CalculateDistribution(offsets.back(), world_size, send_counts, displs);
+
+  const int local_count = send_counts[rank];
+  std::vector<char> local_data(local_count);
+  MPI_Scatterv(packed.data(), send_counts.data(), displs.data(), MPI_CHAR, local_data.data(), local_count, MPI_CHAR,
+               0, MPI_COMM_WORLD);
+
+  int left_neighbor = (rank == 0) ? MPI_PROC_NULL : rank - 1;
+  int right_neighbor = (rank == world_size - 1) ? MPI_PROC_NULL : rank + 1;
+  char char_to_send = local_count > 0 ? local_data.back() : ' ';
+  char prev_char = ' ';
+  MPI_Sendrecv(&char_to_send, 1, MPI_CHAR, right_neighbor, 0, &prev_char, 1, MPI_CHAR, left_neighbor, 0, MPI_COMM_WORLD,
+               MPI_STATUS_IGNORE);
+
+  std::vector<uint64_t> local_counts(static_cast<std::size_t>(batch_size), 0);
+  const int local_start = displs[rank];
+  auto text = static_cast<std::size_t>(std::upper_bound(offsets.begin(), offsets.end(), local_start) - offsets.begin());
+  for (int i = 0; i < local_count; ++i) {
+    while (local_start + i >= offsets[text]) {
+      text++;
+    }
+    const auto current = static_cast<unsigned char>(local_data[i]);
+    const auto prev = static_cast<unsigned char>(i == 0 ? prev_char : local_data[i - 1]);
+    if (std::isspace(current) == 0 && std::isspace(prev) != 0) {
+      local_counts[text - 1]++;
+    }
+  }
+
+  std::vector<uint64_t> counts(local_counts.size(), 0);
+  MPI_Allreduce(local_counts.data(), counts.data(), batch_size, MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD);
+  GetOutput().assign(counts.begin(), counts.end());
+  return true;
+}
+
 }  // namespace borunov_v_cnt_words
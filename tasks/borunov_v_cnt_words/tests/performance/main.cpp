@@ -2,6 +2,8 @@
 
 #include <cstddef>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "borunov_v_cnt_words/common/include/common.hpp"
 #include "borunov_v_cnt_words/mpi/include/ops_mpi.hpp"
@@ -23,6 +25,18 @@ class BorunovVCntWordsPerfTests : public ppc::util::BaseRunPerfTests<InType, Out
     }
 
     expected_count_ = k_num_words;
+
+    // Many short texts for the batch measurement
+    const size_t k_num_texts = 20000;
+    for (size_t i = 0; i < k_num_texts; ++i) {
+      const size_t words = 1 + (i % 16);
+      std::string text;
+      for (size_t j = 0; j < words; ++j) {
+        text += (j % 3 == 0) ? "  word\t" : k_word;
+      }
+      batch_input_.push_back(std::move(text));
+      batch_expected_.push_back(words);
+    }
   }
 
   bool CheckTestOutputData(OutType &output_data) final {
@@ -33,9 +47,19 @@ class BorunovVCntWordsPerfTests : public ppc::util::BaseRunPerfTests<InType, Out
     return input_data_;
   }
 
+  std::vector<InType> GetBatchInputData() final {
+    return batch_input_;
+  }
+
+  bool CheckBatchOutputData(std::vector<OutType> &outputs) final {
+    return outputs == batch_expected_;
+  }
+
  private:
   InType input_data_;
   OutType expected_count_ = 0;
+  std::vector<InType> batch_input_;
+  std::vector<OutType> batch_expected_;
 };
 
 TEST_P(BorunovVCntWordsPerfTests, RunPerfModes) {
@@ -7,6 +7,7 @@
 #include <vector>
 
 #include "dorogin_v_contrast_enhancement/common/include/common.hpp"
+#include "task/include/task.hpp"
 
 namespace dorogin_v_contrast_enhancement {
 
@@ -17,30 +18,36 @@ DoroginVContrastEnhancementMPI::DoroginVContrastEnhancementMPI(const InType &in)
 }
 
 bool DoroginVContrastEnhancementMPI::ValidationImpl() {
-  MPI_Comm_rank(MPI_COMM_WORLD, &world_rank_);
-  MPI_Comm_size(MPI_COMM_WORLD, &world_size_);
+  MPI_Comm_rank(GetCommunicator(), &world_rank_);
+  MPI_Comm_size(GetCommunicator(), &world_size_);
 
   int valid_flag = 0;
   if (world_rank_ == 0) {
     valid_flag = !GetInput().empty() ? 1 : 0;
   }
 
-  MPI_Bcast(&valid_flag, 1, MPI_INT, 0, MPI_COMM_WORLD);
+  MPI_Bcast(&valid_flag, 1, MPI_INT, 0, GetCommunicator());
   return valid_flag == 1;
 }
 
 bool DoroginVContrastEnhancementMPI::PreProcessingImpl() {
-  MPI_Comm_rank(MPI_COMM_WORLD, &world_rank_);
-  MPI_Comm_size(MPI_COMM_WORLD, &world_size_);
+  MPI_Comm_rank(GetCommunicator(), &world_rank_);
+  MPI_Comm_size(GetCommunicator(), &world_size_);
+
+  // If every rank already holds the pixels, the size is known and each rank copies its chunk, no collectives needed
+  const bool replicated = GetInputPlacement() == ppc::task::DataPlacement::kReplicated;
 
   int global_size = 0;
-  if (world_rank_ == 0) {
-    image_ = GetInput();
-    global_size = static_cast<int>(image_.size());
+  if (replicated) {
+    global_size = static_cast<int>(GetInput().size());
+  } else {
+    if (world_rank_ == 0) {
+      image_ = GetInput();
+      global_size = static_cast<int>(image_.size());
+    }
+    MPI_Bcast(&global_size, 1, MPI_INT, 0, GetCommunicator());
   }
 
-  MPI_Bcast(&global_size, 1, MPI_INT, 0, MPI_COMM_WORLD);
-
   std::vector<int> counts(world_size_, 0);
   std::vector<int> displs(world_size_, 0);
 
@@ -56,8 +63,12 @@ bool DoroginVContrastEnhancementMPI::PreProcessingImpl() {
   local_size_ = counts[world_rank_];
   local_image_.resize(local_size_);
 
-  MPI_Scatterv(world_rank_ == 0 ? image_.data() : nullptr, counts.data(), displs.data(), MPI_UNSIGNED_CHAR,
-               local_image_.data(), local_size_, MPI_UNSIGNED_CHAR, 0, MPI_COMM_WORLD);
+  if (replicated) {
+    std::copy_n(GetInput().begin() + displs[world_rank_], local_size_, local_image_.begin());
+  } else {
+    MPI_Scatterv(world_rank_ == 0 ? image_.data() : nullptr, counts.data(), displs.data(), MPI_UNSIGNED_CHAR,
+                 local_image_.data(), local_size_, MPI_UNSIGNED_CHAR, 0, GetCommunicator());
+  }
 
   result_.resize(global_size);
 
@@ -76,8 +87,8 @@ bool DoroginVContrastEnhancementMPI::RunImpl() {
   unsigned char global_min = 255;
   unsigned char global_max = 0;
 
-  MPI_Allreduce(&local_min, &global_min, 1, MPI_UNSIGNED_CHAR, MPI_MIN, MPI_COMM_WORLD);
-  MPI_Allreduce(&local_max, &global_max, 1, MPI_UNSIGNED_CHAR, MPI_MAX, MPI_COMM_WORLD);
+  MPI_Allreduce(&local_min, &global_min, 1, MPI_UNSIGNED_CHAR, MPI_MIN, GetCommunicator());
+  MPI_Allreduce(&local_max, &global_max, 1, MPI_UNSIGNED_CHAR, MPI_MAX, GetCommunicator());
 
   std::vector<uint8_t> local_result(local_size_);
 
@@ -105,9 +116,10 @@ bool DoroginVContrastEnhancementMPI::RunImpl() {
   }
 
   MPI_Gatherv(local_result.data(), local_size_, MPI_UNSIGNED_CHAR, result_.data(), counts.data(), displs.data(),
-              MPI_UNSIGNED_CHAR, 0, MPI_COMM_WORLD);
+              MPI_UNSIGNED_CHAR, 0, GetCommunicator());
 
-  MPI_Bcast(result_.data(), global_size, MPI_UNSIGNED_CHAR, 0, MPI_COMM_WORLD);
+  MPI_Bcast(result_.data(), global_size, MPI_UNSIGNED_CHAR, 0, GetCommunicator());
+  SetOutputPlacement(ppc::task::DataPlacement::kReplicated);
 
   return true;
 }
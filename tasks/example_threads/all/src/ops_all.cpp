@@ -4,11 +4,11 @@
 
 #include <atomic>
 #include <numeric>
-#include <thread>
 #include <vector>
 
 #include "example_threads/common/include/common.hpp"
 #include "oneapi/tbb/parallel_for.h"
+#include "util/include/runtime.hpp"
 #include "util/include/util.hpp"
 
 namespace nesterov_a_test_task_threads {
@@ -39,7 +39,7 @@ bool NesterovATestTaskALL::RunImpl() {
     }
   }
 
-  const int num_threads = ppc::util::GetNumThreads();
+  const int num_threads = ppc::util::GetRankThreadBudget();
   {
     GetOutput() *= num_threads;
 
@@ -47,7 +47,7 @@ bool NesterovATestTaskALL::RunImpl() {
     MPI_Comm_rank(MPI_COMM_WORLD, &rank);
     if (rank == 0) {
       std::atomic<int> counter(0);
-#pragma omp parallel default(none) shared(counter) num_threads(ppc::util::GetNumThreads())
+#pragma omp parallel default(none) shared(counter) num_threads(ppc::util::GetRankThreadBudget())
       counter++;
 
       GetOutput() /= counter;
@@ -58,19 +58,16 @@ bool NesterovATestTaskALL::RunImpl() {
 
   {
     GetOutput() *= num_threads;
-    std::vector<std::thread> threads(num_threads);
     std::atomic<int> counter(0);
-    for (int i = 0; i < num_threads; i++) {
-      threads[i] = std::thread([&]() { counter++; });
-      threads[i].join();
-    }
+    ppc::util::Runtime::GetThreadPool().ParallelFor(0, num_threads, [&](int /*i*/) { counter++; });
     GetOutput() /= counter;
   }
 
   {
     GetOutput() *= num_threads;
     std::atomic<int> counter(0);
-    tbb::parallel_for(0, ppc::util::GetNumThreads(), [&](int /*i*/) { counter++; });
+    ppc::util::Runtime::GetTaskArena().execute(
+        [&] { tbb::parallel_for(0, ppc::util::GetRankThreadBudget(), [&](int /*i*/) { counter++; }); });
     GetOutput() /= counter;
   }
   MPI_Barrier(MPI_COMM_WORLD);
@@ -2,11 +2,10 @@
 
 #include <atomic>
 #include <numeric>
-#include <thread>
 #include <vector>
 
 #include "example_threads/common/include/common.hpp"
-#include "util/include/util.hpp"
+#include "util/include/runtime.hpp"
 
 namespace nesterov_a_test_task_threads {
 
@@ -36,15 +35,12 @@ bool NesterovATestTaskSTL::RunImpl() {
     }
   }
 
-  const int num_threads = ppc::util::GetNumThreads();
-  std::vector<std::thread> threads(num_threads);
+  auto &pool = ppc::util::Runtime::GetThreadPool();
+  const int num_threads = pool.Size();
   GetOutput() *= num_threads;
 
   std::atomic<int> counter(0);
-  for (int i = 0; i < num_threads; i++) {
-    threads[i] = std::thread([&]() { counter++; });
-    threads[i].join();
-  }
+  pool.ParallelFor(0, num_threads, [&](int /*i*/) { counter++; });
 
   GetOutput() /= counter;
   return GetOutput() > 0;
@@ -9,6 +9,7 @@
 
 #include "example_threads/common/include/common.hpp"
 #include "oneapi/tbb/parallel_for.h"
+#include "util/include/runtime.hpp"
 
 namespace nesterov_a_test_task_threads {
 
@@ -42,7 +43,8 @@ bool NesterovATestTaskTBB::RunImpl() {
   GetOutput() *= num_threads;
 
   std::atomic<int> counter(0);
-  tbb::parallel_for(0, ppc::util::GetNumThreads(), [&](int /*i*/) { counter++; });
+  ppc::util::Runtime::GetTaskArena().execute(
+      [&] { tbb::parallel_for(0, ppc::util::GetNumThreads(), [&](int /*i*/) { counter++; }); });
 
   GetOutput() /= counter;
   return GetOutput() > 0;
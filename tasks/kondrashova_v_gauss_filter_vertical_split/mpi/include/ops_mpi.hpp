@@ -28,20 +28,10 @@ class KondrashovaVGaussFilterVerticalSplitMPI : public BaseTask {
 
   void BroadcastImageDimensions(int &width, int &height, int &channels);
 
-  static void CalculateColumnDistribution(int width, int size, std::vector<int> &col_counts,
-                                          std::vector<int> &col_offsets);
-
-  void DistributeImageData(int rank, int size, int width, int height, int channels, const std::vector<int> &col_counts,
-                           const std::vector<int> &col_offsets, std::vector<uint8_t> &local_data, int extended_cols);
-
   static void ApplyGaussFilterToLocalData(const std::vector<uint8_t> &local_data, std::vector<uint8_t> &local_result,
                                           int extended_cols, int local_cols, int height, int channels,
                                           int offset_in_extended);
 
-  void GatherResults(int rank, int size, int width, int height, int channels, const std::vector<int> &col_counts,
-                     const std::vector<int> &col_offsets, int local_start_col, int local_cols,
-                     const std::vector<uint8_t> &local_result);
-
   void BroadcastResultToAllProcesses(int width, int height, int channels);
 
   [[nodiscard]] static uint8_t ApplyGaussToLocalPixel(const std::vector<uint8_t> &local_data, int local_width,
@@ -49,9 +39,6 @@ class KondrashovaVGaussFilterVerticalSplitMPI : public BaseTask {
 
   static void CopyPixelsToBuffer(const std::vector<uint8_t> &src, std::vector<uint8_t> &dst, int src_width,
                                  int dst_width, int height, int channels, int src_start_col);
-
-  static void CopyBufferToOutput(const std::vector<uint8_t> &src, std::vector<uint8_t> &dst, int src_width,
-                                 int dst_width, int height, int channels, int dst_start_col);
 };
 
 }  // namespace kondrashova_v_gauss_filter_vertical_split
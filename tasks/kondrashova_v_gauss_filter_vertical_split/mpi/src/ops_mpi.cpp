@@ -9,6 +9,9 @@
 #include <vector>
 
 #include "kondrashova_v_gauss_filter_vertical_split/common/include/common.hpp"
+#include "task/include/task.hpp"
+#include "util/include/partition.hpp"
+#include "util/include/scatter_gather.hpp"
 
 namespace kondrashova_v_gauss_filter_vertical_split {
 
@@ -43,7 +46,7 @@ uint8_t KondrashovaVGaussFilterVerticalSplitMPI::ApplyGaussToLocalPixel(const st
 
 bool KondrashovaVGaussFilterVerticalSplitMPI::ValidationImpl() {
   int rank = 0;
-  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_rank(GetCommunicator(), &rank);
 
   if (rank == 0) {
     const auto &input = GetInput();
@@ -57,7 +60,7 @@ bool KondrashovaVGaussFilterVerticalSplitMPI::ValidationImpl() {
 
 bool KondrashovaVGaussFilterVerticalSplitMPI::PreProcessingImpl() {
   int rank = 0;
-  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_rank(GetCommunicator(), &rank);
 
   if (rank == 0) {
     const auto &input = GetInput();
@@ -73,7 +76,7 @@ bool KondrashovaVGaussFilterVerticalSplitMPI::PreProcessingImpl() {
 
 void KondrashovaVGaussFilterVerticalSplitMPI::BroadcastImageDimensions(int &width, int &height, int &channels) {
   int rank = 0;
-  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_rank(GetCommunicator(), &rank);
 
   if (rank == 0) {
     width = GetInput().width;
@@ -81,24 +84,9 @@ void KondrashovaVGaussFilterVerticalSplitMPI::BroadcastImageDimensions(int &widt
     channels = GetInput().channels;
   }
 
-  MPI_Bcast(&width, 1, MPI_INT, 0, MPI_COMM_WORLD);
-  MPI_Bcast(&height, 1, MPI_INT, 0, MPI_COMM_WORLD);
-  MPI_Bcast(&channels, 1, MPI_INT, 0, MPI_COMM_WORLD);
-}
-
-void KondrashovaVGaussFilterVerticalSplitMPI::CalculateColumnDistribution(int width, int size,
-                                                                          std::vector<int> &col_counts,
-                                                                          std::vector<int> &col_offsets) {
-  int base_cols = width / size;
-  int extra_cols = width % size;
-
-  col_counts.resize(size);
-  col_offsets.resize(size);
-
-  for (int i = 0; i < size; ++i) {
-    col_counts[i] = base_cols + (i < extra_cols ? 1 : 0);
-    col_offsets[i] = (i == 0) ? 0 : col_offsets[i - 1] + col_counts[i - 1];
-  }
+  MPI_Bcast(&width, 1, MPI_INT, 0, GetCommunicator());
+  MPI_Bcast(&height, 1, MPI_INT, 0, GetCommunicator());
+  MPI_Bcast(&channels, 1, MPI_INT, 0, GetCommunicator());
 }
 
 void KondrashovaVGaussFilterVerticalSplitMPI::CopyPixelsToBuffer(const std::vector<uint8_t> &src,
@@ -116,50 +104,6 @@ void KondrashovaVGaussFilterVerticalSplitMPI::CopyPixelsToBuffer(const std::vect
   }
 }
 
-void KondrashovaVGaussFilterVerticalSplitMPI::CopyBufferToOutput(const std::vector<uint8_t> &src,
-                                                                 std::vector<uint8_t> &dst, int src_width,
-                                                                 int dst_width, int height, int channels,
-                                                                 int dst_start_col) {
-  for (int row = 0; row < height; ++row) {
-    for (int col = 0; col < src_width; ++col) {
-      for (int ch = 0; ch < channels; ++ch) {
-        int src_idx = (((row * src_width) + col) * channels) + ch;
-        int dst_idx = (((row * dst_width) + (dst_start_col + col)) * channels) + ch;
-        dst[dst_idx] = src[src_idx];
-      }
-    }
-  }
-}
-
-void KondrashovaVGaussFilterVerticalSplitMPI::DistributeImageData(int rank, int size, int width, int height,
-                                                                  int channels, const std::vector<int> &col_counts,
-                                                                  const std::vector<int> &col_offsets,
-                                                                  std::vector<uint8_t> &local_data, int extended_cols) {
-  local_data.resize(static_cast<size_t>(extended_cols) * height * channels);
-
-  if (rank == 0) {
-    const auto &input_pixels = GetInput().pixels;
-
-    for (int proc = 0; proc < size; ++proc) {
-      int p_start = std::max(0, col_offsets[proc] - 1);
-      int p_end = std::min(width, col_offsets[proc] + col_counts[proc] + 1);
-      int p_cols = p_end - p_start;
-
-      std::vector<uint8_t> send_data(static_cast<size_t>(p_cols) * height * channels);
-      CopyPixelsToBuffer(input_pixels, send_data, width, p_cols, height, channels, p_start);
-
-      if (proc == 0) {
-        local_data = send_data;
-      } else {
-        MPI_Send(send_data.data(), static_cast<int>(send_data.size()), MPI_BYTE, proc, 0, MPI_COMM_WORLD);
-      }
-    }
-  } else {
-    MPI_Status status;
-    MPI_Recv(local_data.data(), static_cast<int>(local_data.size()), MPI_BYTE, 0, 0, MPI_COMM_WORLD, &status);
-  }
-}
-
 void KondrashovaVGaussFilterVerticalSplitMPI::ApplyGaussFilterToLocalData(const std::vector<uint8_t> &local_data,
                                                                           std::vector<uint8_t> &local_result,
                                                                           int extended_cols, int local_cols, int height,
@@ -177,31 +121,9 @@ void KondrashovaVGaussFilterVerticalSplitMPI::ApplyGaussFilterToLocalData(const
   }
 }
 
-void KondrashovaVGaussFilterVerticalSplitMPI::GatherResults(int rank, int size, int width, int height, int channels,
-                                                            const std::vector<int> &col_counts,
-                                                            const std::vector<int> &col_offsets, int local_start_col,
-                                                            int local_cols, const std::vector<uint8_t> &local_result) {
-  if (rank == 0) {
-    auto &output_pixels = GetOutput().pixels;
-
-    CopyBufferToOutput(local_result, output_pixels, local_cols, width, height, channels, local_start_col);
-
-    for (int proc = 1; proc < size; ++proc) {
-      int p_cols = col_counts[proc];
-      std::vector<uint8_t> recv_data(static_cast<size_t>(p_cols) * height * channels);
-      MPI_Status status;
-      MPI_Recv(recv_data.data(), static_cast<int>(recv_data.size()), MPI_BYTE, proc, 1, MPI_COMM_WORLD, &status);
-
-      CopyBufferToOutput(recv_data, output_pixels, p_cols, width, height, channels, col_offsets[proc]);
-    }
-  } else {
-    MPI_Send(local_result.data(), static_cast<int>(local_result.size()), MPI_BYTE, 0, 1, MPI_COMM_WORLD);
-  }
-}
-
 void KondrashovaVGaussFilterVerticalSplitMPI::BroadcastResultToAllProcesses(int width, int height, int channels) {
   int rank = 0;
-  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_rank(GetCommunicator(), &rank);
 
   if (rank != 0) {
     auto &output = GetOutput();
@@ -211,43 +133,55 @@ void KondrashovaVGaussFilterVerticalSplitMPI::BroadcastResultToAllProcesses(int
     output.pixels.resize(static_cast<size_t>(width) * height * channels);
   }
 
-  MPI_Bcast(GetOutput().pixels.data(), static_cast<int>(GetOutput().pixels.size()), MPI_BYTE, 0, MPI_COMM_WORLD);
+  MPI_Bcast(GetOutput().pixels.data(), static_cast<int>(GetOutput().pixels.size()), MPI_BYTE, 0, GetCommunicator());
 }
 
 bool KondrashovaVGaussFilterVerticalSplitMPI::RunImpl() {
   int rank = 0;
   int size = 0;
-  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
-  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  MPI_Comm_rank(GetCommunicator(), &rank);
+  MPI_Comm_size(GetCommunicator(), &size);
+
+  // With the whole image on every rank, each rank copies its column block and halo columns itself
+  const bool replicated = GetInputPlacement() == ppc::task::DataPlacement::kReplicated;
 
   int width = 0;
   int height = 0;
   int channels = 0;
-  BroadcastImageDimensions(width, height, channels);
-
-  std::vector<int> col_counts;
-  std::vector<int> col_offsets;
-  CalculateColumnDistribution(width, size, col_counts, col_offsets);
+  if (replicated) {
+    width = GetInput().width;
+    height = GetInput().height;
+    channels = GetInput().channels;
+  } else {
+    BroadcastImageDimensions(width, height, channels);
+  }
 
-  int local_start_col = col_offsets[rank];
-  int local_cols = col_counts[rank];
+  // Every rank also gets one ghost column on each side of its own columns
+  const auto columns = ppc::util::Partition::Block(width, size);
+  const auto extended = columns.WithHalo(1);
 
-  int extended_start = std::max(0, local_start_col - 1);
-  int extended_end = std::min(width, local_start_col + local_cols + 1);
-  int extended_cols = extended_end - extended_start;
-  int offset_in_extended = local_start_col - extended_start;
+  int local_cols = columns.Count(rank);
+  int extended_start = extended.Offset(rank);
+  int extended_cols = extended.Count(rank);
+  int offset_in_extended = columns.Offset(rank) - extended_start;
 
   std::vector<uint8_t> local_data;
-  DistributeImageData(rank, size, width, height, channels, col_counts, col_offsets, local_data, extended_cols);
+  if (replicated) {
+    local_data.resize(static_cast<size_t>(extended_cols) * height * channels);
+    CopyPixelsToBuffer(GetInput().pixels, local_data, width, extended_cols, height, channels, extended_start);
+  } else {
+    const auto own = ppc::util::ScatterColumns(GetInput().pixels, height, channels, columns, GetCommunicator());
+    local_data = ppc::util::ExchangeColumnHalos(own, height, channels, columns, 1, GetCommunicator());
+  }
 
   std::vector<uint8_t> local_result;
   ApplyGaussFilterToLocalData(local_data, local_result, extended_cols, local_cols, height, channels,
                               offset_in_extended);
 
-  GatherResults(rank, size, width, height, channels, col_counts, col_offsets, local_start_col, local_cols,
-                local_result);
+  ppc::util::GatherColumns(local_result, GetOutput().pixels, height, channels, columns, GetCommunicator());
 
   BroadcastResultToAllProcesses(width, height, channels);
+  SetOutputPlacement(ppc::task::DataPlacement::kReplicated);
 
   return true;
 }
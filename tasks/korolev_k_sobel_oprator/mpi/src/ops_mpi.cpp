@@ -10,6 +10,7 @@
 #include <vector>
 
 #include "korolev_k_sobel_oprator/common/include/common.hpp"
+#include "task/include/task.hpp"
 
 namespace korolev_k_sobel_oprator {
 
@@ -110,7 +111,7 @@ void CopyLocalData(int width, int channels, const std::vector<uint8_t> &all_pixe
 
 // Отправка данных процессу-получателю
 void SendDataToProcess(int dest, int size_z, int width, int channels, int base_rows, int rem_rows,
-                       const std::vector<uint8_t> &all_pixels) {
+                       const std::vector<uint8_t> &all_pixels, MPI_Comm comm) {
   const int dest_start_row = (dest * base_rows) + std::min(dest, rem_rows);
   const int dest_num_rows = base_rows + (dest < rem_rows ? 1 : 0);
   int dest_rows_with_borders = dest_num_rows;
@@ -125,31 +126,31 @@ void SendDataToProcess(int dest, int size_z, int width, int channels, int base_r
   const int send_count = dest_rows_with_borders * width * channels;
   const auto offset = static_cast<ptrdiff_t>(dest_start_row_with_border) * static_cast<ptrdiff_t>(width) *
                       static_cast<ptrdiff_t>(channels);
-  MPI_Send(all_pixels.data() + offset, send_count, MPI_UNSIGNED_CHAR, dest, 0, MPI_COMM_WORLD);
+  MPI_Send(all_pixels.data() + offset, send_count, MPI_UNSIGNED_CHAR, dest, 0, comm);
 }
 
 // Распределение данных по процессам
 void DistributeData(int rank, int size_z, int width, int channels, const std::vector<uint8_t> &all_pixels,
                     std::vector<uint8_t> &local_pixels, int local_start_row_with_border, int local_rows_with_borders,
-                    int base_rows, int rem_rows) {
+                    int base_rows, int rem_rows, MPI_Comm comm) {
   if (rank == 0) {
     // Процесс 0 копирует свои данные
     CopyLocalData(width, channels, all_pixels, local_pixels, local_start_row_with_border, local_rows_with_borders);
 
     // Отправляем данные остальным процессам
     for (int dest = 1; dest < size_z; ++dest) {
-      SendDataToProcess(dest, size_z, width, channels, base_rows, rem_rows, all_pixels);
+      SendDataToProcess(dest, size_z, width, channels, base_rows, rem_rows, all_pixels, comm);
     }
   } else {
     // Принимаем данные от процесса 0
     const int recv_count = local_rows_with_borders * width * channels;
-    MPI_Recv(local_pixels.data(), recv_count, MPI_UNSIGNED_CHAR, 0, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+    MPI_Recv(local_pixels.data(), recv_count, MPI_UNSIGNED_CHAR, 0, 0, comm, MPI_STATUS_IGNORE);
   }
 }
 
 // Сбор результатов от всех процессов
 void GatherResults(int rank, int size_z, int width, int height, int local_num_rows, int base_rows, int rem_rows,
-                   const std::vector<uint8_t> &local_result_clean, std::vector<uint8_t> &output) {
+                   const std::vector<uint8_t> &local_result_clean, std::vector<uint8_t> &output, MPI_Comm comm) {
   if (rank == 0) {
     const auto output_size = static_cast<std::size_t>(width) * static_cast<std::size_t>(height);
     output.resize(output_size);
@@ -168,28 +169,28 @@ void GatherResults(int rank, int size_z, int width, int height, int local_num_ro
       const int src_num_rows = base_rows + (src < rem_rows ? 1 : 0);
       const int recv_count = src_num_rows * width;
       const auto offset = static_cast<ptrdiff_t>(current_row) * static_cast<ptrdiff_t>(width);
-      MPI_Recv(output.data() + offset, recv_count, MPI_UNSIGNED_CHAR, src, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+      MPI_Recv(output.data() + offset, recv_count, MPI_UNSIGNED_CHAR, src, 0, comm, MPI_STATUS_IGNORE);
       current_row += src_num_rows;
     }
   } else {
     // Отправляем результат процессу 0
     const int send_count = local_num_rows * width;
-    MPI_Send(local_result_clean.data(), send_count, MPI_UNSIGNED_CHAR, 0, 0, MPI_COMM_WORLD);
+    MPI_Send(local_result_clean.data(), send_count, MPI_UNSIGNED_CHAR, 0, 0, comm);
   }
 }
 
 // Рассылка результата всем процессам
-void BroadcastResult(int rank, int size_z, int width, int height, std::vector<uint8_t> &output) {
+void BroadcastResult(int rank, int size_z, int width, int height, std::vector<uint8_t> &output, MPI_Comm comm) {
   if (rank == 0) {
     const int total_size = width * height;
     for (int dest = 1; dest < size_z; ++dest) {
-      MPI_Send(output.data(), total_size, MPI_UNSIGNED_CHAR, dest, 1, MPI_COMM_WORLD);
+      MPI_Send(output.data(), total_size, MPI_UNSIGNED_CHAR, dest, 1, comm);
     }
   } else {
     const auto output_size = static_cast<std::size_t>(width) * static_cast<std::size_t>(height);
     output.resize(output_size);
     const int total_size = width * height;
-    MPI_Recv(output.data(), total_size, MPI_UNSIGNED_CHAR, 0, 1, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+    MPI_Recv(output.data(), total_size, MPI_UNSIGNED_CHAR, 0, 1, comm, MPI_STATUS_IGNORE);
   }
 }
 
@@ -222,26 +223,31 @@ bool KorolevKSobelOpratorMPI::PreProcessingImpl() {
 bool KorolevKSobelOpratorMPI::RunImpl() {
   int rank = 0;
   int size = 1;
-  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
-  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  MPI_Comm_rank(GetCommunicator(), &rank);
+  MPI_Comm_size(GetCommunicator(), &size);
+
+  // Реплицированный вход (например, результат предыдущего шага конвейера) не нужно рассылать
+  const bool replicated = GetInputPlacement() == ppc::task::DataPlacement::kReplicated;
 
   int width = 0;
   int height = 0;
   int channels = 0;
-  std::vector<uint8_t> all_pixels;
+  // Пиксели читаются только процессом 0 либо, при реплицированном входе, каждым процессом локально
+  const std::vector<uint8_t> &all_pixels = GetInput().pixels;
 
   // Процесс 0 рассылает размеры изображения
-  if (rank == 0) {
+  if (rank == 0 || replicated) {
     const auto &input = GetInput();
     width = input.width;
     height = input.height;
     channels = input.channels;
-    all_pixels = input.pixels;
   }
 
-  MPI_Bcast(&width, 1, MPI_INT, 0, MPI_COMM_WORLD);
-  MPI_Bcast(&height, 1, MPI_INT, 0, MPI_COMM_WORLD);
-  MPI_Bcast(&channels, 1, MPI_INT, 0, MPI_COMM_WORLD);
+  if (!replicated) {
+    MPI_Bcast(&width, 1, MPI_INT, 0, GetCommunicator());
+    MPI_Bcast(&height, 1, MPI_INT, 0, GetCommunicator());
+    MPI_Bcast(&channels, 1, MPI_INT, 0, GetCommunicator());
+  }
 
   // Если изображение слишком маленькое
   if (width < 3 || height < 3) {
@@ -278,8 +284,12 @@ bool KorolevKSobelOpratorMPI::RunImpl() {
                                  static_cast<std::size_t>(channels);
   std::vector<uint8_t> local_pixels(local_pixels_size);
 
-  DistributeData(rank, size_z, width, channels, all_pixels, local_pixels, local_start_row_with_border,
-                 local_rows_with_borders, base_rows, rem_rows);
+  if (replicated) {
+    CopyLocalData(width, channels, all_pixels, local_pixels, local_start_row_with_border, local_rows_with_borders);
+  } else {
+    DistributeData(rank, size_z, width, channels, all_pixels, local_pixels, local_start_row_with_border,
+                   local_rows_with_borders, base_rows, rem_rows, GetCommunicator());
+  }
 
   // Конвертируем локальный блок в grayscale
   std::vector<uint8_t> local_grayscale = ConvertToGrayscale(local_pixels, width, channels, 0, local_rows_with_borders);
@@ -300,10 +310,12 @@ bool KorolevKSobelOpratorMPI::RunImpl() {
   }
 
   // Собираем результаты в процесс 0
-  GatherResults(rank, size_z, width, height, local_num_rows, base_rows, rem_rows, local_result_clean, GetOutput());
+  GatherResults(rank, size_z, width, height, local_num_rows, base_rows, rem_rows, local_result_clean, GetOutput(),
+                GetCommunicator());
 
   // Рассылаем результат всем процессам
-  BroadcastResult(rank, size_z, width, height, GetOutput());
+  BroadcastResult(rank, size_z, width, height, GetOutput(), GetCommunicator());
+  SetOutputPlacement(ppc::task::DataPlacement::kReplicated);
 
   return true;
 }
@@ -1,44 +1,47 @@
 #include <gtest/gtest.h>
+#include <mpi.h>
 
+#include <cstddef>
 #include <limits>
 #include <tuple>
+#include <utility>
 #include <vector>
 
 #include "olesnitskiy_v_dijkstra_crs/common/include/common.hpp"
 #include "olesnitskiy_v_dijkstra_crs/mpi/include/ops_mpi.hpp"
 #include "olesnitskiy_v_dijkstra_crs/seq/include/ops_seq.hpp"
+#include "util/include/csr_snapshot.hpp"
 #include "util/include/perf_test_util.hpp"
 
 namespace olesnitskiy_v_dijkstra_crs {
 class OlesnitskiyVDijkstraCrsPerfTest : public ppc::util::BaseRunPerfTests<InType, OutType> {
   const int kVertices_ = 1000000;
-  [[nodiscard]] InType GenerateTestGraph() const {
-    std::vector<int> offsets(kVertices_ + 1, 0);
-    std::vector<int> edges;
-    std::vector<int> weights;
-    for (int i = 0; i < kVertices_; ++i) {
-      for (int edge_num = 0; edge_num < 100; ++edge_num) {
-        int j = (i + edge_num * 97) % kVertices_;
-        if (j == i) {
-          j = (j + 1) % kVertices_;
-        }
-        edges.push_back(j);
-        int weight = 1 + ((i + j + edge_num) % 20);
-        weights.push_back(weight);
-        offsets[i + 1]++;
-      }
-    }
-    for (int i = 0; i < kVertices_; ++i) {
-      offsets[i + 1] += offsets[i];
-    }
-    int source = 0;
-    return std::make_tuple(source, offsets, edges, weights);
-  }
 
   InType input_data_;
 
   void SetUp() override {
-    input_data_ = GenerateTestGraph();
+    // 100 edges per vertex with weights 1..20, read from a snapshot that one rank per node generates once
+    const ppc::util::GraphGeneratorOptions options = {.model = ppc::util::GraphModel::kErdosRenyi,
+                                                      .vertices = kVertices_,
+                                                      .edges = 100LL * kVertices_,
+                                                      .min_weight = 1.0,
+                                                      .max_weight = 20.0,
+                                                      .seed = 1,
+                                                      .source = 0,
+                                                      .a = 0.57,
+                                                      .b = 0.19,
+                                                      .c = 0.19};
+    const auto path = ppc::util::PrepareSnapshotPerNode(MPI_COMM_WORLD, [&options] {
+      auto perf_graph = ppc::util::GetPerfGraphSnapshot();
+      if (!perf_graph.has_value()) {
+        perf_graph = ppc::util::CachedGeneratedSnapshot(options);
+      }
+      return perf_graph;
+    });
+    const auto snapshot = ppc::util::CsrSnapshot::Open(*path);
+    std::vector<int> offsets(snapshot.RowPtr().begin(), snapshot.RowPtr().end());
+    std::vector<int> edges(snapshot.ColIdx().begin(), snapshot.ColIdx().end());
+    input_data_ = std::make_tuple(snapshot.Source(), std::move(offsets), std::move(edges), snapshot.CopyWeights<int>());
   }
 
   bool CheckTestOutputData(OutType &output_data) final {
@@ -46,7 +49,8 @@ class OlesnitskiyVDijkstraCrsPerfTest : public ppc::util::BaseRunPerfTests<InTyp
       return true;
     }
     if (!output_data.empty()) {
-      if (output_data[0] != 0) {
+      if (output_data.size() + 1 != std::get<1>(input_data_).size() ||
+          output_data[static_cast<std::size_t>(std::get<0>(input_data_))] != 0) {
         return false;
       }
       for (int dist : output_data) {
@@ -60,7 +64,7 @@ class OlesnitskiyVDijkstraCrsPerfTest : public ppc::util::BaseRunPerfTests<InTyp
           reachable_count++;
         }
       }
-      if (reachable_count < kVertices_ / 2) {
+      if (reachable_count < static_cast<int>(output_data.size() / 2)) {
         return false;
       }
     }
@@ -6,10 +6,13 @@
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <span>
 #include <utility>
 #include <vector>
 
 #include "posternak_a_radix_merge_sort/common/include/common.hpp"
+#include "util/include/partition.hpp"
+#include "util/include/scatter_gather.hpp"
 
 namespace posternak_a_radix_merge_sort {
 
@@ -68,22 +71,6 @@ std::vector<int> PosternakARadixMergeSortMPI::ConvertToSigned(const std::vector<
   return result;
 }
 
-void PosternakARadixMergeSortMPI::CalculateCountsAndOffsets(int input_len, int size, std::vector<int> &counts,
-                                                            std::vector<int> &offset) {
-  const int base = input_len / size;
-  const int extra = input_len % size;
-
-  counts.resize(size);
-  offset.resize(size, 0);
-
-  for (int i = 0; i < size; i++) {
-    counts[i] = base + (i < extra ? 1 : 0);
-    if (i > 0) {
-      offset[i] = offset[i - 1] + counts[i - 1];
-    }
-  }
-}
-
 void PosternakARadixMergeSortMPI::MergeSortedParts(std::vector<int> &result,
                                                    const std::vector<std::vector<int>> &sorted_proc_parts) {
   std::vector<int> tmp;
@@ -101,29 +88,17 @@ bool PosternakARadixMergeSortMPI::RunImpl() {
   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
 
   int input_len = 0;
-  std::vector<int> *input = nullptr;
+  std::span<const int> input;
 
   if (rank == 0) {
-    input = &GetInput();
-    input_len = static_cast<int>(input->size());
+    input = GetInput();
+    input_len = static_cast<int>(input.size());
   }
 
   MPI_Bcast(&input_len, 1, MPI_INT, 0, MPI_COMM_WORLD);
 
-  std::vector<int> counts;
-  std::vector<int> offset;
-  CalculateCountsAndOffsets(input_len, size, counts, offset);
-
-  const int local_size = counts[rank];
-  std::vector<int> input_local(local_size);
-
-  if (rank == 0) {
-    MPI_Scatterv(input->data(), counts.data(), offset.data(), MPI_INT, input_local.data(), local_size, MPI_INT, 0,
-                 MPI_COMM_WORLD);
-  } else {
-    MPI_Scatterv(nullptr, counts.data(), offset.data(), MPI_INT, input_local.data(), local_size, MPI_INT, 0,
-                 MPI_COMM_WORLD);
-  }
+  const auto partition = ppc::util::Partition::Block(input_len, size);
+  std::vector<int> input_local = ppc::util::Scatterv(input, partition, MPI_COMM_WORLD);
 
   std::vector<uint32_t> unsigned_sorted = RadixSortLocal(input_local);
   std::vector<int> local_sorted = ConvertToSigned(unsigned_sorted);
@@ -135,15 +110,16 @@ bool PosternakARadixMergeSortMPI::RunImpl() {
     sorted_proc_parts.push_back(std::move(local_sorted));
 
     for (int proc = 1; proc < size; proc++) {
-      std::vector<int> remote_sorted_proc_part(counts[proc]);
-      MPI_Recv(remote_sorted_proc_part.data(), counts[proc], MPI_INT, proc, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+      std::vector<int> remote_sorted_proc_part(partition.Count(proc));
+      MPI_Recv(remote_sorted_proc_part.data(), partition.Count(proc), MPI_INT, proc, 0, MPI_COMM_WORLD,
+               MPI_STATUS_IGNORE);
       sorted_proc_parts.push_back(std::move(remote_sorted_proc_part));
     }
 
     result = std::move(sorted_proc_parts[0]);
     MergeSortedParts(result, sorted_proc_parts);
   } else {
-    MPI_Send(local_sorted.data(), local_size, MPI_INT, 0, 0, MPI_COMM_WORLD);
+    MPI_Send(local_sorted.data(), partition.Count(rank), MPI_INT, 0, 0, MPI_COMM_WORLD);
   }
 
   std::vector<int> output(input_len);
@@ -12,6 +12,10 @@ class SamoylenkoIConjGradMethodMPI : public BaseTask {
   }
   explicit SamoylenkoIConjGradMethodMPI(const InType &in);
 
+  [[nodiscard]] bool SupportsCommunicator() const override {
+    return true;
+  }
+
  private:
   bool ValidationImpl() override;
   bool PreProcessingImpl() override;
@@ -7,6 +7,8 @@
 #include <vector>
 
 #include "samoylenko_i_conj_grad_method/common/include/common.hpp"
+#include "util/include/partition.hpp"
+#include "util/include/scatter_gather.hpp"
 
 namespace samoylenko_i_conj_grad_method {
 
@@ -18,20 +20,20 @@ SamoylenkoIConjGradMethodMPI::SamoylenkoIConjGradMethodMPI(const InType &in) {
 
 bool SamoylenkoIConjGradMethodMPI::ValidationImpl() {
   int world_rank = 0;
-  MPI_Comm_rank(MPI_COMM_WORLD, &world_rank);
+  MPI_Comm_rank(GetCommunicator(), &world_rank);
 
   int valid = 0;
   if (world_rank == 0) {
     valid = (GetInput().first > 0 && (GetInput().second >= 0 && GetInput().second <= 2) && GetOutput().empty()) ? 1 : 0;
   }
 
-  MPI_Bcast(&valid, 1, MPI_INT, 0, MPI_COMM_WORLD);
+  MPI_Bcast(&valid, 1, MPI_INT, 0, GetCommunicator());
   return valid == 1;
 }
 
 bool SamoylenkoIConjGradMethodMPI::PreProcessingImpl() {
   int world_rank = 0;
-  MPI_Comm_rank(MPI_COMM_WORLD, &world_rank);
+  MPI_Comm_rank(GetCommunicator(), &world_rank);
 
   if (world_rank == 0) {
     GetOutput().clear();
@@ -42,18 +44,6 @@ bool SamoylenkoIConjGradMethodMPI::PreProcessingImpl() {
 
 namespace {
 
-void CalculateDistribution(size_t size, int world_size, std::vector<int> &row_counts, std::vector<int> &row_displs) {
-  int proc_rows = static_cast<int>(size) / world_size;
-  int extra_rows = static_cast<int>(size) % world_size;
-  int disp = 0;
-
-  for (int proc = 0; proc < world_size; ++proc) {
-    row_counts[proc] = proc_rows + (proc < extra_rows ? 1 : 0);
-    row_displs[proc] = disp;
-    disp += row_counts[proc];
-  }
-}
-
 std::vector<double> BuildLocalMatrix(size_t size, int local_rows, int local_start, int variant) {
   std::vector<double> local_matrix(local_rows * size, 0.0);
 
@@ -113,8 +103,8 @@ double LocalDotProduct(int local_rows, const std::vector<double> &local_first,
 }
 
 void ConjugateGradient(size_t size, int local_rows, const std::vector<double> &local_matrix,
-                       const std::vector<double> &local_vector, const std::vector<int> &row_counts,
-                       const std::vector<int> &row_displs, std::vector<double> &local_x) {
+                       const std::vector<double> &local_vector, const ppc::util::Partition &rows,
+                       std::vector<double> &local_x, MPI_Comm comm) {
   const double eps = 1e-7;
   const int iters = 2000;
 
@@ -125,8 +115,7 @@ void ConjugateGradient(size_t size, int local_rows, const std::vector<double> &l
   std::vector<double> x(size);
   std::vector<double> dir(size);
 
-  MPI_Allgatherv(local_x.data(), local_rows, MPI_DOUBLE, x.data(), row_counts.data(), row_displs.data(), MPI_DOUBLE,
-                 MPI_COMM_WORLD);
+  ppc::util::Allgatherv(local_x, x, rows, comm);
   LocalMatrixVectorMult(size, local_rows, local_matrix, x, local_matdir);
 
   for (int i = 0; i < local_rows; ++i) {
@@ -136,20 +125,19 @@ void ConjugateGradient(size_t size, int local_rows, const std::vector<double> &l
 
   double local_res_dot = LocalDotProduct(local_rows, local_res, local_res);
   double res_dot = 0.0;
-  MPI_Allreduce(&local_res_dot, &res_dot, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+  MPI_Allreduce(&local_res_dot, &res_dot, 1, MPI_DOUBLE, MPI_SUM, comm);
 
   for (int it = 0; it < iters; ++it) {
     if (std::sqrt(res_dot) < eps) {
       break;
     }
 
-    MPI_Allgatherv(local_dir.data(), local_rows, MPI_DOUBLE, dir.data(), row_counts.data(), row_displs.data(),
-                   MPI_DOUBLE, MPI_COMM_WORLD);
+    ppc::util::Allgatherv(local_dir, dir, rows, comm);
     LocalMatrixVectorMult(size, local_rows, local_matrix, dir, local_matdir);
 
     double local_dir_dot = LocalDotProduct(local_rows, local_dir, local_matdir);
     double dir_dot = 0.0;
-    MPI_Allreduce(&local_dir_dot, &dir_dot, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+    MPI_Allreduce(&local_dir_dot, &dir_dot, 1, MPI_DOUBLE, MPI_SUM, comm);
 
     if (std::fabs(dir_dot) < 1e-15) {
       break;  // so we dont divide by 0
@@ -164,7 +152,7 @@ void ConjugateGradient(size_t size, int local_rows, const std::vector<double> &l
 
     double local_res_dot_new = LocalDotProduct(local_rows, local_res, local_res);
     double res_dot_new = 0.0;
-    MPI_Allreduce(&local_res_dot_new, &res_dot_new, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+    MPI_Allreduce(&local_res_dot_new, &res_dot_new, 1, MPI_DOUBLE, MPI_SUM, comm);
 
     double conj_coef = res_dot_new / res_dot;
 
@@ -181,8 +169,8 @@ void ConjugateGradient(size_t size, int local_rows, const std::vector<double> &l
 bool SamoylenkoIConjGradMethodMPI::RunImpl() {
   int world_rank = 0;
   int world_size = 0;
-  MPI_Comm_rank(MPI_COMM_WORLD, &world_rank);
-  MPI_Comm_size(MPI_COMM_WORLD, &world_size);
+  MPI_Comm_rank(GetCommunicator(), &world_rank);
+  MPI_Comm_size(GetCommunicator(), &world_size);
 
   int n = 0;
   int variant = 0;
@@ -191,8 +179,8 @@ bool SamoylenkoIConjGradMethodMPI::RunImpl() {
     variant = GetInput().second;
   }
 
-  MPI_Bcast(&n, 1, MPI_INT, 0, MPI_COMM_WORLD);
-  MPI_Bcast(&variant, 1, MPI_INT, 0, MPI_COMM_WORLD);
+  MPI_Bcast(&n, 1, MPI_INT, 0, GetCommunicator());
+  MPI_Bcast(&variant, 1, MPI_INT, 0, GetCommunicator());
 
   if (n <= 0) {
     return false;
@@ -200,12 +188,9 @@ bool SamoylenkoIConjGradMethodMPI::RunImpl() {
 
   auto size = static_cast<size_t>(n);
 
-  std::vector<int> row_counts(world_size);
-  std::vector<int> row_displs(world_size);
-  CalculateDistribution(size, world_size, row_counts, row_displs);
-
-  int local_rows = row_counts[world_rank];
-  int local_start = row_displs[world_rank];
+  const auto rows = ppc::util::Partition::Block(n, world_size);
+  int local_rows = rows.Count(world_rank);
+  int local_start = rows.Offset(world_rank);
 
   std::vector<double> local_matrix = BuildLocalMatrix(size, local_rows, local_start, variant);
   std::vector<double> vector(size);
@@ -215,17 +200,13 @@ bool SamoylenkoIConjGradMethodMPI::RunImpl() {
     }
   }
 
-  std::vector<double> local_vector(local_rows);
-  MPI_Scatterv(vector.data(), row_counts.data(), row_displs.data(), MPI_DOUBLE, local_vector.data(), local_rows,
-               MPI_DOUBLE, 0, MPI_COMM_WORLD);
+  std::vector<double> local_vector = ppc::util::Scatterv(vector, rows, GetCommunicator());
 
   std::vector<double> local_x(local_rows, 0.0);
 
-  ConjugateGradient(size, local_rows, local_matrix, local_vector, row_counts, row_displs, local_x);
+  ConjugateGradient(size, local_rows, local_matrix, local_vector, rows, local_x, GetCommunicator());
 
-  std::vector<double> x(size);
-  MPI_Gatherv(local_x.data(), local_rows, MPI_DOUBLE, x.data(), row_counts.data(), row_displs.data(), MPI_DOUBLE, 0,
-              MPI_COMM_WORLD);
+  std::vector<double> x = ppc::util::Gatherv(local_x, rows, GetCommunicator());
 
   if (world_rank == 0) {
     GetOutput() = x;
@@ -236,7 +217,7 @@ bool SamoylenkoIConjGradMethodMPI::RunImpl() {
 
 bool SamoylenkoIConjGradMethodMPI::PostProcessingImpl() {
   int world_rank = 0;
-  MPI_Comm_rank(MPI_COMM_WORLD, &world_rank);
+  MPI_Comm_rank(GetCommunicator(), &world_rank);
 
   if (world_rank == 0) {
     return !GetOutput().empty();
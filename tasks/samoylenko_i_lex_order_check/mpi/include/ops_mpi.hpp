@@ -5,8 +5,12 @@
 
 namespace samoylenko_i_lex_order_check {
 
+class SamoylenkoILexOrderCheckBatchMPI;
+
 class SamoylenkoILexOrderCheckMPI : public BaseTask {
  public:
+  using BatchTask = SamoylenkoILexOrderCheckBatchMPI;
+
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kMPI;
   }
@@ -20,4 +24,14 @@ class SamoylenkoILexOrderCheckMPI : public BaseTask {
   bool PostProcessingImpl() override;
 };
 
+/// @brief Checks the order of many string pairs with one scatter and one reduction for the whole batch.
+class SamoylenkoILexOrderCheckBatchMPI : public ppc::task::BatchTask<SamoylenkoILexOrderCheckMPI, InType, OutType> {
+ public:
+  using Base = ppc::task::BatchTask<SamoylenkoILexOrderCheckMPI, InType, OutType>;
+  using Base::Base;
+
+ private:
+  bool RunImpl() override;
+};
+
 }  // namespace samoylenko_i_lex_order_check
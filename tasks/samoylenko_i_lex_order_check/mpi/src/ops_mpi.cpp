@@ -6,6 +6,7 @@
 #include <cstddef>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "samoylenko_i_lex_order_check/common/include/common.hpp"
 
@@ -59,6 +60,19 @@ unsigned int FindLocalDifference(const std::string &s1, const std::string &s2, s
   return static_cast<unsigned int>(default_val);
 }
 
+void CalculateBlocks(int total, int size, std::vector<int> &counts, std::vector<int> &displs) {
+  counts.assign(static_cast<std::size_t>(size), total / size);
+  displs.assign(static_cast<std::size_t>(size), 0);
+  for (int proc = 0; proc < size; ++proc) {
+    if (proc < total % size) {
+      counts[proc]++;
+    }
+    if (proc > 0) {
+      displs[proc] = displs[proc - 1] + counts[proc - 1];
+    }
+  }
+}
+
 }  // namespace
 
 SamoylenkoILexOrderCheckMPI::SamoylenkoILexOrderCheckMPI(const InType &in) {
@@ -124,4 +138,81 @@ bool SamoylenkoILexOrderCheckMPI::PostProcessingImpl() {
   return true;
 }
 
+bool SamoylenkoILexOrderCheckBatchMPI::RunImpl() {
+  int rank = 0;
+  int size = 0;
+  MPI_Comm_rank(GetCommunicator(), &rank);
+  MPI_Comm_size(GetCommunicator(), &size);
+
+  // Only the common prefix of a pair can hold its first difference, so the prefixes of all pairs are packed back
+  // to back and split evenly over the ranks
+  std::vector<int> offsets;
+  std::string packed1;
+  std::string packed2;
+  int batch_size = 0;
+  if (rank == 0) {
+    const auto &pairs = GetInput();
+    batch_size = static_cast<int>(pairs.size());
+    offsets.reserve(pairs.size() + 1);
+    for (const auto &[str1, str2] : pairs) {
+      offsets.push_back(static_cast<int>(packed1.size()));
+      const size_t common = std::min(str1.size(), str2.size());
+      packed1.append(str1, 0, common);
+      packed2.append(str2, 0, common);
+    }
+    offsets.push_back(static_cast<int>(packed1.size()));
+  }
+
+  MPI_Bcast(&batch_size, 1, MPI_INT, 0, GetCommunicator());
+  offsets.resize(static_cast<size_t>(batch_size) + 1);
+  MPI_Bcast(offsets.data(), batch_size + 1, MPI_INT, 0, GetCommunicator());
+
+  std::vector<int> send_counts;
+  std::vector<int> displs;
+  CalculateBlocks(offsets.back(), size, send_counts, displs);
+  const int local_count = send_counts[rank];
+  std::string local_str1(static_cast<size_t>(local_count), '\0');
+  std::string local_str2(static_cast<size_t>(local_count), '\0');
+  MPI_Scatterv(packed1.data(), send_counts.data(), displs.data(), MPI_CHAR, local_str1.data(), local_count, MPI_CHAR,
+               0, GetCommunicator());
+  MPI_Scatterv(packed2.data(), send_counts.data(), displs.data(), MPI_CHAR, local_str2.data(), local_count, MPI_CHAR,
+               0, GetCommunicator());
+
+  // First difference of every pair relative to its prefix, the prefix length where this rank saw none
+  std::vector<int> first_diff(static_cast<size_t>(batch_size));
+  for (int pair = 0; pair < batch_size; ++pair) {
+    first_diff[pair] = offsets[pair + 1] - offsets[pair];
+  }
+  const int local_start = displs[rank];
+  auto pair = static_cast<size_t>(std::upper_bound(offsets.begin(), offsets.end(), local_start) - offsets.begin());
+  for (int i = 0; i < local_count; ++i) {
+    while (local_start + i >= offsets[pair]) {
+      pair++;
+    }
+    if (local_str1[i] != local_str2[i]) {
+      first_diff[pair - 1] = std::min(first_diff[pair - 1], local_start + i - offsets[pair - 1]);
+    }
+  }
+  MPI_Allreduce(MPI_IN_PLACE, first_diff.data(), batch_size, MPI_INT, MPI_MIN, GetCommunicator());
+
+  std::vector<int> output(static_cast<size_t>(batch_size), 0);
+  if (rank == 0) {
+    for (int i = 0; i < batch_size; ++i) {
+      const auto &[str1, str2] = GetInput()[i];
+      const int diff = first_diff[i];
+      if (diff == offsets[i + 1] - offsets[i]) {
+        output[i] = (str1.size() <= str2.size()) ? 1 : 0;
+      } else {
+        // Bytes compare as unsigned char, the same order std::string::compare uses
+        output[i] = (static_cast<unsigned char>(str1[diff]) < static_cast<unsigned char>(str2[diff])) ? 1 : 0;
+      }
+    }
+  }
+  MPI_Bcast(output.data(), batch_size, MPI_INT, 0, GetCommunicator());
+  for (int i = 0; i < batch_size; ++i) {
+    GetOutput()[i] = (output[i] != 0);
+  }
+  return true;
+}
+
 }  // namespace samoylenko_i_lex_order_check
@@ -3,6 +3,7 @@
 #include <cstddef>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "samoylenko_i_lex_order_check/common/include/common.hpp"
 #include "samoylenko_i_lex_order_check/mpi/include/ops_mpi.hpp"
@@ -14,6 +15,8 @@ namespace samoylenko_i_lex_order_check {
 class SamoylenkoRunPerfTests : public ppc::util::BaseRunPerfTests<InType, OutType> {
   OutType expected_data_{};
   InType input_data_;
+  std::vector<InType> batch_input_;
+  std::vector<OutType> batch_expected_;
 
   void SetUp() override {
     std::string base_pattern = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
@@ -33,6 +36,28 @@ class SamoylenkoRunPerfTests : public ppc::util::BaseRunPerfTests<InType, OutTyp
 
     input_data_ = std::make_pair(str, str);
     expected_data_ = true;
+
+    // Many short pairs for the batch measurement: equal, differing at some position, or one a prefix of the other
+    const size_t k_num_pairs = 20000;
+    for (size_t i = 0; i < k_num_pairs; ++i) {
+      std::string first = base_pattern.substr(0, 8 + (i % 40));
+      std::string second = first;
+      switch (i % 4) {
+        case 0:
+          break;
+        case 1:
+          second[i % first.size()]++;
+          break;
+        case 2:
+          first[i % first.size()]++;
+          break;
+        default:
+          first += 'x';
+          break;
+      }
+      batch_expected_.push_back(first <= second);
+      batch_input_.emplace_back(std::move(first), std::move(second));
+    }
   }
 
   bool CheckTestOutputData(OutType &output_data) final {
@@ -42,6 +67,14 @@ class SamoylenkoRunPerfTests : public ppc::util::BaseRunPerfTests<InType, OutTyp
   InType GetTestInputData() final {
     return input_data_;
   }
+
+  std::vector<InType> GetBatchInputData() final {
+    return batch_input_;
+  }
+
+  bool CheckBatchOutputData(std::vector<OutType> &outputs) final {
+    return outputs == batch_expected_;
+  }
 };
 
 TEST_P(SamoylenkoRunPerfTests, RunPerfModes) {
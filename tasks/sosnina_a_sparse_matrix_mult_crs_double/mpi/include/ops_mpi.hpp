@@ -1,19 +1,34 @@
 #pragma once
 
+#include <cstdint>
 #include <vector>
 
 #include "sosnina_a_sparse_matrix_mult_crs_double/common/include/common.hpp"
 #include "task/include/task.hpp"
+#include "util/include/spgemm.hpp"
 
 namespace sosnina_a_sparse_matrix_mult_crs_double {
 
+/// @brief How the ranks receive the rows of B they multiply with.
+enum class MatrixBExchange : std::uint8_t {
+  /// Every rank receives all of B
+  kBroadcast,
+  /// Every rank receives only the rows of B named by the columns of its rows of A, which saves memory and traffic
+  /// when A is sparse enough that a rank touches a small part of B
+  kReferencedRows
+};
+
 class SosninaAMatrixMultCRSMPI : public BaseTask {
  public:
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kMPI;
   }
 
-  explicit SosninaAMatrixMultCRSMPI(const InType &in);
+  explicit SosninaAMatrixMultCRSMPI(const InType &in, MatrixBExchange b_exchange = MatrixBExchange::kReferencedRows);
+
+  [[nodiscard]] bool SupportsCommunicator() const override {
+    return true;
+  }
 
  private:
   bool ValidationImpl() override;
@@ -26,27 +41,9 @@ class SosninaAMatrixMultCRSMPI : public BaseTask {
 
   void BroadcastMatrixB();
 
-  void DistributeMatrixAData();
-  void SendMatrixADataToProcess(int dest);
-  void ReceiveMatrixAData();
-
-  void ComputeLocalMultiplication();
-  void ProcessRowForSequential(int row_idx, std::vector<double> &row_values, std::vector<int> &row_cols);
-  void ProcessLocalRow(int local_idx, std::vector<double> &row_values, std::vector<int> &row_cols);
-  void MultiplyRowByMatrixB(int row_start, int row_end, std::vector<double> &temp_row);
-  void ProcessElementA(int k_idx, std::vector<double> &temp_row);
-  void MultiplyByRowB(int k, double a_val, std::vector<double> &temp_row);
-  static void CollectNonZeroElements(const std::vector<double> &temp_row, int n_cols_b, std::vector<double> &row_values,
-                                     std::vector<int> &row_cols);
-  static void SortRowElements(std::vector<double> &row_values, std::vector<int> &row_cols);
-
-  void GatherResults();
-  void ProcessLocalResults(std::vector<std::vector<double>> &row_values, std::vector<std::vector<int>> &row_cols);
-  static void ReceiveResultsFromProcess(int src, std::vector<std::vector<double>> &row_values,
-                                        std::vector<std::vector<int>> &row_cols);
-  void CollectAllResults(std::vector<std::vector<double>> &row_values, std::vector<std::vector<int>> &row_cols);
-  static void SortAndPackRow(int row_idx, std::vector<std::vector<double>> &row_values,
-                             std::vector<std::vector<int>> &row_cols);
+  [[nodiscard]] ppc::util::CsrView<double> MatrixA() const;
+  [[nodiscard]] ppc::util::CsrView<double> MatrixB() const;
+  void SetResult(const ppc::util::CsrMatrix<double> &c);
 
   std::vector<double> values_A_;
   std::vector<int> col_indices_A_;
@@ -59,17 +56,7 @@ class SosninaAMatrixMultCRSMPI : public BaseTask {
   std::vector<int> row_ptr_B_;
   int n_cols_B_;
 
-  std::vector<double> values_C_;
-  std::vector<int> col_indices_C_;
-  std::vector<int> row_ptr_C_;
-
-  std::vector<int> local_rows_;
-  std::vector<double> local_values_A_;
-  std::vector<int> local_col_indices_A_;
-  std::vector<int> local_row_ptr_A_;
-  std::vector<double> local_values_C_;
-  std::vector<int> local_col_indices_C_;
-  std::vector<int> local_row_ptr_C_;
+  MatrixBExchange b_exchange_;
 
   int rank_ = 0;
   int world_size_ = 1;
@@ -5,6 +5,7 @@
 #include <array>
 #include <cmath>
 #include <cstddef>
+#include <memory>
 #include <ranges>
 #include <string>
 #include <tuple>
@@ -484,11 +485,27 @@ const std::array<TestType, 19> kCoverageTests = {
                     std::vector<std::vector<double>>{{1.0, 2.0}, {3.0, 4.0}, {5.0, 6.0}},
                     std::vector<std::vector<double>>{{1.1, 1.4}, {0.9, 1.2}, {2.9, 3.8}})};
 
+// The MPI task once more with every rank receiving all of B instead of its referenced rows
+std::shared_ptr<SosninaAMatrixMultCRSMPI> BroadcastBTaskGetter(InType in) {
+  return std::make_shared<SosninaAMatrixMultCRSMPI>(in, MatrixBExchange::kBroadcast);
+}
+
+template <std::size_t... Is>
+auto BroadcastBTasks(std::index_sequence<Is...> /*unused*/) {
+  const std::string name =
+      std::string(ppc::util::GetNamespace<SosninaAMatrixMultCRSMPI>()) + "_" +
+      ppc::task::GetStringTaskType(SosninaAMatrixMultCRSMPI::GetStaticTypeOfTask(),
+                                   PPC_SETTINGS_sosnina_a_sparse_matrix_mult_crs_double) +
+      "_broadcast_b";
+  return std::make_tuple(std::make_tuple(BroadcastBTaskGetter, name, kFunctionalTests[Is])...);
+}
+
 const auto kFunctionalTasksList =
     std::tuple_cat(ppc::util::AddFuncTask<sosnina_a_sparse_matrix_mult_crs_double::SosninaAMatrixMultCRSMPI, InType>(
                        kFunctionalTests, PPC_SETTINGS_sosnina_a_sparse_matrix_mult_crs_double),
                    ppc::util::AddFuncTask<sosnina_a_sparse_matrix_mult_crs_double::SosninaAMatrixMultCRSSEQ, InType>(
-                       kFunctionalTests, PPC_SETTINGS_sosnina_a_sparse_matrix_mult_crs_double));
+                       kFunctionalTests, PPC_SETTINGS_sosnina_a_sparse_matrix_mult_crs_double),
+                   BroadcastBTasks(std::make_index_sequence<kFunctionalTests.size()>{}));
 
 const auto kCoverageTasksList =
     std::tuple_cat(ppc::util::AddFuncTask<sosnina_a_sparse_matrix_mult_crs_double::SosninaAMatrixMultCRSMPI, InType>(
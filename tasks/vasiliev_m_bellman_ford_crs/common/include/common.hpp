@@ -1,5 +1,6 @@
 #pragma once
 
+#include <limits>
 #include <string>
 #include <tuple>
 #include <vector>
@@ -17,6 +18,10 @@ struct CRSGraph {
   int source = 0;
 };
 
+/// @brief Every distance of the output when a negative cycle is reachable from the source: paths through the cycle
+///        get arbitrarily short, so the graph has no shortest-path tree.
+inline constexpr WeightType kNegativeCycle = std::numeric_limits<WeightType>::min();
+
 using InType = CRSGraph;
 using OutType = std::vector<WeightType>;
 using TestType = std::tuple<int, std::string>;
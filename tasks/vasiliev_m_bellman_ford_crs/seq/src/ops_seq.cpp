@@ -7,6 +7,35 @@
 
 namespace vasiliev_m_bellman_ford_crs {
 
+namespace {
+
+/// @brief One Bellman-Ford round over every edge; returns whether a distance improved.
+bool RelaxAllEdges(const CRSGraph &graph, std::vector<WeightType> &dist) {
+  const int vertices = static_cast<int>(graph.row_ptr.size()) - 1;
+  const int inf = std::numeric_limits<int>::max();
+  bool updated = false;
+
+  for (int vertex = 0; vertex < vertices; vertex++) {
+    if (dist[vertex] == inf) {
+      continue;
+    }
+
+    for (int edge = graph.row_ptr[vertex]; edge < graph.row_ptr[vertex + 1]; edge++) {
+      int v = graph.col_ind[edge];
+      int w = graph.vals[edge];
+
+      if (dist[v] > dist[vertex] + w) {
+        dist[v] = dist[vertex] + w;
+        updated = true;
+      }
+    }
+  }
+
+  return updated;
+}
+
+}  // namespace
+
 VasilievMBellmanFordCrsSEQ::VasilievMBellmanFordCrsSEQ(const InType &in) {
   SetTypeOfTask(GetStaticTypeOfTask());
   GetInput() = in;
@@ -52,30 +81,15 @@ bool VasilievMBellmanFordCrsSEQ::RunImpl() {
   auto &dist = GetOutput();
 
   const int vertices = static_cast<int>(in.row_ptr.size()) - 1;
-  const int inf = std::numeric_limits<int>::max();
-
-  for (int i = 0; i < vertices - 1; i++) {
-    bool updated = false;
-
-    for (int vertex = 0; vertex < vertices; vertex++) {
-      if (dist[vertex] == inf) {
-        continue;
-      }
 
-      for (int edge = in.row_ptr[vertex]; edge < in.row_ptr[vertex + 1]; edge++) {
-        int v = in.col_ind[edge];
-        int w = in.vals[edge];
-
-        if (dist[v] > dist[vertex] + w) {
-          dist[v] = dist[vertex] + w;
-          updated = true;
-        }
-      }
-    }
+  bool updated = true;
+  for (int i = 0; i < vertices - 1 && updated; i++) {
+    updated = RelaxAllEdges(in, dist);
+  }
 
-    if (!updated) {
-      break;
-    }
+  // Distances are final after V - 1 rounds unless the source reaches a negative cycle
+  if (updated && RelaxAllEdges(in, dist)) {
+    dist.assign(dist.size(), kNegativeCycle);
   }
 
   return true;
@@ -100,8 +100,10 @@ TEST_P(VasilievMBellmanFordCrsFuncTests, MatmulFromPic) {
   ExecuteTest(GetParam());
 }
 
-const std::array<TestType, 4> kTestParam = {TestType{0, "tree_func_test0.txt"}, TestType{1, "tree_func_test1.txt"},
-                                            TestType{2, "tree_func_test2.txt"}, TestType{3, "tree_func_test3.txt"}};
+// Test 4 reaches a negative cycle, so every distance is kNegativeCycle; test 5 has one the source cannot reach
+const std::array<TestType, 6> kTestParam = {TestType{0, "tree_func_test0.txt"}, TestType{1, "tree_func_test1.txt"},
+                                            TestType{2, "tree_func_test2.txt"}, TestType{3, "tree_func_test3.txt"},
+                                            TestType{4, "tree_func_test4.txt"}, TestType{5, "tree_func_test5.txt"}};
 
 const auto kTestTasksList = std::tuple_cat(
     ppc::util::AddFuncTask<VasilievMBellmanFordCrsMPI, InType>(kTestParam, PPC_SETTINGS_vasiliev_m_bellman_ford_crs),
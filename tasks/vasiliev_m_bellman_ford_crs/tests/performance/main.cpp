@@ -1,14 +1,11 @@
 #include <gtest/gtest.h>
+#include <mpi.h>
 
-#include <cctype>
-#include <fstream>
-#include <stdexcept>
-#include <string>
-#include <tuple>
-#include <vector>
+#include <algorithm>
+#include <cstddef>
 
+#include "util/include/csr_snapshot.hpp"
 #include "util/include/perf_test_util.hpp"
-#include "util/include/util.hpp"
 #include "vasiliev_m_bellman_ford_crs/common/include/common.hpp"
 #include "vasiliev_m_bellman_ford_crs/mpi/include/ops_mpi.hpp"
 #include "vasiliev_m_bellman_ford_crs/seq/include/ops_seq.hpp"
@@ -17,50 +14,36 @@ namespace vasiliev_m_bellman_ford_crs {
 
 class VasilievMBellmanFordCrsPerfTests : public ppc::util::BaseRunPerfTests<InType, OutType> {
   void SetUp() override {
-    std::ifstream file(ppc::util::GetAbsoluteTaskPath(PPC_ID_vasiliev_m_bellman_ford_crs, "tree_perf_test.txt"));
-
-    if (!file.is_open()) {
-      throw std::runtime_error("Cannot open perf test file");
-    }
-
-    int num_vertices = 0;
-    int num_edges = 0;
-    file >> num_vertices >> num_edges;
-
-    std::vector<std::tuple<int, int, int>> edges(num_edges);
-    for (int i = 0; i < num_edges; i++) {
-      file >> std::get<0>(edges[i]) >> std::get<1>(edges[i]) >> std::get<2>(edges[i]);
-    }
-
-    int source = 0;
-    file >> source;
-
-    input_data_.row_ptr.assign(num_vertices + 1, 0);
-    for (const auto &e : edges) {
-      input_data_.row_ptr[std::get<0>(e) + 1]++;
-    }
-
-    for (int i = 1; i <= num_vertices; i++) {
-      input_data_.row_ptr[i] += input_data_.row_ptr[i - 1];
-    }
-
-    input_data_.col_ind.resize(num_edges);
-    input_data_.vals.resize(num_edges);
-
-    std::vector<int> counter = input_data_.row_ptr;
-    for (const auto &e : edges) {
-      int u = std::get<0>(e);
-      int idx = counter[u]++;
-      input_data_.col_ind[idx] = std::get<1>(e);
-      input_data_.vals[idx] = std::get<2>(e);
-    }
-
-    input_data_.source = source;
+    // Nonnegative weights, so SEQ and MPI both run every round instead of stopping at a negative cycle
+    const ppc::util::GraphGeneratorOptions options = {.model = ppc::util::GraphModel::kErdosRenyi,
+                                                      .vertices = 10000,
+                                                      .edges = 50000,
+                                                      .min_weight = 1.0,
+                                                      .max_weight = 100.0,
+                                                      .seed = 1,
+                                                      .source = 0,
+                                                      .a = 0.57,
+                                                      .b = 0.19,
+                                                      .c = 0.19};
+    // One rank per node writes the cached snapshot, the others open it once it is there
+    const auto path = ppc::util::PrepareSnapshotPerNode(MPI_COMM_WORLD, [&options] {
+      auto perf_graph = ppc::util::GetPerfGraphSnapshot();
+      if (!perf_graph.has_value()) {
+        perf_graph = ppc::util::CachedGeneratedSnapshot(options);
+      }
+      return perf_graph;
+    });
+    const auto snapshot = ppc::util::CsrSnapshot::Open(*path);
+    input_data_.row_ptr.assign(snapshot.RowPtr().begin(), snapshot.RowPtr().end());
+    input_data_.col_ind.assign(snapshot.ColIdx().begin(), snapshot.ColIdx().end());
+    input_data_.vals = snapshot.CopyWeights<WeightType>();
+    input_data_.source = snapshot.Source();
   }
 
   bool CheckTestOutputData(OutType &output_data) final {
-    (void)output_data;
-    return true;
+    return output_data.size() + 1 == input_data_.row_ptr.size() &&
+           output_data[static_cast<std::size_t>(input_data_.source)] == 0 &&
+           std::ranges::none_of(output_data, [](WeightType dist) { return dist == kNegativeCycle; });
   }
 
   InType GetTestInputData() final {
@@ -2,9 +2,11 @@
 
 #include <string>
 #include <tuple>
+#include <utility>
 #include <vector>
 
 #include "task/include/task.hpp"
+#include "util/include/spgemm.hpp"
 
 namespace yakimov_i_multiplication_of_sparse_matrices_crs_storage_format {
 
@@ -23,4 +25,22 @@ struct MatrixCRS {
   MatrixCRS() = default;
 };
 
+/// @brief Product of two CRS matrices with the columns of every row sorted and exact zeros dropped.
+/// @throws std::runtime_error If a has rows and its columns do not match the rows of b.
+inline MatrixCRS MultiplyMatrices(const MatrixCRS &a, const MatrixCRS &b) {
+  const ppc::util::CsrView<double> a_view{
+      .cols = a.cols, .row_ptr = a.row_pointers, .col_idx = a.col_indices, .values = a.values};
+  const ppc::util::CsrView<double> b_view{
+      .cols = b.cols, .row_ptr = b.row_pointers, .col_idx = b.col_indices, .values = b.values};
+  auto product = ppc::util::SpGemm<double>().Multiply(a_view, b_view);
+
+  MatrixCRS result;
+  result.rows = product.rows;
+  result.cols = product.cols;
+  result.row_pointers = std::move(product.row_ptr);
+  result.col_indices = std::move(product.col_idx);
+  result.values = std::move(product.values);
+  return result;
+}
+
 }  // namespace yakimov_i_multiplication_of_sparse_matrices_crs_storage_format
@@ -8,6 +8,7 @@
 #include <cstring>
 #include <fstream>
 #include <iostream>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -68,60 +69,6 @@ bool ReadMatrixFromFileImpl(const std::string &filename, MatrixCRS &matrix) {
   return success;
 }
 
-void ProcessRowMultiplication(const MatrixCRS &a, const MatrixCRS &b, int row_index, std::vector<double> &row_values) {
-  std::ranges::fill(row_values, 0.0);
-
-  int row_start_a = a.row_pointers[static_cast<size_t>(row_index)];
-  int row_end_a = a.row_pointers[static_cast<size_t>(row_index) + 1];
-
-  for (int k = row_start_a; k < row_end_a; ++k) {
-    int col_a = a.col_indices[static_cast<size_t>(k)];
-    double val_a = a.values[static_cast<size_t>(k)];
-
-    int row_start_b = b.row_pointers[static_cast<size_t>(col_a)];
-    int row_end_b = b.row_pointers[static_cast<size_t>(col_a) + 1];
-
-    for (int idx = row_start_b; idx < row_end_b; ++idx) {
-      int col_b = b.col_indices[static_cast<size_t>(idx)];
-      double val_b = b.values[static_cast<size_t>(idx)];
-      row_values[static_cast<size_t>(col_b)] += val_a * val_b;
-    }
-  }
-}
-
-void CollectRowResult(const std::vector<double> &row_values, MatrixCRS &result, int row_index) {
-  for (size_t j = 0; j < row_values.size(); ++j) {
-    if (row_values[j] != 0.0) {
-      result.values.push_back(row_values[j]);
-      result.col_indices.push_back(static_cast<int>(j));
-    }
-  }
-
-  result.row_pointers[static_cast<size_t>(row_index) + 1] = static_cast<int>(result.values.size());
-}
-
-MatrixCRS MultiplyMatricesImpl(const MatrixCRS &a, const MatrixCRS &b) {
-  MatrixCRS result;
-  result.rows = a.rows;
-  result.cols = b.cols;
-  result.row_pointers.resize(static_cast<size_t>(result.rows) + 1);
-
-  if (result.row_pointers.empty()) {
-    return result;
-  }
-
-  result.row_pointers[0] = 0;
-
-  std::vector<double> row_values(static_cast<size_t>(result.cols), 0.0);
-
-  for (int i = 0; i < a.rows; ++i) {
-    ProcessRowMultiplication(a, b, i, row_values);
-    CollectRowResult(row_values, result, i);
-  }
-
-  return result;
-}
-
 double SumMatrixElementsImpl(const MatrixCRS &matrix) {
   double sum = 0.0;
 
@@ -521,6 +468,7 @@ void YakimovIMultiplicationOfSparseMatricesMPI::DistributeMatrixA() {
     InitializeLocalRowsOnMaster(rank, size, matrix_A_, local_a_rows_, local_rows_);
   } else {
     ReceiveMatrixDataFromMaster(rank, size, local_a_rows_, local_rows_, rows_A_);
+    local_a_rows_.cols = cols_A_;
   }
 }
 
@@ -546,10 +494,12 @@ void YakimovIMultiplicationOfSparseMatricesMPI::DistributeMatrixB() {
     int total_nnz = 0;
     MPI_Bcast(&total_nnz, 1, MPI_INT, 0, MPI_COMM_WORLD);
 
+    // An all-zero B still needs its shape and empty rows for the local product
+    matrix_B_.rows = rows_B_;
+    matrix_B_.cols = cols_B_;
+    matrix_B_.row_pointers.assign(static_cast<size_t>(matrix_B_.rows) + 1, 0);
+
     if (total_nnz > 0) {
-      matrix_B_.rows = rows_B_;
-      matrix_B_.cols = cols_B_;
-      matrix_B_.row_pointers.resize(static_cast<size_t>(matrix_B_.rows) + 1);
       matrix_B_.col_indices.resize(static_cast<size_t>(total_nnz));
       matrix_B_.values.resize(static_cast<size_t>(total_nnz));
 
@@ -601,8 +551,18 @@ bool YakimovIMultiplicationOfSparseMatricesMPI::RunImpl() {
   DistributeMatrixB();
   MPI_Barrier(MPI_COMM_WORLD);
 
-  local_result_ = MultiplyMatricesImpl(local_a_rows_, matrix_B_);
-  MPI_Barrier(MPI_COMM_WORLD);
+  int local_ok = 1;
+  try {
+    local_result_ = MultiplyMatrices(local_a_rows_, matrix_B_);
+  } catch (const std::runtime_error &) {
+    local_ok = 0;
+  }
+  // Ranks without rows of A never see a mismatch, so every rank learns whether any of them failed
+  int all_ok = 0;
+  MPI_Allreduce(&local_ok, &all_ok, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+  if (all_ok == 0) {
+    return false;
+  }
 
   GatherResults();
 
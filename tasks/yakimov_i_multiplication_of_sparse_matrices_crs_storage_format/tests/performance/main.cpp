@@ -1,9 +1,18 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <array>
 #include <cmath>
 #include <cstddef>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
 
+#include "performance/include/performance.hpp"
+#include "task/include/task.hpp"
 #include "util/include/perf_test_util.hpp"
 #include "yakimov_i_multiplication_of_sparse_matrices_crs_storage_format/common/include/common.hpp"
 #include "yakimov_i_multiplication_of_sparse_matrices_crs_storage_format/mpi/include/ops_mpi.hpp"
@@ -40,4 +49,144 @@ const auto kPerfTestName = YakimovIMultiplicationOfSparseMatricesPerfTests::Cust
 
 INSTANTIATE_TEST_SUITE_P(RunModeTests, YakimovIMultiplicationOfSparseMatricesPerfTests, kGtestValues, kPerfTestName);
 
+namespace {
+
+/// @brief Factors of a generated product, too wide to ship as data files.
+struct MatrixPair {
+  MatrixCRS a;
+  MatrixCRS b;
+};
+
+/// @brief Times MultiplyMatrices(), the kernel behind both task classes, on a product with 10^6 columns.
+/// @details The task classes read fixed data files of a few thousand columns, where a per-row sweep over the
+///          columns still looks cheap.
+class MillionColumnsProductSEQ : public ppc::task::Task<MatrixPair, double> {
+ public:
+  static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
+    return ppc::task::TypeOfTask::kSEQ;
+  }
+
+  explicit MillionColumnsProductSEQ(const MatrixPair &in) {
+    SetTypeOfTask(GetStaticTypeOfTask());
+    GetInput() = in;
+    GetOutput() = 0.0;
+  }
+
+ private:
+  bool ValidationImpl() override {
+    return GetInput().a.cols == GetInput().b.rows;
+  }
+  bool PreProcessingImpl() override {
+    return true;
+  }
+  bool RunImpl() override {
+    try {
+      product_ = MultiplyMatrices(GetInput().a, GetInput().b);
+    } catch (const std::runtime_error &) {
+      return false;
+    }
+    return true;
+  }
+  bool PostProcessingImpl() override {
+    GetOutput() = 0.0;
+    for (double value : product_.values) {
+      GetOutput() += value;
+    }
+    return true;
+  }
+
+  MatrixCRS product_;
+};
+
+/// @brief Matrix with nonzeros_per_row distinct sorted columns in every row.
+MatrixCRS MakeRandomMatrix(int rows, int cols, int nonzeros_per_row, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<int> col(0, cols - 1);
+  std::uniform_real_distribution<double> value(-1.0, 1.0);
+  MatrixCRS matrix;
+  matrix.rows = rows;
+  matrix.cols = cols;
+  matrix.row_pointers.push_back(0);
+  std::vector<int> row_cols;
+  for (int row = 0; row < rows; row++) {
+    row_cols.clear();
+    while (static_cast<int>(row_cols.size()) < nonzeros_per_row) {
+      const int c = col(gen);
+      if (std::ranges::find(row_cols, c) == row_cols.end()) {
+        row_cols.push_back(c);
+      }
+    }
+    std::ranges::sort(row_cols);
+    for (int c : row_cols) {
+      matrix.col_indices.push_back(c);
+      matrix.values.push_back(value(gen));
+    }
+    matrix.row_pointers.push_back(static_cast<int>(matrix.col_indices.size()));
+  }
+  return matrix;
+}
+
+/// @brief Sum of all entries of a * b computed without forming it: the column sums of a dotted with the row sums
+///        of b.
+/// @return The sum and the sum of the magnitudes of its terms, the scale of its rounding error.
+std::pair<double, double> ProductSum(const MatrixPair &input) {
+  std::vector<double> a_col_sums(static_cast<std::size_t>(input.a.cols), 0.0);
+  for (std::size_t i = 0; i < input.a.values.size(); i++) {
+    a_col_sums[static_cast<std::size_t>(input.a.col_indices[i])] += input.a.values[i];
+  }
+  double sum = 0.0;
+  double scale = 0.0;
+  for (int row = 0; row < input.b.rows; row++) {
+    double b_row_sum = 0.0;
+    for (int k = input.b.row_pointers[row]; k < input.b.row_pointers[row + 1]; k++) {
+      b_row_sum += input.b.values[static_cast<std::size_t>(k)];
+    }
+    const double term = a_col_sums[static_cast<std::size_t>(row)] * b_row_sum;
+    sum += term;
+    scale += std::abs(term);
+  }
+  return {sum, scale};
+}
+
+class YakimovIMillionColumnsPerfTests : public ppc::util::BaseRunPerfTests<MatrixPair, double> {
+ protected:
+  bool CheckTestOutputData(double &output_data) final {
+    static const auto [kExpected, kScale] = ProductSum(Input());
+    return std::abs(output_data - kExpected) <= 1e-9 * std::max(kScale, 1.0);
+  }
+
+  MatrixPair GetTestInputData() final {
+    return Input();
+  }
+
+ private:
+  static const MatrixPair &Input() {
+    constexpr int kCols = 1'000'000;
+    static const MatrixPair kInput{.a = MakeRandomMatrix(20'000, kCols, 5, 1),
+                                   .b = MakeRandomMatrix(kCols, kCols, 2, 2)};
+    return kInput;
+  }
+};
+
+TEST_P(YakimovIMillionColumnsPerfTests, RunPerfModes) {
+  ExecuteTest(GetParam());
+}
+
+const std::string kMillionColumnsName =
+    std::string(ppc::util::GetNamespace<YakimovIMultiplicationOfSparseMatricesSEQ>()) + "_" +
+    ppc::task::GetStringTaskType(MillionColumnsProductSEQ::GetStaticTypeOfTask(),
+                                 PPC_SETTINGS_yakimov_i_multiplication_of_sparse_matrices_crs_storage_format) +
+    "_million_columns";
+
+const auto kMillionColumnsValues = ::testing::Values(
+    std::make_tuple(ppc::task::TaskGetter<MillionColumnsProductSEQ, MatrixPair>, kMillionColumnsName,
+                    ppc::performance::PerfResults::TypeOfRunning::kPipeline),
+    std::make_tuple(ppc::task::TaskGetter<MillionColumnsProductSEQ, MatrixPair>, kMillionColumnsName,
+                    ppc::performance::PerfResults::TypeOfRunning::kTaskRun));
+
+INSTANTIATE_TEST_SUITE_P(MillionColumnsTests, YakimovIMillionColumnsPerfTests, kMillionColumnsValues,
+                         YakimovIMillionColumnsPerfTests::CustomPerfTestName);
+
+}  // namespace
+
 }  // namespace yakimov_i_multiplication_of_sparse_matrices_crs_storage_format
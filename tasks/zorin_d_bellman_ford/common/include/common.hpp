@@ -28,6 +28,8 @@ using TestType = std::tuple<int, std::string>;
 using BaseTask = ppc::task::Task<InType, OutType>;
 
 constexpr std::int64_t kInf = std::numeric_limits<std::int64_t>::max() / 4;
+/// @brief Fills the whole output when the source reaches a negative cycle, which leaves no shortest paths to report.
+constexpr std::int64_t kNegativeCycle = std::numeric_limits<std::int64_t>::min();
 
 inline GraphCrs MakeGraphCrsDeterministic(int vertex_count, int edges_per_vertex) {
   GraphCrs graph;
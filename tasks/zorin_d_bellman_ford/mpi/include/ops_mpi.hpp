@@ -1,8 +1,5 @@
 #pragma once
 
-#include <cstdint>
-#include <vector>
-
 #include "task/include/task.hpp"
 #include "zorin_d_bellman_ford/common/include/common.hpp"
 
@@ -21,8 +18,6 @@ class ZorinDBellmanFordMPI : public BaseTask {
   bool PreProcessingImpl() override;
   bool RunImpl() override;
   bool PostProcessingImpl() override;
-  static bool RelaxIteration(int rank, int size, const GraphCrs &graph, const std::vector<std::int64_t> &dist,
-                             std::vector<std::int64_t> &dist_next);
 };
 
 }  // namespace zorin_d_bellman_ford
@@ -5,9 +5,12 @@
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
-#include <utility>
-#include <vector>
+#include <span>
 
+#include "util/include/bellman_ford.hpp"
+#include "util/include/local_csr.hpp"
+#include "util/include/partition.hpp"
+#include "util/include/scatter_gather.hpp"
 #include "zorin_d_bellman_ford/common/include/common.hpp"
 
 namespace zorin_d_bellman_ford {
@@ -54,32 +57,6 @@ bool ZorinDBellmanFordMPI::PreProcessingImpl() {
   return true;
 }
 
-bool ZorinDBellmanFordMPI::RelaxIteration(int rank, int size, const GraphCrs &graph,
-                                          const std::vector<std::int64_t> &dist, std::vector<std::int64_t> &dist_next) {
-  bool updated = false;
-  const int vertex_count = graph.vertex_count;
-
-  for (int vertex = rank; vertex < vertex_count; vertex += size) {
-    const std::int64_t du = dist[static_cast<std::size_t>(vertex)];
-    if (du >= kInf / 2) {
-      continue;
-    }
-
-    const int begin = graph.row_ptr[static_cast<std::size_t>(vertex)];
-    const int end = graph.row_ptr[static_cast<std::size_t>(vertex) + 1];
-
-    for (int edge = begin; edge < end; ++edge) {
-      const int to = graph.col_idx[static_cast<std::size_t>(edge)];
-      const std::int64_t cand = du + static_cast<std::int64_t>(graph.weights[static_cast<std::size_t>(edge)]);
-      if (cand < dist_next[static_cast<std::size_t>(to)]) {
-        dist_next[static_cast<std::size_t>(to)] = cand;
-        updated = true;
-      }
-    }
-  }
-  return updated;
-}
-
 bool ZorinDBellmanFordMPI::RunImpl() {
   int rank = 0;
   int size = 0;
@@ -87,27 +64,19 @@ bool ZorinDBellmanFordMPI::RunImpl() {
   MPI_Comm_size(MPI_COMM_WORLD, &size);
 
   const auto &graph = GetInput().graph;
-  const int vertex_count = graph.vertex_count;
-
-  std::vector<std::int64_t> dist = GetOutput();
-  std::vector<std::int64_t> dist_next(dist);
-
-  for (int iter = 0; iter < vertex_count - 1; ++iter) {
-    dist_next = dist;
-
-    const bool local_updated = RelaxIteration(rank, size, graph, dist, dist_next);
-
-    MPI_Allreduce(dist_next.data(), dist.data(), vertex_count, MPI_LONG, MPI_MIN, MPI_COMM_WORLD);
-
-    int updated = local_updated ? 1 : 0;
-    MPI_Allreduce(MPI_IN_PLACE, &updated, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
-
-    if (updated == 0) {
-      break;
-    }
+  const auto vertices = ppc::util::Partition::Block(graph.vertex_count, size);
+  const ppc::util::LocalCsr<int> local{
+      .offsets = std::span<const int>(graph.row_ptr).subspan(vertices.Offset(rank), vertices.Count(rank) + 1),
+      .columns = graph.col_idx,
+      .weights = graph.weights};
+
+  ppc::util::FrontierBellmanFord<int, std::int64_t> bellman_ford(local, vertices, MPI_COMM_WORLD);
+  const auto result = bellman_ford.Run(GetInput().source, kInf);
+  if (result.has_negative_cycle) {
+    std::ranges::fill(GetOutput(), kNegativeCycle);
+    return true;
   }
-
-  GetOutput() = std::move(dist);
+  ppc::util::Allgatherv(result.local_dist, std::span<std::int64_t>(GetOutput()), vertices, MPI_COMM_WORLD);
   return true;
 }
 
@@ -7,6 +7,33 @@
 
 namespace zorin_d_bellman_ford {
 
+namespace {
+
+bool RelaxEdges(const GraphCrs &graph, OutType &dist) {
+  bool updated = false;
+  for (int vertex = 0; vertex < graph.vertex_count; ++vertex) {
+    const std::int64_t du = dist[static_cast<std::size_t>(vertex)];
+    if (du >= kInf / 2) {
+      continue;
+    }
+
+    const int begin = graph.row_ptr[static_cast<std::size_t>(vertex)];
+    const int end = graph.row_ptr[static_cast<std::size_t>(vertex) + 1];
+
+    for (int edge = begin; edge < end; ++edge) {
+      const int to = graph.col_idx[static_cast<std::size_t>(edge)];
+      const std::int64_t cand = du + static_cast<std::int64_t>(graph.weights[static_cast<std::size_t>(edge)]);
+      if (cand < dist[static_cast<std::size_t>(to)]) {
+        dist[static_cast<std::size_t>(to)] = cand;
+        updated = true;
+      }
+    }
+  }
+  return updated;
+}
+
+}  // namespace
+
 ZorinDBellmanFordSEQ::ZorinDBellmanFordSEQ(const InType &in) {
   SetTypeOfTask(GetStaticTypeOfTask());
   GetInput() = in;
@@ -41,33 +68,15 @@ bool ZorinDBellmanFordSEQ::PreProcessingImpl() {
 
 bool ZorinDBellmanFordSEQ::RunImpl() {
   const auto &graph = GetInput().graph;
-  const int vertex_count = graph.vertex_count;
   auto &dist = GetOutput();
 
-  for (int iter = 0; iter < vertex_count - 1; ++iter) {
-    bool updated = false;
-
-    for (int vertex = 0; vertex < vertex_count; ++vertex) {
-      const std::int64_t du = dist[static_cast<std::size_t>(vertex)];
-      if (du >= kInf / 2) {
-        continue;
-      }
-
-      const int begin = graph.row_ptr[static_cast<std::size_t>(vertex)];
-      const int end = graph.row_ptr[static_cast<std::size_t>(vertex) + 1];
-
-      for (int edge = begin; edge < end; ++edge) {
-        const int to = graph.col_idx[static_cast<std::size_t>(edge)];
-        const std::int64_t cand = du + static_cast<std::int64_t>(graph.weights[static_cast<std::size_t>(edge)]);
-        if (cand < dist[static_cast<std::size_t>(to)]) {
-          dist[static_cast<std::size_t>(to)] = cand;
-          updated = true;
-        }
-      }
-    }
-    if (!updated) {
-      break;
-    }
+  bool updated = true;
+  for (int iter = 0; iter < graph.vertex_count - 1 && updated; ++iter) {
+    updated = RelaxEdges(graph, dist);
+  }
+  // An improvement in round V can only come from a negative cycle on the way from the source
+  if (updated && RelaxEdges(graph, dist)) {
+    dist.assign(dist.size(), kNegativeCycle);
   }
   return true;
 }
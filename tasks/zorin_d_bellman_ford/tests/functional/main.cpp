@@ -1,7 +1,9 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <array>
 #include <cstddef>
+#include <cstdint>
 #include <string>
 #include <tuple>
 
@@ -25,9 +27,21 @@ class ZorinDBellmanFordFuncTests : public ppc::util::BaseRunFuncTests<InType, Ou
     const int v = std::get<0>(test_param);
 
     input_data_ = MakeInput(v, 3, 0);
+    expect_negative_cycle_ = std::get<1>(test_param) == "negative_cycle";
+    if (expect_negative_cycle_) {
+      // The first out-edge of every vertex leads to the next one, so these edges form a ring through the source
+      auto &graph = input_data_.graph;
+      for (int vertex = 0; vertex < v; ++vertex) {
+        graph.weights[static_cast<std::size_t>(graph.row_ptr[static_cast<std::size_t>(vertex)])] = -30;
+      }
+    }
   }
 
   bool CheckTestOutputData(OutType &output_data) final {
+    if (expect_negative_cycle_) {
+      return output_data.size() == static_cast<std::size_t>(input_data_.graph.vertex_count) &&
+             std::ranges::all_of(output_data, [](std::int64_t d) { return d == kNegativeCycle; });
+    }
     return !output_data.empty() && output_data.size() == static_cast<std::size_t>(input_data_.graph.vertex_count) &&
            output_data[0] == 0;
   }
@@ -38,6 +52,7 @@ class ZorinDBellmanFordFuncTests : public ppc::util::BaseRunFuncTests<InType, Ou
 
  private:
   InType input_data_{};
+  bool expect_negative_cycle_ = false;
 };
 
 namespace {
@@ -46,10 +61,11 @@ TEST_P(ZorinDBellmanFordFuncTests, SeqMpiSameResult) {
   ExecuteTest(GetParam());
 }
 
-const std::array<TestType, 3> kTestParam = {
+const std::array<TestType, 4> kTestParam = {
     std::make_tuple(10, "v10"),
     std::make_tuple(50, "v50"),
     std::make_tuple(100, "v100"),
+    std::make_tuple(12, "negative_cycle"),
 };
 
 const auto kTestTasksList =